@@ -0,0 +1,284 @@
+#include "anchor_geometry.h"
+
+#include <format>
+#include <stdexcept>
+#include <variant>
+
+namespace // anonymous namespace for helper functions
+{
+    template<typename Ranges>
+    void checkRangeCount(const TrueRangeMultilateration::AnchorGeometry& geometry, const Ranges& ranges)
+    {
+        if(ranges.size() != geometry.anchorCount())
+        {
+            throw std::invalid_argument(std::format(
+                "{} ranges were supplied for an anchor geometry with {} anchors.",
+                ranges.size(),
+                geometry.anchorCount()
+            ));
+        }
+    }
+
+    // Solving against the identity yields the pseudo-inverse that svd.solve(b) applies
+    Eigen::MatrixXd bdcsvdPseudoInverse(const Eigen::MatrixXd& A)
+    {
+        Eigen::BDCSVD<Eigen::MatrixXd, Eigen::ComputeThinU | Eigen::ComputeThinV> svd(A);
+        return svd.solve(Eigen::MatrixXd::Identity(A.rows(), A.rows()));
+    }
+
+} // namespace anonymous
+
+namespace TrueRangeMultilateration
+{
+
+AnchorGeometry::AnchorGeometry(const std::vector<Eigen::Vector3d>& anchorPositions)
+: anchorPositions_(anchorPositions)
+{
+    rebuild();
+}
+
+bool AnchorGeometry::update(const std::vector<Eigen::Vector3d>& anchorPositions)
+{
+    if(matches(anchorPositions))
+    {
+        return false;
+    }
+
+    anchorPositions_ = anchorPositions;
+    rebuild();
+    return true;
+}
+
+bool AnchorGeometry::matches(const std::vector<Eigen::Vector3d>& anchorPositions) const
+{
+    return anchorPositions == anchorPositions_;
+}
+
+void AnchorGeometry::rebuild()
+{
+    const Eigen::Index N = static_cast<Eigen::Index>(anchorPositions_.size());
+
+    squaredAnchorNorms_.resize(N);
+    Eigen::Vector3d anchorPosCentroid = Eigen::Vector3d::Zero();
+    for(Eigen::Index i = 0; i < N; ++i)
+    {
+        const Eigen::Vector3d& p_i = anchorPositions_[static_cast<size_t>(i)];
+        squaredAnchorNorms_(i) = p_i.squaredNorm();
+        anchorPosCentroid += p_i;
+    }
+
+    linearLeastSquaresIIPseudoInverses_.assign(static_cast<size_t>(N), Eigen::Matrix<double, 3, Eigen::Dynamic>());
+    linearLeastSquaresIIBuilt_ = std::make_unique<std::once_flag[]>(static_cast<size_t>(N));
+
+    if(N == 0)
+    {
+        wikipediaAnchorTerms_.resize(0);
+        wikipediaPseudoInverse_.resize(3, 0);
+        linearLeastSquaresIPseudoInverse_.resize(3, 0);
+        return;
+    }
+
+    anchorPosCentroid /= static_cast<double>(N);
+    wikipediaAnchorTerms_ = squaredAnchorNorms_.mean() - squaredAnchorNorms_.array();
+
+    Eigen::MatrixXd A_wikipedia(N, 3);
+    Eigen::MatrixXd A_llsI(N, 4);
+    for(Eigen::Index i = 0; i < N; ++i)
+    {
+        const Eigen::Vector3d& p_i = anchorPositions_[static_cast<size_t>(i)];
+
+        A_wikipedia.row(i) = 2.0 * (anchorPosCentroid - p_i).transpose();
+
+        A_llsI(i, 0) = -2.0 * p_i.x();
+        A_llsI(i, 1) = -2.0 * p_i.y();
+        A_llsI(i, 2) = -2.0 * p_i.z();
+        A_llsI(i, 3) = 1.0;
+    }
+
+    wikipediaPseudoInverse_ = bdcsvdPseudoInverse(A_wikipedia);
+    linearLeastSquaresIPseudoInverse_ = bdcsvdPseudoInverse(A_llsI).topRows<3>();
+}
+
+const Eigen::Matrix<double, 3, Eigen::Dynamic>& AnchorGeometry::linearLeastSquaresIIPseudoInverse(size_t refIndex) const
+{
+    if(refIndex >= anchorPositions_.size())
+    {
+        throw std::out_of_range(std::format(
+            "Reference anchor index {} is out of range for {} anchors.",
+            refIndex,
+            anchorPositions_.size()
+        ));
+    }
+
+    std::call_once(linearLeastSquaresIIBuilt_[refIndex], [this, refIndex]() {
+        const size_t N = anchorPositions_.size();
+        const Eigen::Vector3d& x_r = anchorPositions_[refIndex];
+
+        Eigen::MatrixXd A(static_cast<Eigen::Index>(N - 1), 3);
+        for(size_t i = 0, ii = 0; i < N; ++i)
+        {
+            if(i == refIndex) continue;
+            A.row(static_cast<Eigen::Index>(ii)) = 2.0 * (anchorPositions_[i] - x_r).transpose();
+            ++ii;
+        }
+
+        linearLeastSquaresIIPseudoInverses_[refIndex] = bdcsvdPseudoInverse(A);
+    });
+
+    return linearLeastSquaresIIPseudoInverses_[refIndex];
+}
+
+void AnchorGeometry::precomputeLinearLeastSquaresII() const
+{
+    for(size_t refIndex = 0; refIndex < anchorPositions_.size(); ++refIndex)
+    {
+        linearLeastSquaresIIPseudoInverse(refIndex);
+    }
+}
+
+namespace // anonymous namespace for the solver bodies, shared by the std::vector and view overloads
+{
+
+template<typename Ranges>
+Eigen::Vector3d ordinaryLeastSquaresWikipedia2Impl(
+    const AnchorGeometry& geometry,
+    const Ranges& ranges
+)
+{
+    checkRangeCount(geometry, ranges);
+
+    const size_t N = ranges.size();
+    double meanSquaredRange = 0.0;
+    for(size_t i = 0; i < N; ++i)
+    {
+        meanSquaredRange += ranges[i] * ranges[i];
+    }
+    meanSquaredRange /= static_cast<double>(N);
+
+    // x = pinv(A) * b, accumulated column by column so no b vector is materialised
+    const Eigen::Matrix<double, 3, Eigen::Dynamic>& pseudoInverse = geometry.wikipediaPseudoInverse();
+    const Eigen::VectorXd& anchorTerms = geometry.wikipediaAnchorTerms();
+    Eigen::Vector3d posEstimate = Eigen::Vector3d::Zero();
+    for(size_t i = 0; i < N; ++i)
+    {
+        const Eigen::Index ii = static_cast<Eigen::Index>(i);
+        const double b_i = ranges[i] * ranges[i] - meanSquaredRange + anchorTerms(ii);
+        posEstimate += b_i * pseudoInverse.col(ii);
+    }
+
+    return posEstimate;
+}
+
+template<typename Ranges>
+Eigen::Vector3d linearLeastSquaresI_YueWangImpl(
+    const AnchorGeometry& geometry,
+    const Ranges& ranges
+)
+{
+    checkRangeCount(geometry, ranges);
+
+    const Eigen::Matrix<double, 3, Eigen::Dynamic>& pseudoInverse = geometry.linearLeastSquaresIPseudoInverse();
+    const Eigen::VectorXd& squaredAnchorNorms = geometry.squaredAnchorNorms();
+    Eigen::Vector3d posEstimate = Eigen::Vector3d::Zero();
+    for(size_t i = 0; i < ranges.size(); ++i)
+    {
+        const Eigen::Index ii = static_cast<Eigen::Index>(i);
+        const double b_i = ranges[i] * ranges[i] - squaredAnchorNorms(ii);
+        posEstimate += b_i * pseudoInverse.col(ii);
+    }
+
+    return posEstimate;
+}
+
+template<typename Ranges>
+Eigen::Vector3d linearLeastSquaresII_2_YueWangImpl(
+    const AnchorGeometry& geometry,
+    const Ranges& ranges
+)
+{
+    checkRangeCount(geometry, ranges);
+
+    const size_t N = ranges.size();
+
+    // Select shortest range as reference
+    size_t refIndex = 0;
+    double minRange = ranges[0];
+    for(size_t i = 1; i < N; ++i)
+    {
+        if(ranges[i] < minRange)
+        {
+            minRange = ranges[i];
+            refIndex = i;
+        }
+    }
+
+    const Eigen::Matrix<double, 3, Eigen::Dynamic>& pseudoInverse = geometry.linearLeastSquaresIIPseudoInverse(refIndex);
+    const Eigen::VectorXd& squaredAnchorNorms = geometry.squaredAnchorNorms();
+    const double refTerm = ranges[refIndex] * ranges[refIndex] - squaredAnchorNorms(static_cast<Eigen::Index>(refIndex));
+
+    Eigen::Vector3d posEstimate = Eigen::Vector3d::Zero();
+    for(size_t i = 0, ii = 0; i < N; ++i)
+    {
+        if(i == refIndex) continue;
+
+        const double b_ii = refTerm - ranges[i] * ranges[i] + squaredAnchorNorms(static_cast<Eigen::Index>(i));
+        posEstimate += b_ii * pseudoInverse.col(static_cast<Eigen::Index>(ii));
+        ++ii;
+    }
+
+    return posEstimate;
+}
+
+} // namespace anonymous
+
+Eigen::Vector3d ordinaryLeastSquaresWikipedia2(
+    const AnchorGeometry& geometry,
+    const std::vector<double>& ranges
+)
+{
+    return ordinaryLeastSquaresWikipedia2Impl(geometry, ranges);
+}
+
+Eigen::Vector3d ordinaryLeastSquaresWikipedia2(
+    const AnchorGeometry& geometry,
+    const RangesView& ranges
+)
+{
+    return std::visit([&](const auto& rangeSpan) { return ordinaryLeastSquaresWikipedia2Impl(geometry, rangeSpan); }, ranges.span());
+}
+
+Eigen::Vector3d linearLeastSquaresI_YueWang(
+    const AnchorGeometry& geometry,
+    const std::vector<double>& ranges
+)
+{
+    return linearLeastSquaresI_YueWangImpl(geometry, ranges);
+}
+
+Eigen::Vector3d linearLeastSquaresI_YueWang(
+    const AnchorGeometry& geometry,
+    const RangesView& ranges
+)
+{
+    return std::visit([&](const auto& rangeSpan) { return linearLeastSquaresI_YueWangImpl(geometry, rangeSpan); }, ranges.span());
+}
+
+Eigen::Vector3d linearLeastSquaresII_2_YueWang(
+    const AnchorGeometry& geometry,
+    const std::vector<double>& ranges
+)
+{
+    return linearLeastSquaresII_2_YueWangImpl(geometry, ranges);
+}
+
+Eigen::Vector3d linearLeastSquaresII_2_YueWang(
+    const AnchorGeometry& geometry,
+    const RangesView& ranges
+)
+{
+    return std::visit([&](const auto& rangeSpan) { return linearLeastSquaresII_2_YueWangImpl(geometry, rangeSpan); }, ranges.span());
+}
+
+} // namespace TrueRangeMultilateration
+
+// END OF FILE //
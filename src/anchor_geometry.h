@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include "measurement_views.h"
+
+namespace TrueRangeMultilateration
+{
+
+/**
+ * @brief Cached anchor-only factorizations for the linearised solvers
+ *
+ * The design matrices of ordinaryLeastSquaresWikipedia2, linearLeastSquaresI_YueWang and
+ * linearLeastSquaresII_2_YueWang depend only on the anchor positions. AnchorGeometry runs their BDCSVDs once
+ * and keeps the resulting pseudo-inverses, so a fix reduces to building b and one 3xN matrix-vector product.
+ *
+ * The LLS-II-2 design matrix also depends on the reference anchor, which is chosen per fix from the shortest
+ * range. Its pseudo-inverse is therefore built on first use for each reference index and kept afterwards, or for
+ * all N references at once by precomputeLinearLeastSquaresII(); concurrent solves against one geometry are safe.
+ *
+ * Call update() with the current anchors before solving; it rebuilds the cache only when they changed.
+ */
+class AnchorGeometry {
+  public:
+    AnchorGeometry() = default;
+    explicit AnchorGeometry(const std::vector<Eigen::Vector3d>& anchorPositions);
+
+    AnchorGeometry(AnchorGeometry&&) noexcept = default;
+    AnchorGeometry& operator=(AnchorGeometry&&) noexcept = default;
+
+    /**
+     * @brief Rebuilds the cached factorizations if @p anchorPositions differ from the cached anchors
+     * @return true if the cache was rebuilt
+     */
+    bool update(const std::vector<Eigen::Vector3d>& anchorPositions);
+
+    /**
+     * @brief True if the cache was built from exactly these anchor positions
+     */
+    [[nodiscard]] bool matches(const std::vector<Eigen::Vector3d>& anchorPositions) const;
+
+    [[nodiscard]] const std::vector<Eigen::Vector3d>& anchorPositions() const { return anchorPositions_; }
+    [[nodiscard]] size_t anchorCount() const { return anchorPositions_.size(); }
+
+    // |p_i|^2 for every anchor
+    [[nodiscard]] const Eigen::VectorXd& squaredAnchorNorms() const { return squaredAnchorNorms_; }
+
+    // mean(|p|^2) - |p_i|^2, the anchor-only part of the Wikipedia right-hand side
+    [[nodiscard]] const Eigen::VectorXd& wikipediaAnchorTerms() const { return wikipediaAnchorTerms_; }
+
+    // 3 x N pseudo-inverse of the Wikipedia design matrix, A.row(i) = 2 * (centroid - p_i)
+    [[nodiscard]] const Eigen::Matrix<double, 3, Eigen::Dynamic>& wikipediaPseudoInverse() const
+    {
+        return wikipediaPseudoInverse_;
+    }
+
+    // Position rows (3 x N) of the pseudo-inverse of the LLS-I design matrix, A.row(i) = [-2 * p_i^T, 1]
+    [[nodiscard]] const Eigen::Matrix<double, 3, Eigen::Dynamic>& linearLeastSquaresIPseudoInverse() const
+    {
+        return linearLeastSquaresIPseudoInverse_;
+    }
+
+    // 3 x (N - 1) pseudo-inverse of the LLS-II-2 design matrix for the given reference anchor,
+    // A.row(ii) = 2 * (p_i - p_ref) for every i != refIndex
+    [[nodiscard]] const Eigen::Matrix<double, 3, Eigen::Dynamic>& linearLeastSquaresIIPseudoInverse(size_t refIndex) const;
+
+    /**
+     * @brief Builds the LLS-II-2 pseudo-inverse for every reference index now instead of on first use
+     *
+     * Lets real-time callers pay the N small SVDs up front rather than on the first fix that selects each
+     * reference. Already built references are kept. The next update() that changes the anchors drops them again.
+     */
+    void precomputeLinearLeastSquaresII() const;
+
+  private:
+    void rebuild();
+
+    std::vector<Eigen::Vector3d> anchorPositions_;
+    Eigen::VectorXd squaredAnchorNorms_;
+    Eigen::VectorXd wikipediaAnchorTerms_;
+    Eigen::Matrix<double, 3, Eigen::Dynamic> wikipediaPseudoInverse_;
+    Eigen::Matrix<double, 3, Eigen::Dynamic> linearLeastSquaresIPseudoInverse_;
+
+    // Built lazily per reference index; guarded by the matching once_flag
+    mutable std::vector<Eigen::Matrix<double, 3, Eigen::Dynamic>> linearLeastSquaresIIPseudoInverses_;
+    mutable std::unique_ptr<std::once_flag[]> linearLeastSquaresIIBuilt_;
+};
+
+/**
+ * @brief ordinaryLeastSquaresWikipedia2 using the cached pseudo-inverse of @p geometry
+ * @param geometry Anchor geometry (NOTE: ranges.size() == geometry.anchorCount())
+ * @param ranges
+ * @return Eigen::Vector3d Estimated position
+ */
+Eigen::Vector3d ordinaryLeastSquaresWikipedia2(
+    const AnchorGeometry& geometry,
+    const std::vector<double>& ranges
+);
+
+/**
+ * @brief ordinaryLeastSquaresWikipedia2 against @p geometry with ranges read in place from caller-owned memory
+ */
+Eigen::Vector3d ordinaryLeastSquaresWikipedia2(
+    const AnchorGeometry& geometry,
+    const RangesView& ranges
+);
+
+/**
+ * @brief linearLeastSquaresI_YueWang using the cached pseudo-inverse of @p geometry
+ * @param geometry Anchor geometry (NOTE: ranges.size() == geometry.anchorCount())
+ * @param ranges
+ * @return Eigen::Vector3d Estimated position
+ */
+Eigen::Vector3d linearLeastSquaresI_YueWang(
+    const AnchorGeometry& geometry,
+    const std::vector<double>& ranges
+);
+
+/**
+ * @brief linearLeastSquaresI_YueWang against @p geometry with ranges read in place from caller-owned memory
+ */
+Eigen::Vector3d linearLeastSquaresI_YueWang(
+    const AnchorGeometry& geometry,
+    const RangesView& ranges
+);
+
+/**
+ * @brief linearLeastSquaresII_2_YueWang using the cached pseudo-inverse of @p geometry for the selected reference
+ * @param geometry Anchor geometry (NOTE: ranges.size() == geometry.anchorCount())
+ * @param ranges
+ * @return Eigen::Vector3d Estimated position
+ */
+Eigen::Vector3d linearLeastSquaresII_2_YueWang(
+    const AnchorGeometry& geometry,
+    const std::vector<double>& ranges
+);
+
+/**
+ * @brief linearLeastSquaresII_2_YueWang against @p geometry with ranges read in place from caller-owned memory
+ */
+Eigen::Vector3d linearLeastSquaresII_2_YueWang(
+    const AnchorGeometry& geometry,
+    const RangesView& ranges
+);
+
+} // namespace TrueRangeMultilateration
+
+
+// END OF FILE //
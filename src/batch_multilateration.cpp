@@ -0,0 +1,202 @@
+#include "batch_multilateration.h"
+
+#include <format>
+#include <stdexcept>
+
+namespace // anonymous namespace for helper functions
+{
+    void checkBatchDimensions(
+        const std::vector<Eigen::Vector3d>& anchorPositions,
+        const TrueRangeMultilateration::RangeMatrix& ranges
+    )
+    {
+        if(ranges.cols() != static_cast<Eigen::Index>(anchorPositions.size()))
+        {
+            throw std::invalid_argument(std::format(
+                "Range matrix has {} columns but {} anchors were supplied.",
+                ranges.cols(),
+                anchorPositions.size()
+            ));
+        }
+    }
+
+    // Design matrix of the Wikipedia formulation, A.row(i) = 2 * (centroid - p_i)
+    Eigen::MatrixXd wikipediaDesignMatrix(const std::vector<Eigen::Vector3d>& anchorPositions)
+    {
+        const Eigen::Index N = static_cast<Eigen::Index>(anchorPositions.size());
+
+        Eigen::Vector3d anchorPosCentroid = Eigen::Vector3d::Zero();
+        for(const Eigen::Vector3d& p_i : anchorPositions)
+        {
+            anchorPosCentroid += p_i;
+        }
+        anchorPosCentroid /= static_cast<double>(N);
+
+        Eigen::MatrixXd A(N, 3);
+        for(Eigen::Index i = 0; i < N; ++i)
+        {
+            A.row(i) = 2.0 * (anchorPosCentroid - anchorPositions[static_cast<size_t>(i)]).transpose();
+        }
+        return A;
+    }
+
+    // Right-hand sides of the Wikipedia formulation for every tag,
+    // b(t, i) = d_ti^2 - mean_i(d_ti^2) + (mean_i(|p_i|^2) - |p_i|^2)
+    Eigen::MatrixXd wikipediaRightHandSides(
+        const Eigen::VectorXd& anchorTerms,
+        const TrueRangeMultilateration::RangeMatrix& ranges
+    )
+    {
+        Eigen::MatrixXd B = ranges.array().square().matrix();
+        const Eigen::VectorXd meanSquaredRange = B.rowwise().mean();
+        B.colwise() -= meanSquaredRange;
+        B.rowwise() += anchorTerms.transpose();
+        return B;
+    }
+
+} // namespace anonymous
+
+namespace TrueRangeMultilateration
+{
+
+PositionMatrix ordinaryLeastSquaresWikipediaBatch(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const RangeMatrix& ranges
+)
+{
+    checkBatchDimensions(anchorPositions, ranges);
+
+    const Eigen::MatrixXd A = wikipediaDesignMatrix(anchorPositions);
+    const Eigen::MatrixXd A_T = A.transpose();
+    const Eigen::Matrix<double, 3, Eigen::Dynamic> solveOperator = (A_T * A).inverse() * A_T;
+
+    Eigen::VectorXd anchorTerms(A.rows());
+    for(Eigen::Index i = 0; i < A.rows(); ++i)
+    {
+        anchorTerms(i) = anchorPositions[static_cast<size_t>(i)].squaredNorm();
+    }
+    anchorTerms.array() = anchorTerms.mean() - anchorTerms.array();
+
+    PositionMatrix posEstimates = wikipediaRightHandSides(anchorTerms, ranges) * solveOperator.transpose();
+    return posEstimates;
+}
+
+PositionMatrix ordinaryLeastSquaresWikipedia2Batch(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const RangeMatrix& ranges
+)
+{
+    checkBatchDimensions(anchorPositions, ranges);
+    return ordinaryLeastSquaresWikipedia2Batch(AnchorGeometry(anchorPositions), ranges);
+}
+
+PositionMatrix ordinaryLeastSquaresWikipedia2Batch(
+    const AnchorGeometry& geometry,
+    const RangeMatrix& ranges
+)
+{
+    checkBatchDimensions(geometry.anchorPositions(), ranges);
+
+    PositionMatrix posEstimates =
+        wikipediaRightHandSides(geometry.wikipediaAnchorTerms(), ranges) * geometry.wikipediaPseudoInverse().transpose();
+    return posEstimates;
+}
+
+PositionMatrix linearLeastSquaresI_YueWangBatch(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const RangeMatrix& ranges
+)
+{
+    checkBatchDimensions(anchorPositions, ranges);
+    return linearLeastSquaresI_YueWangBatch(AnchorGeometry(anchorPositions), ranges);
+}
+
+PositionMatrix linearLeastSquaresI_YueWangBatch(
+    const AnchorGeometry& geometry,
+    const RangeMatrix& ranges
+)
+{
+    checkBatchDimensions(geometry.anchorPositions(), ranges);
+
+    Eigen::MatrixXd B = ranges.array().square().matrix();
+    B.rowwise() -= geometry.squaredAnchorNorms().transpose();
+
+    PositionMatrix posEstimates = B * geometry.linearLeastSquaresIPseudoInverse().transpose();
+    return posEstimates;
+}
+
+PositionMatrix linearLeastSquaresII_2_YueWangBatch(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const RangeMatrix& ranges
+)
+{
+    checkBatchDimensions(anchorPositions, ranges);
+    return linearLeastSquaresII_2_YueWangBatch(AnchorGeometry(anchorPositions), ranges);
+}
+
+PositionMatrix linearLeastSquaresII_2_YueWangBatch(
+    const AnchorGeometry& geometry,
+    const RangeMatrix& ranges
+)
+{
+    checkBatchDimensions(geometry.anchorPositions(), ranges);
+
+    const Eigen::Index N = static_cast<Eigen::Index>(geometry.anchorCount());
+    const Eigen::Index T = ranges.rows();
+    PositionMatrix posEstimates(T, 3);
+    if(N == 0)
+    {
+        return posEstimates;
+    }
+
+    // Group tags by their shortest-range reference anchor
+    std::vector<std::vector<Eigen::Index>> tagsByReference(static_cast<size_t>(N));
+    for(Eigen::Index t = 0; t < T; ++t)
+    {
+        Eigen::Index refIndex = 0;
+        double minRange = ranges(t, 0);
+        for(Eigen::Index i = 1; i < N; ++i)
+        {
+            if(ranges(t, i) < minRange)
+            {
+                minRange = ranges(t, i);
+                refIndex = i;
+            }
+        }
+        tagsByReference[static_cast<size_t>(refIndex)].push_back(t);
+    }
+
+    const Eigen::VectorXd& squaredAnchorNorms = geometry.squaredAnchorNorms();
+    for(Eigen::Index refIndex = 0; refIndex < N; ++refIndex)
+    {
+        const std::vector<Eigen::Index>& tags = tagsByReference[static_cast<size_t>(refIndex)];
+        if(tags.empty()) continue;
+
+        const Eigen::Index groupSize = static_cast<Eigen::Index>(tags.size());
+        Eigen::MatrixXd B(groupSize, N - 1);
+        for(Eigen::Index g = 0; g < groupSize; ++g)
+        {
+            const Eigen::Index t = tags[static_cast<size_t>(g)];
+            const double refTerm = ranges(t, refIndex) * ranges(t, refIndex) - squaredAnchorNorms(refIndex);
+            for(Eigen::Index i = 0, ii = 0; i < N; ++i)
+            {
+                if(i == refIndex) continue;
+                B(g, ii) = refTerm - ranges(t, i) * ranges(t, i) + squaredAnchorNorms(i);
+                ++ii;
+            }
+        }
+
+        const PositionMatrix groupEstimates =
+            B * geometry.linearLeastSquaresIIPseudoInverse(static_cast<size_t>(refIndex)).transpose();
+        for(Eigen::Index g = 0; g < groupSize; ++g)
+        {
+            posEstimates.row(tags[static_cast<size_t>(g)]) = groupEstimates.row(g);
+        }
+    }
+
+    return posEstimates;
+}
+
+} // namespace TrueRangeMultilateration
+
+// END OF FILE //
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include "anchor_geometry.h"
+
+namespace TrueRangeMultilateration
+{
+
+/**
+ * @brief Batched ranges, one row per tag and one column per anchor
+ * Eigen's column-major storage keeps the ranges to each anchor contiguous (structure of arrays).
+ */
+using RangeMatrix = Eigen::MatrixXd;
+
+/**
+ * @brief Batched position estimates, one row per tag
+ */
+using PositionMatrix = Eigen::Matrix<double, Eigen::Dynamic, 3>;
+
+/**
+ * @brief Batched ordinaryLeastSquaresWikipedia for many tags against a shared anchor set
+ * The anchor centroid, mean squared anchor norm, design matrix and its normal-equations solution
+ * operator are built once and applied to every tag with one matrix-matrix product.
+ * @param anchorPositions Position of anchors (Note: solver fails, if anchors are coplanar)
+ * @param ranges Tags x anchors range matrix (NOTE: ranges.cols() == anchorPositions.size())
+ * @return PositionMatrix Estimated position of each tag, row-aligned with ranges
+ */
+PositionMatrix ordinaryLeastSquaresWikipediaBatch(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const RangeMatrix& ranges
+);
+
+/**
+ * @brief Batched ordinaryLeastSquaresWikipedia2 for many tags against a shared anchor set
+ * The design matrix is factored once with Eigen's BDCSVD (see AnchorGeometry) and its pseudo-inverse is
+ * applied to every tag with one matrix-matrix product.
+ * @param anchorPositions Position of anchors (Works even if anchors are coplanar)
+ * @param ranges Tags x anchors range matrix (NOTE: ranges.cols() == anchorPositions.size())
+ * @return PositionMatrix Estimated position of each tag, row-aligned with ranges
+ */
+PositionMatrix ordinaryLeastSquaresWikipedia2Batch(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const RangeMatrix& ranges
+);
+
+/**
+ * @brief Batched ordinaryLeastSquaresWikipedia2 using the cached pseudo-inverse of @p geometry
+ * @param geometry Anchor geometry (NOTE: ranges.cols() == geometry.anchorCount())
+ * @param ranges Tags x anchors range matrix
+ * @return PositionMatrix Estimated position of each tag, row-aligned with ranges
+ */
+PositionMatrix ordinaryLeastSquaresWikipedia2Batch(
+    const AnchorGeometry& geometry,
+    const RangeMatrix& ranges
+);
+
+/**
+ * @brief Batched linearLeastSquaresI_YueWang for many tags against a shared anchor set
+ * @param anchorPositions
+ * @param ranges Tags x anchors range matrix (NOTE: ranges.cols() == anchorPositions.size())
+ * @return PositionMatrix Estimated position of each tag, row-aligned with ranges
+ */
+PositionMatrix linearLeastSquaresI_YueWangBatch(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const RangeMatrix& ranges
+);
+
+/**
+ * @brief Batched linearLeastSquaresI_YueWang using the cached pseudo-inverse of @p geometry
+ * @param geometry Anchor geometry (NOTE: ranges.cols() == geometry.anchorCount())
+ * @param ranges Tags x anchors range matrix
+ * @return PositionMatrix Estimated position of each tag, row-aligned with ranges
+ */
+PositionMatrix linearLeastSquaresI_YueWangBatch(
+    const AnchorGeometry& geometry,
+    const RangeMatrix& ranges
+);
+
+/**
+ * @brief Batched linearLeastSquaresII_2_YueWang for many tags against a shared anchor set
+ * Each tag still uses its own shortest range as the reference. Tags are grouped by reference anchor,
+ * so at most one factorization is built per distinct reference and applied to the whole group.
+ * @param anchorPositions
+ * @param ranges Tags x anchors range matrix (NOTE: ranges.cols() == anchorPositions.size())
+ * @return PositionMatrix Estimated position of each tag, row-aligned with ranges
+ */
+PositionMatrix linearLeastSquaresII_2_YueWangBatch(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const RangeMatrix& ranges
+);
+
+/**
+ * @brief Batched linearLeastSquaresII_2_YueWang using the cached per-reference pseudo-inverses of @p geometry
+ * @param geometry Anchor geometry (NOTE: ranges.cols() == geometry.anchorCount())
+ * @param ranges Tags x anchors range matrix
+ * @return PositionMatrix Estimated position of each tag, row-aligned with ranges
+ */
+PositionMatrix linearLeastSquaresII_2_YueWangBatch(
+    const AnchorGeometry& geometry,
+    const RangeMatrix& ranges
+);
+
+} // namespace TrueRangeMultilateration
+
+
+// END OF FILE //
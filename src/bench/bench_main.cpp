@@ -0,0 +1,495 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include "core/algorithm_dispatch.h"
+#include "core/allocation_tracker.h"
+#include "core/simulation_types.h"
+#include "mixed_precision.h"
+#include "test_helpers.h"
+
+using namespace TrueRangeMultilateration;
+
+namespace // anonymous namespace for helper functions
+{
+    constexpr double rangeNoiseStdDev = 0.1;
+    // Distinct anchor layouts and range sets cycled through per case, so branch predictors and caches
+    // do not see a single repeated input
+    constexpr size_t inputSetCount = 32;
+
+    struct BenchOptions {
+        std::vector<size_t> anchorCounts = {4, 8, 16, 32, 64, 128, 256, 512, 1024};
+        std::vector<AlgorithmId> algorithms;
+        double minSeconds = 0.25;
+        size_t maxSamples = 1000000;
+        uint64_t seed = 1;
+        bool mixedPrecision = true;
+        std::string csvPath;
+        std::string jsonPath;
+    };
+
+    struct InputSet {
+        std::vector<Eigen::Vector3d> anchors;
+        std::vector<double> ranges;
+    };
+
+    // Reference rows time runAlgorithm; the others time the mixed-precision variant of the same estimator
+    enum class Precision {
+        Reference,
+        CentredDouble,
+        Float,
+    };
+
+    struct BenchResult {
+        AlgorithmId algorithm = AlgorithmId::OrdinaryLeastSquaresWikipedia;
+        Precision precision = Precision::Reference;
+        size_t anchorCount = 0;
+        size_t fixes = 0;
+        double meanNs = 0.0;
+        double minNs = 0.0;
+        double p50Ns = 0.0;
+        double p90Ns = 0.0;
+        double p99Ns = 0.0;
+        double allocationsPerFix = 0.0;
+        double bytesPerFix = 0.0;
+        double rmsErrorM = 0.0;
+        // Mixed-precision rows only: largest distance from the reference estimate and refinement steps per fix
+        double maxDeviationM = 0.0;
+        double refinementsPerFix = 0.0;
+    };
+
+    std::string_view precisionName(const Precision precision)
+    {
+        switch(precision)
+        {
+            case Precision::Reference: return "double";
+            case Precision::CentredDouble: return "centred-double";
+            case Precision::Float: return "float";
+        }
+        return "";
+    }
+
+    using MixedSolver = Eigen::Vector3d (*)(
+        const AnchorPositionsView&, const RangesView&, const MixedPrecisionOptions&, SolveResult*);
+
+    // The templated reduced-precision variant of an algorithm, or null if it has none
+    MixedSolver mixedSolver(const AlgorithmId algorithm, const Precision precision)
+    {
+        const bool useFloat = precision == Precision::Float;
+        switch(algorithm)
+        {
+            case AlgorithmId::OrdinaryLeastSquaresWikipediaBdcsvd:
+                return useFloat ? ordinaryLeastSquaresWikipedia2Mixed<float> : ordinaryLeastSquaresWikipedia2Mixed<double>;
+            case AlgorithmId::LinearLeastSquaresIYueWang:
+                return useFloat ? linearLeastSquaresI_YueWangMixed<float> : linearLeastSquaresI_YueWangMixed<double>;
+            case AlgorithmId::LinearLeastSquaresII2YueWang:
+                return useFloat ? linearLeastSquaresII_2_YueWangMixed<float> : linearLeastSquaresII_2_YueWangMixed<double>;
+            default:
+                return nullptr;
+        }
+    }
+
+    std::vector<InputSet> makeInputSets(const size_t anchorCount, std::mt19937_64& rng, std::vector<Eigen::Vector3d>& truePositions)
+    {
+        std::uniform_real_distribution<double> anchorDist(-10.0, 10.0);
+        std::uniform_real_distribution<double> tagDist(-5.0, 5.0);
+
+        std::vector<InputSet> inputs(inputSetCount);
+        truePositions.resize(inputSetCount);
+        for(size_t i = 0; i < inputSetCount; ++i)
+        {
+            inputs[i].anchors.reserve(anchorCount);
+            for(size_t a = 0; a < anchorCount; ++a)
+            {
+                inputs[i].anchors.emplace_back(anchorDist(rng), anchorDist(rng), anchorDist(rng));
+            }
+            truePositions[i] = Eigen::Vector3d(tagDist(rng), tagDist(rng), tagDist(rng));
+            inputs[i].ranges = generateNoisyRanges(truePositions[i], inputs[i].anchors, rangeNoiseStdDev, rng);
+        }
+        return inputs;
+    }
+
+    double percentile(const std::vector<double>& sorted, const double fraction)
+    {
+        const size_t index = std::min(sorted.size() - 1, static_cast<size_t>(fraction * static_cast<double>(sorted.size())));
+        return sorted[index];
+    }
+
+    template<typename Solve>
+    BenchResult runCase(
+        const AlgorithmId algorithm,
+        const Precision precision,
+        const Solve& solve,
+        const std::vector<InputSet>& inputs,
+        const std::vector<Eigen::Vector3d>& truePositions,
+        const BenchOptions& options
+    )
+    {
+        using Clock = std::chrono::steady_clock;
+
+        BenchResult result;
+        result.algorithm = algorithm;
+        result.precision = precision;
+        result.anchorCount = inputs.front().anchors.size();
+
+        // Warm-up pass, which also measures accuracy and heap traffic per fix
+        double squaredErrorSum = 0.0;
+        const ScopedAllocationCounter allocationCounter;
+        for(size_t i = 0; i < inputs.size(); ++i)
+        {
+            const Eigen::Vector3d estimate = solve(inputs[i]);
+            squaredErrorSum += (estimate - truePositions[i]).squaredNorm();
+        }
+        const AllocationCounts allocations = allocationCounter.counts();
+        const double warmUpFixes = static_cast<double>(inputs.size());
+        result.allocationsPerFix = static_cast<double>(allocations.allocations) / warmUpFixes;
+        result.bytesPerFix = static_cast<double>(allocations.bytes) / warmUpFixes;
+        result.rmsErrorM = std::sqrt(squaredErrorSum / warmUpFixes);
+
+        // Per-fix latencies; each sample includes one steady_clock read pair
+        std::vector<double> samples;
+        samples.reserve(std::min<size_t>(options.maxSamples, 1 << 16));
+        volatile double sink = 0.0;
+        const Clock::time_point start = Clock::now();
+        double elapsedSeconds = 0.0;
+        while((elapsedSeconds < options.minSeconds || samples.size() < inputs.size()) && samples.size() < options.maxSamples)
+        {
+            for(const InputSet& input : inputs)
+            {
+                const Clock::time_point t0 = Clock::now();
+                const Eigen::Vector3d estimate = solve(input);
+                const Clock::time_point t1 = Clock::now();
+                sink = sink + estimate.x();
+                samples.push_back(std::chrono::duration<double, std::nano>(t1 - t0).count());
+            }
+            elapsedSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+        }
+
+        std::sort(samples.begin(), samples.end());
+        double sum = 0.0;
+        for(const double sample : samples)
+        {
+            sum += sample;
+        }
+        result.fixes = samples.size();
+        result.meanNs = sum / static_cast<double>(samples.size());
+        result.minNs = samples.front();
+        result.p50Ns = percentile(samples, 0.50);
+        result.p90Ns = percentile(samples, 0.90);
+        result.p99Ns = percentile(samples, 0.99);
+        return result;
+    }
+
+    BenchResult runReferenceCase(
+        const AlgorithmId algorithm,
+        const std::vector<InputSet>& inputs,
+        const std::vector<Eigen::Vector3d>& truePositions,
+        const BenchOptions& options
+    )
+    {
+        auto solve = [algorithm](const InputSet& input) {
+            return runAlgorithm(algorithm, input.anchors, input.ranges, rangeNoiseStdDev);
+        };
+        return runCase(algorithm, Precision::Reference, solve, inputs, truePositions, options);
+    }
+
+    BenchResult runMixedPrecisionCase(
+        const AlgorithmId algorithm,
+        const Precision precision,
+        const std::vector<InputSet>& inputs,
+        const std::vector<Eigen::Vector3d>& truePositions,
+        const BenchOptions& options
+    )
+    {
+        const MixedSolver solver = mixedSolver(algorithm, precision);
+        auto solve = [solver](const InputSet& input) {
+            return solver(input.anchors, input.ranges, MixedPrecisionOptions{}, nullptr);
+        };
+        BenchResult result = runCase(algorithm, precision, solve, inputs, truePositions, options);
+
+        // Accuracy against the double-precision estimator on the same inputs, outside the timed loop
+        size_t refinements = 0;
+        for(const InputSet& input : inputs)
+        {
+            SolveResult diagnostics;
+            const Eigen::Vector3d estimate = solver(input.anchors, input.ranges, MixedPrecisionOptions{}, &diagnostics);
+            const Eigen::Vector3d reference = runAlgorithm(algorithm, input.anchors, input.ranges, rangeNoiseStdDev);
+            result.maxDeviationM = std::max(result.maxDeviationM, (estimate - reference).norm());
+            refinements += diagnostics.iterations;
+        }
+        result.refinementsPerFix = static_cast<double>(refinements) / static_cast<double>(inputs.size());
+        return result;
+    }
+
+    std::string jsonEscape(const std::string_view text)
+    {
+        std::string escaped;
+        escaped.reserve(text.size());
+        for(const char c : text)
+        {
+            if(c == '"' || c == '\\')
+            {
+                escaped += '\\';
+            }
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    // Allocation columns are left empty (CSV), null (JSON) or "-" (console) without allocation tracking
+    std::string formatAllocationCount(const double value, const int precision, const std::string_view missing)
+    {
+        if(!allocationTrackingEnabled())
+        {
+            return std::string(missing);
+        }
+        std::ostringstream text;
+        text << std::fixed << std::setprecision(precision) << value;
+        return text.str();
+    }
+
+    void writeCsv(const std::string& path, const std::vector<BenchResult>& results)
+    {
+        std::ofstream out(path);
+        out << "algorithm_id,algorithm,precision,anchors,fixes,mean_ns,min_ns,p50_ns,p90_ns,p99_ns,allocs_per_fix,bytes_per_fix,"
+               "rms_error_m,max_deviation_m,refinements_per_fix\n";
+        for(const BenchResult& r : results)
+        {
+            out << std::format(
+                "{},\"{}\",{},{},{},{:.1f},{:.1f},{:.1f},{:.1f},{:.1f},{},{},{:.6g},{:.6g},{:.4f}\n",
+                static_cast<int>(r.algorithm), algorithmDisplayName(r.algorithm), precisionName(r.precision), r.anchorCount, r.fixes,
+                r.meanNs, r.minNs, r.p50Ns, r.p90Ns, r.p99Ns,
+                formatAllocationCount(r.allocationsPerFix, 2, ""), formatAllocationCount(r.bytesPerFix, 1, ""), r.rmsErrorM,
+                r.maxDeviationM, r.refinementsPerFix
+            );
+        }
+    }
+
+    void writeJson(const std::string& path, const std::vector<BenchResult>& results, const BenchOptions& options)
+    {
+#ifdef NDEBUG
+        constexpr bool ndebug = true;
+#else
+        constexpr bool ndebug = false;
+#endif
+        std::ofstream out(path);
+        out << "{\n";
+        out << std::format("  \"schema\": 2,\n  \"seed\": {},\n  \"ndebug\": {},\n  \"allocation_tracking\": {},\n  \"range_noise_std_dev_m\": {},\n",
+            options.seed, ndebug ? "true" : "false", allocationTrackingEnabled() ? "true" : "false", rangeNoiseStdDev);
+        out << "  \"results\": [\n";
+        for(size_t i = 0; i < results.size(); ++i)
+        {
+            const BenchResult& r = results[i];
+            out << std::format(
+                "    {{\"algorithm_id\": {}, \"algorithm\": \"{}\", \"precision\": \"{}\", \"anchors\": {}, \"fixes\": {}, "
+                "\"mean_ns\": {:.1f}, \"min_ns\": {:.1f}, \"p50_ns\": {:.1f}, \"p90_ns\": {:.1f}, \"p99_ns\": {:.1f}, "
+                "\"allocs_per_fix\": {}, \"bytes_per_fix\": {}, \"rms_error_m\": {:.6g}, "
+                "\"max_deviation_m\": {:.6g}, \"refinements_per_fix\": {:.4f}}}{}\n",
+                static_cast<int>(r.algorithm), jsonEscape(algorithmDisplayName(r.algorithm)), precisionName(r.precision),
+                r.anchorCount, r.fixes, r.meanNs, r.minNs, r.p50Ns, r.p90Ns, r.p99Ns,
+                formatAllocationCount(r.allocationsPerFix, 2, "null"), formatAllocationCount(r.bytesPerFix, 1, "null"), r.rmsErrorM,
+                r.maxDeviationM, r.refinementsPerFix,
+                i + 1 < results.size() ? "," : ""
+            );
+        }
+        out << "  ]\n}\n";
+    }
+
+    std::vector<size_t> parseSizeList(const std::string& text)
+    {
+        std::vector<size_t> values;
+        size_t begin = 0;
+        while(begin <= text.size())
+        {
+            const size_t end = std::min(text.find(',', begin), text.size());
+            values.push_back(static_cast<size_t>(std::stoull(text.substr(begin, end - begin))));
+            begin = end + 1;
+        }
+        return values;
+    }
+
+    void printUsage()
+    {
+        std::cout <<
+            "Usage: multilat_bench [options]\n"
+            "  --anchors LIST       Comma-separated anchor counts (default 4,8,16,32,64,128,256,512,1024)\n"
+            "  --algorithms LIST    Comma-separated AlgorithmId values (default: all)\n"
+            "  --min-time SECONDS   Minimum timed duration per case (default 0.25)\n"
+            "  --max-samples N      Maximum timed fixes per case (default 1000000)\n"
+            "  --seed N             Input generation seed (default 1)\n"
+            "  --mixed-precision B  Also time the centred-double and float variants of OLS2, LLS-I and LLS-II-2 (0 or 1, default 1)\n"
+            "  --csv PATH           Also write results as CSV\n"
+            "  --json PATH          Also write results as JSON\n";
+    }
+
+    // Returns false if the program should exit
+    bool parseArguments(const int argc, char const* argv[], BenchOptions& options)
+    {
+        for(int i = 1; i < argc; ++i)
+        {
+            const std::string_view argument = argv[i];
+            if(argument == "--help" || argument == "-h")
+            {
+                printUsage();
+                return false;
+            }
+            if(i + 1 >= argc)
+            {
+                throw std::invalid_argument(std::format("Missing value for {}", argument));
+            }
+
+            const std::string value = argv[++i];
+            if(argument == "--anchors")
+            {
+                options.anchorCounts = parseSizeList(value);
+            }
+            else if(argument == "--algorithms")
+            {
+                options.algorithms.clear();
+                for(const size_t id : parseSizeList(value))
+                {
+                    if(id >= algorithmCount)
+                    {
+                        throw std::invalid_argument(std::format("Unknown AlgorithmId {}", id));
+                    }
+                    options.algorithms.push_back(static_cast<AlgorithmId>(id));
+                }
+            }
+            else if(argument == "--min-time")
+            {
+                options.minSeconds = std::stod(value);
+            }
+            else if(argument == "--max-samples")
+            {
+                options.maxSamples = static_cast<size_t>(std::stoull(value));
+            }
+            else if(argument == "--seed")
+            {
+                options.seed = std::stoull(value);
+            }
+            else if(argument == "--mixed-precision")
+            {
+                if(value != "0" && value != "1")
+                {
+                    throw std::invalid_argument("--mixed-precision must be 0 or 1.");
+                }
+                options.mixedPrecision = value == "1";
+            }
+            else if(argument == "--csv")
+            {
+                options.csvPath = value;
+            }
+            else if(argument == "--json")
+            {
+                options.jsonPath = value;
+            }
+            else
+            {
+                throw std::invalid_argument(std::format("Unknown option {}", argument));
+            }
+        }
+
+        for(const size_t anchorCount : options.anchorCounts)
+        {
+            if(anchorCount < 4)
+            {
+                throw std::invalid_argument("Anchor counts must be at least 4.");
+            }
+        }
+        if(options.maxSamples == 0)
+        {
+            throw std::invalid_argument("--max-samples must be positive.");
+        }
+        return true;
+    }
+
+} // namespace anonymous
+
+int main(int argc, char const *argv[])
+{
+    BenchOptions options;
+    for(size_t id = 0; id < algorithmCount; ++id)
+    {
+        options.algorithms.push_back(static_cast<AlgorithmId>(id));
+    }
+
+    try
+    {
+        if(!parseArguments(argc, argv, options))
+        {
+            return 0;
+        }
+    }
+    catch(const std::exception& e)
+    {
+        std::cerr << e.what() << "\n";
+        printUsage();
+        return 2;
+    }
+
+#ifndef NDEBUG
+    std::cout << "Warning: built without NDEBUG; Eigen assertions dominate small solver timings.\n";
+#endif
+    if(!allocationTrackingEnabled())
+    {
+        std::cout << "Allocation columns need a build with -DMULTILAT_ALLOCATION_TRACKING=ON.\n";
+    }
+    std::cout << std::format("{:<74} {:<14} {:>5} {:>9} {:>11} {:>11} {:>11} {:>8} {:>10} {:>11} {:>11}\n",
+        "Algorithm", "precision", "N", "fixes", "mean ns", "p50 ns", "p99 ns", "allocs", "bytes", "rms err m", "max dev m");
+
+    std::vector<BenchResult> results;
+    for(const size_t anchorCount : options.anchorCounts)
+    {
+        // Same inputs for every algorithm at a given anchor count
+        std::mt19937_64 rng = makeRunRandomEngine(options.seed, anchorCount);
+        std::vector<Eigen::Vector3d> truePositions;
+        const std::vector<InputSet> inputs = makeInputSets(anchorCount, rng, truePositions);
+
+        for(const AlgorithmId algorithm : options.algorithms)
+        {
+            std::vector<BenchResult> cases = {runReferenceCase(algorithm, inputs, truePositions, options)};
+            if(options.mixedPrecision && mixedSolver(algorithm, Precision::Float) != nullptr)
+            {
+                cases.push_back(runMixedPrecisionCase(algorithm, Precision::CentredDouble, inputs, truePositions, options));
+                cases.push_back(runMixedPrecisionCase(algorithm, Precision::Float, inputs, truePositions, options));
+            }
+
+            for(const BenchResult& result : cases)
+            {
+                std::cout << std::format("{:<74} {:<14} {:>5} {:>9} {:>11.0f} {:>11.0f} {:>11.0f} {:>8} {:>10} {:>11.3g} {:>11.3g}\n",
+                    algorithmDisplayName(algorithm), precisionName(result.precision), anchorCount, result.fixes,
+                    result.meanNs, result.p50Ns, result.p99Ns,
+                    formatAllocationCount(result.allocationsPerFix, 1, "-"), formatAllocationCount(result.bytesPerFix, 0, "-"),
+                    result.rmsErrorM, result.maxDeviationM) << std::flush;
+                results.push_back(result);
+            }
+        }
+    }
+
+    if(!options.csvPath.empty())
+    {
+        writeCsv(options.csvPath, results);
+    }
+    if(!options.jsonPath.empty())
+    {
+        writeJson(options.jsonPath, results, options);
+    }
+
+    return 0;
+}
+
+// END OF FILE //
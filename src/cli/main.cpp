@@ -1,9 +1,218 @@
+#include <chrono>
+#include <cstdint>
+#include <fstream>
 #include <iostream>
 #include <format>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include <Eigen/Dense>
 
 #include "tests.h"
+#include "test_helpers.h"
+#include "core/parameter_sweep.h"
+#include "core/range_log.h"
+
+namespace // anonymous namespace for helper functions
+{
+    struct CommandOptions {
+        std::string replayPath;
+        std::string writePath;
+        std::string sweepPath;
+        std::string sweepResultsPath = "sweep_results.csv";
+        std::string sweepRunsPath;
+        TrueRangeMultilateration::RangeLogReplayOptions replay;
+        size_t tagCount = 1000;
+        size_t epochCount = 100;
+        uint64_t seed = 42;
+    };
+
+    void printUsage()
+    {
+        std::cout <<
+            "Usage: main                       Run the validation checks and benchmarks\n"
+            "       main --replay PATH [options]\n"
+            "         --algorithm ID           AlgorithmId used for every fix (default 7, analytic LM)\n"
+            "         --threads N              Replay threads, 0 for all cores (default 0)\n"
+            "         --epoch-duration S       Longest epoch in seconds (default 0.05)\n"
+            "         --min-ranges N           Smallest epoch that is solved (default 4)\n"
+            "         --range-std-dev M        Range std-dev for records without one (default 0.1)\n"
+            "       main --write-range-log PATH [options]\n"
+            "         --tags N                 Tags inside the default anchor cube (default 1000)\n"
+            "         --epochs N               Ranging rounds per tag, 0.1 s apart (default 100)\n"
+            "         --seed N                 Tag position and noise seed (default 42)\n"
+            "       main --sweep CONFIG [options]\n"
+            "         --results PATH           Per-scenario summary CSV (default sweep_results.csv)\n"
+            "         --runs-output PATH       Every run as .csv, .jsonl or .bin (default none)\n"
+            "         --threads N              Sweep threads, 0 for all cores (default 0)\n";
+    }
+
+    CommandOptions parseArguments(const int argc, char const* argv[])
+    {
+        CommandOptions options;
+        for(int i = 1; i < argc; ++i)
+        {
+            const std::string_view argument = argv[i];
+            if(i + 1 >= argc)
+            {
+                throw std::invalid_argument(std::format("Missing value for {}", argument));
+            }
+
+            const std::string value = argv[++i];
+            if(argument == "--replay")
+            {
+                options.replayPath = value;
+            }
+            else if(argument == "--write-range-log")
+            {
+                options.writePath = value;
+            }
+            else if(argument == "--sweep")
+            {
+                options.sweepPath = value;
+            }
+            else if(argument == "--results")
+            {
+                options.sweepResultsPath = value;
+            }
+            else if(argument == "--runs-output")
+            {
+                options.sweepRunsPath = value;
+            }
+            else if(argument == "--algorithm")
+            {
+                const size_t id = static_cast<size_t>(std::stoull(value));
+                if(id >= TrueRangeMultilateration::algorithmCount)
+                {
+                    throw std::invalid_argument(std::format("Unknown AlgorithmId {}", id));
+                }
+                options.replay.algorithm = static_cast<TrueRangeMultilateration::AlgorithmId>(id);
+            }
+            else if(argument == "--threads")
+            {
+                options.replay.threadCount = static_cast<size_t>(std::stoull(value));
+            }
+            else if(argument == "--epoch-duration")
+            {
+                options.replay.epochDuration = std::stod(value);
+            }
+            else if(argument == "--min-ranges")
+            {
+                options.replay.minRangesPerFix = static_cast<size_t>(std::stoull(value));
+            }
+            else if(argument == "--range-std-dev")
+            {
+                options.replay.rangeNoiseStdDev = std::stod(value);
+            }
+            else if(argument == "--tags")
+            {
+                options.tagCount = static_cast<size_t>(std::stoull(value));
+            }
+            else if(argument == "--epochs")
+            {
+                options.epochCount = static_cast<size_t>(std::stoull(value));
+            }
+            else if(argument == "--seed")
+            {
+                options.seed = std::stoull(value);
+            }
+            else
+            {
+                throw std::invalid_argument(std::format("Unknown option {}", argument));
+            }
+        }
+
+        const int modeCount = int{!options.replayPath.empty()} + int{!options.writePath.empty()} + int{!options.sweepPath.empty()};
+        if(modeCount != 1)
+        {
+            throw std::invalid_argument("Give exactly one of --replay, --write-range-log and --sweep.");
+        }
+        return options;
+    }
+
+    void writeRangeLog(const CommandOptions& options, const std::vector<Eigen::Vector3d>& anchorPositions)
+    {
+        std::mt19937_64 rng = makeRandomEngine(options.seed);
+        std::uniform_real_distribution<double> horizontal(-5.0, 5.0);
+        std::uniform_real_distribution<double> vertical(0.0, 10.0);
+        std::vector<Eigen::Vector3d> tagPositions(options.tagCount);
+        for(Eigen::Vector3d& tagPosition : tagPositions)
+        {
+            tagPosition = Eigen::Vector3d(horizontal(rng), horizontal(rng), vertical(rng));
+        }
+
+        TrueRangeMultilateration::RangeLogWriter writer(options.writePath, anchorPositions);
+        const uint64_t records = writeSyntheticRangeLog(writer, tagPositions, anchorPositions, 0.1, options.epochCount, 0.1, rng);
+        writer.close();
+        std::cout << std::format("Wrote {} records ({} tags x {} epochs x {} anchors) to {}\n",
+            records, options.tagCount, options.epochCount, anchorPositions.size(), options.writePath);
+    }
+
+    void runRangeLogReplay(const CommandOptions& options)
+    {
+        const TrueRangeMultilateration::RangeLogReader reader(options.replayPath);
+        std::cout << std::format("Replaying {} ({} anchors, {} records) with {}\n",
+            options.replayPath, reader.anchorPositions().size(), reader.records().size(),
+            TrueRangeMultilateration::algorithmDisplayName(options.replay.algorithm));
+
+        const TrueRangeMultilateration::RangeLogReplayStats stats = TrueRangeMultilateration::replayRangeLog(reader, options.replay);
+        std::cout << std::format("  epochs {}, fixes {}, skipped epochs {}, invalid-anchor records {}, failed solves {}\n",
+            stats.epochs, stats.fixes, stats.skippedEpochs, stats.invalidAnchorRecords, stats.failedSolves);
+        std::cout << std::format("  {:.3f} s, {:.0f} fixes/s, {:.0f} records/s, {:.1f} MB/s\n",
+            stats.seconds,
+            static_cast<double>(stats.fixes) / stats.seconds,
+            static_cast<double>(stats.records) / stats.seconds,
+            static_cast<double>(reader.fileSize()) / stats.seconds / 1e6);
+    }
+
+    void runParameterSweep(const CommandOptions& options)
+    {
+        const TrueRangeMultilateration::SweepConfig config = TrueRangeMultilateration::loadSweepConfig(options.sweepPath);
+        const std::vector<TrueRangeMultilateration::SweepScenario> scenarios = TrueRangeMultilateration::expandSweepGrid(config);
+
+        std::unique_ptr<TrueRangeMultilateration::ResultSink> runSink;
+        if(!options.sweepRunsPath.empty())
+        {
+            runSink = TrueRangeMultilateration::openResultSink(
+                TrueRangeMultilateration::resultFormatFromPath(options.sweepRunsPath), options.sweepRunsPath);
+        }
+
+        TrueRangeMultilateration::SweepOptions sweepOptions;
+        sweepOptions.threadCount = options.replay.threadCount;
+        sweepOptions.runSink = runSink.get();
+        const size_t selectedAlgorithms = config.algorithms.empty() ? TrueRangeMultilateration::algorithmCount : config.algorithms.size();
+        std::cout << std::format("Sweeping {} scenarios x {} algorithms x {} runs from {}\n",
+            scenarios.size(), selectedAlgorithms, config.numRuns, options.sweepPath);
+
+        const auto startedAt = std::chrono::steady_clock::now();
+        const std::vector<TrueRangeMultilateration::SweepResult> results = TrueRangeMultilateration::runSweep(config, scenarios, sweepOptions);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startedAt).count();
+        if(runSink)
+        {
+            runSink->flush();
+        }
+
+        std::ofstream resultsFile(options.sweepResultsPath);
+        if(!resultsFile)
+        {
+            throw std::runtime_error("Cannot create " + options.sweepResultsPath);
+        }
+        TrueRangeMultilateration::writeSweepResultsCsv(resultsFile, scenarios, results);
+
+        size_t failedRuns = 0;
+        for(const TrueRangeMultilateration::SweepResult& result : results)
+        {
+            failedRuns += result.failedRuns;
+        }
+        std::cout << std::format("  {} jobs in {:.3f} s, {} failed runs; summary written to {}\n",
+            results.size(), seconds, failedRuns, options.sweepResultsPath);
+    }
+
+} // namespace anonymous
 
 int main(int argc, char const *argv[])
 {
@@ -27,6 +236,50 @@ int main(int argc, char const *argv[])
     testParams.rangeOutlierRatio = 0.0;
     testParams.rangeOutlierMagnitude = 100.0;
 
+    if(argc > 1)
+    {
+        const std::string_view firstArgument = argv[1];
+        if(firstArgument == "--help" || firstArgument == "-h")
+        {
+            printUsage();
+            return 0;
+        }
+
+        CommandOptions options;
+        try
+        {
+            options = parseArguments(argc, argv);
+        }
+        catch(const std::exception& e)
+        {
+            std::cerr << e.what() << "\n";
+            printUsage();
+            return 2;
+        }
+
+        try
+        {
+            if(!options.sweepPath.empty())
+            {
+                runParameterSweep(options);
+            }
+            else if(!options.writePath.empty())
+            {
+                writeRangeLog(options, testParams.anchorPositions);
+            }
+            else
+            {
+                runRangeLogReplay(options);
+            }
+        }
+        catch(const std::exception& e)
+        {
+            std::cerr << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
     TrueRangeMultilateration::runTests(testParams);
 
     return 0;
@@ -22,6 +22,10 @@ std::string algorithmDisplayName(const AlgorithmId algorithm) {
             return "LLS-II-2 (Yue Wang)";
         case AlgorithmId::TwoStepWeightedLinearLeastSquaresIYueWang:
             return "Two-Step Weighted LLS-I (Yue Wang / Chan-Ho)";
+        case AlgorithmId::NonLinearLeastSquaresAnalyticLm:
+            return "Nonlinear Least Squares (Analytic-Jacobian LM)";
+        case AlgorithmId::RobustNonLinearLeastSquaresAnalyticLm:
+            return "Robust Nonlinear Least Squares (Analytic LM + warm-started IRLS/Cauchy)";
     }
 
     return "Unknown";
@@ -53,9 +57,135 @@ Eigen::Vector3d runAlgorithm(
                 anchorPositions,
                 ranges,
                 std::vector<double>(ranges.size(), rangeNoiseStdDev));
+        case AlgorithmId::NonLinearLeastSquaresAnalyticLm:
+            return nonLinearLeastSquaresAnalyticLevenbergMarquardt(anchorPositions, ranges);
+        case AlgorithmId::RobustNonLinearLeastSquaresAnalyticLm:
+            return robustNonLinearLeastSquaresAnalyticLevenbergMarquardt(
+                anchorPositions, ranges, rangeNoiseStdDev, robustLossParam).position;
     }
 
     throw std::runtime_error("Invalid algorithm id");
 }
 
+Eigen::Vector3d runAlgorithm(
+    const AlgorithmId algorithm,
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    const double rangeNoiseStdDev,
+    const double robustLossParam
+) {
+    switch (algorithm) {
+        case AlgorithmId::OrdinaryLeastSquaresWikipedia:
+            return ordinaryLeastSquaresWikipedia(anchorPositions, ranges);
+        case AlgorithmId::OrdinaryLeastSquaresWikipediaBdcsvd:
+            return ordinaryLeastSquaresWikipedia2(anchorPositions, ranges);
+        case AlgorithmId::NonLinearLeastSquaresEigenLm:
+            return nonLinearLeastSquaresEigenLevenbergMarquardt(anchorPositions, ranges);
+        case AlgorithmId::RobustNonLinearLeastSquaresEigenLm:
+            return robustNonLinearLeastSquaresEigenLevenbergMarquardt(
+                anchorPositions, ranges, rangeNoiseStdDev, robustLossParam);
+        case AlgorithmId::LinearLeastSquaresIYueWang:
+            return linearLeastSquaresI_YueWang(anchorPositions, ranges);
+        case AlgorithmId::LinearLeastSquaresII2YueWang:
+            return linearLeastSquaresII_2_YueWang(anchorPositions, ranges);
+        case AlgorithmId::TwoStepWeightedLinearLeastSquaresIYueWang:
+            return twoStepWeightedLinearLeastSquaresI_YueWang(
+                anchorPositions,
+                ranges,
+                RangesView(&rangeNoiseStdDev, ranges.size(), 0));
+        case AlgorithmId::NonLinearLeastSquaresAnalyticLm:
+            return nonLinearLeastSquaresAnalyticLevenbergMarquardt(anchorPositions, ranges);
+        case AlgorithmId::RobustNonLinearLeastSquaresAnalyticLm:
+            return robustNonLinearLeastSquaresAnalyticLevenbergMarquardt(
+                anchorPositions, ranges, rangeNoiseStdDev, robustLossParam).position;
+    }
+
+    throw std::runtime_error("Invalid algorithm id");
+}
+
+SolveResult runAlgorithmWithDiagnostics(
+    const AlgorithmId algorithm,
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    const double rangeNoiseStdDev,
+    const double robustLossParam
+) {
+    SolveResult result;
+    switch (algorithm) {
+        case AlgorithmId::OrdinaryLeastSquaresWikipedia:
+            result.position = ordinaryLeastSquaresWikipedia(anchorPositions, ranges, &result);
+            break;
+        case AlgorithmId::OrdinaryLeastSquaresWikipediaBdcsvd:
+            result.position = ordinaryLeastSquaresWikipedia2(anchorPositions, ranges, &result);
+            break;
+        case AlgorithmId::NonLinearLeastSquaresEigenLm:
+            result.position = nonLinearLeastSquaresEigenLevenbergMarquardt(anchorPositions, ranges, &result);
+            break;
+        case AlgorithmId::RobustNonLinearLeastSquaresEigenLm:
+            result.position = robustNonLinearLeastSquaresEigenLevenbergMarquardt(
+                anchorPositions, ranges, rangeNoiseStdDev, robustLossParam, &result);
+            break;
+        case AlgorithmId::LinearLeastSquaresIYueWang:
+            result.position = linearLeastSquaresI_YueWang(anchorPositions, ranges, &result);
+            break;
+        case AlgorithmId::LinearLeastSquaresII2YueWang:
+            result.position = linearLeastSquaresII_2_YueWang(anchorPositions, ranges, &result);
+            break;
+        case AlgorithmId::TwoStepWeightedLinearLeastSquaresIYueWang:
+            result.position = twoStepWeightedLinearLeastSquaresI_YueWang(
+                anchorPositions,
+                ranges,
+                RangesView(&rangeNoiseStdDev, ranges.size(), 0),
+                &result);
+            break;
+        case AlgorithmId::NonLinearLeastSquaresAnalyticLm:
+            result.position = nonLinearLeastSquaresAnalyticLevenbergMarquardt(
+                anchorPositions, ranges, LevenbergMarquardtOptions{}, &result);
+            break;
+        case AlgorithmId::RobustNonLinearLeastSquaresAnalyticLm:
+            result.position = robustNonLinearLeastSquaresAnalyticLevenbergMarquardt(
+                anchorPositions, ranges, rangeNoiseStdDev, robustLossParam, RobustLevenbergMarquardtOptions{}, &result).position;
+            break;
+        default:
+            throw std::runtime_error("Invalid algorithm id");
+    }
+
+    result.finalCost = rangeResidualCost(anchorPositions, ranges, result.position);
+    return result;
+}
+
+PositionMatrix runAlgorithmBatch(
+    const AlgorithmId algorithm,
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const RangeMatrix& ranges,
+    const double rangeNoiseStdDev,
+    const double robustLossParam
+) {
+    switch (algorithm) {
+        case AlgorithmId::OrdinaryLeastSquaresWikipedia:
+            return ordinaryLeastSquaresWikipediaBatch(anchorPositions, ranges);
+        case AlgorithmId::OrdinaryLeastSquaresWikipediaBdcsvd:
+            return ordinaryLeastSquaresWikipedia2Batch(anchorPositions, ranges);
+        case AlgorithmId::LinearLeastSquaresIYueWang:
+            return linearLeastSquaresI_YueWangBatch(anchorPositions, ranges);
+        case AlgorithmId::LinearLeastSquaresII2YueWang:
+            return linearLeastSquaresII_2_YueWangBatch(anchorPositions, ranges);
+        default:
+            break;
+    }
+
+    if (ranges.cols() != static_cast<Eigen::Index>(anchorPositions.size())) {
+        throw std::invalid_argument("Range matrix columns must match the number of anchors");
+    }
+
+    // Each row of the column-major range matrix is read in place as a strided view
+    PositionMatrix posEstimates(ranges.rows(), 3);
+    for (Eigen::Index t = 0; t < ranges.rows(); ++t) {
+        const RangesView tagRanges(ranges.data() + t, anchorPositions.size(), ranges.outerStride());
+        posEstimates.row(t) = runAlgorithm(
+            algorithm, anchorPositions, tagRanges, rangeNoiseStdDev, robustLossParam).transpose();
+    }
+    return posEstimates;
+}
+
 }  // namespace TrueRangeMultilateration
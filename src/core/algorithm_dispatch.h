@@ -5,6 +5,8 @@
 #include <Eigen/Dense>
 
 #include "simulation_types.h"
+#include "../measurement_views.h"
+#include "../batch_multilateration.h"
 
 namespace TrueRangeMultilateration {
 
@@ -16,4 +18,35 @@ Eigen::Vector3d runAlgorithm(
     double robustLossParam = 5.0
 );
 
+// runAlgorithm over caller-owned (strided or float) anchor and range memory, with
+// no intermediate containers. TS-WLLS-I reads its per-range standard deviations
+// from a stride-0 view of rangeNoiseStdDev.
+Eigen::Vector3d runAlgorithm(
+    AlgorithmId algorithm,
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    double rangeNoiseStdDev,
+    double robustLossParam = 5.0
+);
+
+// runAlgorithm on views that also reports the estimator's diagnostics and per-stage
+// timings. finalCost is the unweighted range residual cost, evaluated after timing stops.
+SolveResult runAlgorithmWithDiagnostics(
+    AlgorithmId algorithm,
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    double rangeNoiseStdDev,
+    double robustLossParam = 5.0
+);
+
+// Solves every row of a tags x anchors range matrix against one shared anchor set.
+// Linearised algorithms factor the anchor geometry once; the others are solved tag by tag.
+PositionMatrix runAlgorithmBatch(
+    AlgorithmId algorithm,
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const RangeMatrix& ranges,
+    double rangeNoiseStdDev,
+    double robustLossParam = 5.0
+);
+
 }  // namespace TrueRangeMultilateration
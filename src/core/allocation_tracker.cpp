@@ -0,0 +1,114 @@
+#include "allocation_tracker.h"
+
+#include <cstdlib>
+#include <new>
+
+#include "algorithm_dispatch.h"
+
+namespace {
+
+// Plain thread_local PODs: constant-initialized, so safe to touch from malloc
+// before and during thread start-up.
+constinit thread_local uint64_t threadAllocations = 0;
+constinit thread_local uint64_t threadAllocatedBytes = 0;
+
+[[maybe_unused]] void recordAllocation(const size_t size) noexcept {
+    ++threadAllocations;
+    threadAllocatedBytes += size;
+}
+
+}  // namespace
+
+#ifdef MULTILAT_ALLOCATION_TRACKING
+#if defined(__GLIBC__)
+extern "C" {
+void* __libc_malloc(size_t size) noexcept;
+void* __libc_calloc(size_t count, size_t size) noexcept;
+void* __libc_realloc(void* ptr, size_t size) noexcept;
+
+void* malloc(size_t size) noexcept {
+    recordAllocation(size);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) noexcept {
+    recordAllocation(count * size);
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) noexcept {
+    recordAllocation(size);
+    return __libc_realloc(ptr, size);
+}
+}
+#else
+void* operator new(size_t size) {
+    recordAllocation(size);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+#endif
+#endif
+
+namespace TrueRangeMultilateration {
+
+bool allocationTrackingEnabled() {
+#ifdef MULTILAT_ALLOCATION_TRACKING
+    return true;
+#else
+    return false;
+#endif
+}
+
+AllocationCounts threadAllocationCounts() {
+    return {threadAllocations, threadAllocatedBytes};
+}
+
+AlgorithmAllocationProfile profileAlgorithmAllocations(
+    const AlgorithmId algorithm,
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const std::vector<double>& ranges,
+    const double rangeNoiseStdDev,
+    const size_t calls) {
+    AlgorithmAllocationProfile profile;
+    profile.algorithm = algorithm;
+    if (calls == 0) {
+        return profile;
+    }
+
+    // Warm-up, so one-off lazy initialization is not attributed to every call
+    (void)runAlgorithm(algorithm, anchorPositions, ranges, rangeNoiseStdDev);
+
+    const ScopedAllocationCounter counter;
+    for (size_t i = 0; i < calls; ++i) {
+        (void)runAlgorithm(algorithm, anchorPositions, ranges, rangeNoiseStdDev);
+    }
+    const AllocationCounts counts = counter.counts();
+    profile.allocationsPerCall = static_cast<double>(counts.allocations) / static_cast<double>(calls);
+    profile.bytesPerCall = static_cast<double>(counts.bytes) / static_cast<double>(calls);
+    return profile;
+}
+
+}  // namespace TrueRangeMultilateration
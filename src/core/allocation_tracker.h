@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include "simulation_types.h"
+
+namespace TrueRangeMultilateration {
+
+struct AllocationCounts {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+};
+
+inline AllocationCounts operator-(const AllocationCounts& lhs, const AllocationCounts& rhs) {
+    return {lhs.allocations - rhs.allocations, lhs.bytes - rhs.bytes};
+}
+
+// True when multilat_core was built with MULTILAT_ALLOCATION_TRACKING. Only then
+// are heap allocations counted; otherwise every count below stays zero.
+//
+// Tracking replaces the global allocator for the whole program. On glibc malloc,
+// calloc and realloc are interposed, which also covers Eigen (it allocates with
+// std::malloc) and operator new. Elsewhere only operator new is counted.
+[[nodiscard]] bool allocationTrackingEnabled();
+
+// Allocations made by the calling thread since it started. realloc counts as one
+// allocation of the new size; frees are not subtracted.
+[[nodiscard]] AllocationCounts threadAllocationCounts();
+
+// Counts the calling thread's allocations from construction onwards.
+class ScopedAllocationCounter {
+  public:
+    ScopedAllocationCounter() : start_(threadAllocationCounts()) {}
+
+    [[nodiscard]] AllocationCounts counts() const { return threadAllocationCounts() - start_; }
+
+  private:
+    AllocationCounts start_;
+};
+
+struct AlgorithmAllocationProfile {
+    AlgorithmId algorithm = AlgorithmId::OrdinaryLeastSquaresWikipedia;
+    double allocationsPerCall = 0.0;
+    double bytesPerCall = 0.0;
+};
+
+// Average heap traffic of runAlgorithm over `calls` calls on one input, after one
+// uncounted warm-up call.
+AlgorithmAllocationProfile profileAlgorithmAllocations(
+    AlgorithmId algorithm,
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const std::vector<double>& ranges,
+    double rangeNoiseStdDev,
+    size_t calls = 16
+);
+
+}  // namespace TrueRangeMultilateration
@@ -0,0 +1,108 @@
+#include "common_random_numbers.h"
+
+#include <chrono>
+#include <cmath>
+#include <random>
+
+#include "algorithm_dispatch.h"
+#include "error_statistics.h"
+#include "../test_helpers.h"
+
+namespace TrueRangeMultilateration {
+
+namespace {
+
+// Welford running mean and variance
+struct RunningMoments {
+    size_t count = 0;
+    double mean = 0.0;
+    double sumSquares = 0.0;
+
+    void add(const double value) {
+        ++count;
+        const double delta = value - mean;
+        mean += delta / static_cast<double>(count);
+        sumSquares += delta * (value - mean);
+    }
+
+    [[nodiscard]] double variance() const {
+        return count > 1 ? sumSquares / static_cast<double>(count - 1) : 0.0;
+    }
+};
+
+struct PairedMoments {
+    RunningMoments difference;
+    RunningMoments errorNorm;
+    RunningMoments referenceErrorNorm;
+};
+
+}  // namespace
+
+std::vector<CommonRandomNumbersResult> runCommonRandomNumbers(
+    const TestParameters& params,
+    const std::vector<AlgorithmId>& algorithms,
+    ResultSink* resultSink) {
+    std::vector<ErrorStatisticsAccumulator> statistics(algorithms.size(), ErrorStatisticsAccumulator(params.truePosition));
+    std::vector<PairedMoments> paired(algorithms.size());
+    std::vector<double> solveNs(algorithms.size(), 0.0);
+    std::vector<Eigen::Vector3d> estimates(algorithms.size());
+    RunRecord record;
+
+    std::mt19937_64 rng = makeRandomEngine(params.randomSeed);
+    std::vector<Eigen::Vector3d> anchorPositions = params.anchorPositions;
+    for (size_t run = 0; run < params.numRuns; ++run) {
+        if (params.anchorPosNoiseStdDev > 0.0) {
+            anchorPositions = generateNoisyAnchorPositions(params.anchorPositions, params.anchorPosNoiseStdDev, rng);
+        }
+        const std::vector<double> ranges = generateNoisyRanges(params, rng);
+
+        for (size_t a = 0; a < algorithms.size(); ++a) {
+            const auto startedAt = std::chrono::steady_clock::now();
+            estimates[a] = runAlgorithm(algorithms[a], anchorPositions, ranges, params.rangeNoiseStdDev);
+            solveNs[a] += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startedAt).count();
+            statistics[a].add(estimates[a]);
+        }
+
+        const bool referenceFinite = !estimates.empty() && estimates.front().allFinite();
+        const double referenceErrorNorm = referenceFinite ? (estimates.front() - params.truePosition).norm() : 0.0;
+        for (size_t a = 1; a < algorithms.size(); ++a) {
+            if (referenceFinite && estimates[a].allFinite()) {
+                const double errorNorm = (estimates[a] - params.truePosition).norm();
+                paired[a].difference.add(errorNorm - referenceErrorNorm);
+                paired[a].errorNorm.add(errorNorm);
+                paired[a].referenceErrorNorm.add(referenceErrorNorm);
+            }
+        }
+
+        if (resultSink != nullptr) {
+            record.runIndex = run;
+            for (size_t a = 0; a < algorithms.size(); ++a) {
+                record.algorithm = algorithms[a];
+                record.result.position = estimates[a];
+                record.error = estimates[a] - params.truePosition;
+                resultSink->write(record);
+            }
+        }
+    }
+
+    std::vector<CommonRandomNumbersResult> results(algorithms.size());
+    for (size_t a = 0; a < algorithms.size(); ++a) {
+        CommonRandomNumbersResult& result = results[a];
+        result.algorithm = algorithms[a];
+        result.results = statistics[a].results();
+        result.meanSolveNs = params.numRuns > 0 ? solveNs[a] / static_cast<double>(params.numRuns) : 0.0;
+
+        const PairedMoments& moments = paired[a];
+        result.pairedRuns = moments.difference.count;
+        if (moments.difference.count > 0) {
+            const double count = static_cast<double>(moments.difference.count);
+            result.meanErrorNormDifference = moments.difference.mean;
+            result.pairedStdError = std::sqrt(moments.difference.variance() / count);
+            result.unpairedStdError =
+                std::sqrt((moments.errorNorm.variance() + moments.referenceErrorNorm.variance()) / count);
+        }
+    }
+    return results;
+}
+
+}  // namespace TrueRangeMultilateration
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "result_sink.h"
+#include "simulation_types.h"
+
+namespace TrueRangeMultilateration {
+
+struct CommonRandomNumbersResult {
+    AlgorithmId algorithm = AlgorithmId::OrdinaryLeastSquaresWikipedia;
+    // Over every run, as runTest reports them
+    TestResults results;
+    double meanSolveNs = 0.0;
+    // Per-run ||error|| minus the reference algorithm's, over the runs where both estimates
+    // are finite; all zero for the reference itself.
+    size_t pairedRuns = 0;
+    double meanErrorNormDifference = 0.0;
+    double pairedStdError = 0.0;
+    // Standard error the same mean difference would have from independent draws
+    double unpairedStdError = 0.0;
+};
+
+// Solves every run with each of the algorithms on the same noisy ranges and anchor
+// coordinates, generated once per run. Runs draw from one makeRandomEngine(params.randomSeed)
+// stream in the order runTest uses, so each algorithm's results match a separate runTest
+// through runAlgorithm for the same seed. algorithms.front() is the reference of the
+// paired differences. resultSink, if given, receives every run of every algorithm, run by run.
+std::vector<CommonRandomNumbersResult> runCommonRandomNumbers(
+    const TestParameters& params,
+    const std::vector<AlgorithmId>& algorithms,
+    ResultSink* resultSink = nullptr
+);
+
+}  // namespace TrueRangeMultilateration
@@ -0,0 +1,123 @@
+#include "error_statistics.h"
+
+#include <algorithm>
+
+namespace TrueRangeMultilateration {
+
+ErrorStatisticsAccumulator::ErrorStatisticsAccumulator(const Eigen::Vector3d& truePosition)
+    : truePosition_(truePosition) {}
+
+void ErrorStatisticsAccumulator::add(const Eigen::Vector3d& estimatedPosition) {
+    const Eigen::Vector3d error = estimatedPosition - truePosition_;
+    const Eigen::Vector3d absError = error.cwiseAbs();
+
+    ++count_;
+    const double invCount = 1.0 / static_cast<double>(count_);
+    const Eigen::Vector3d delta = error - meanError_;
+    meanError_ += delta * invCount;
+    // Welford's co-moment update delta * (error - updated mean)^T, written in its symmetric form
+    centeredComoment_.noalias() += (1.0 - invCount) * delta * delta.transpose();
+    meanAbsError_ += (absError - meanAbsError_) * invCount;
+    maxAbsError_ = maxAbsError_.cwiseMax(absError);
+}
+
+void ErrorStatisticsAccumulator::merge(const ErrorStatisticsAccumulator& other) {
+    if (other.count_ == 0) {
+        return;
+    }
+    if (count_ == 0) {
+        *this = other;
+        return;
+    }
+
+    const double n1 = static_cast<double>(count_);
+    const double n2 = static_cast<double>(other.count_);
+    const double n = n1 + n2;
+    const Eigen::Vector3d delta = other.meanError_ - meanError_;
+
+    meanError_ += delta * (n2 / n);
+    centeredComoment_ += other.centeredComoment_ + (n1 * n2 / n) * delta * delta.transpose();
+    meanAbsError_ += (other.meanAbsError_ - meanAbsError_) * (n2 / n);
+    maxAbsError_ = maxAbsError_.cwiseMax(other.maxAbsError_);
+    count_ += other.count_;
+}
+
+void ErrorStatisticsAccumulator::reset() {
+    *this = ErrorStatisticsAccumulator(truePosition_);
+}
+
+TestResults ErrorStatisticsAccumulator::results() const {
+    TestResults results;
+    if (count_ == 0) {
+        return results;
+    }
+
+    results.meanSignedError = meanError_;
+    results.meanAbsError = meanAbsError_;
+    results.maxError = maxAbsError_;
+    results.errorCovariance = centeredComoment_ / static_cast<double>(count_);
+    // E[e e^T] = Cov(e) + E[e] E[e]^T
+    results.errorSecondMoment = results.errorCovariance + meanError_ * meanError_.transpose();
+    return results;
+}
+
+void SolveDiagnosticsAccumulator::add(const SolveResult& result) {
+    ++count_;
+    totalFinalCost_ += result.finalCost;
+    totalIterations_ += result.iterations;
+    maxIterations_ = std::max(maxIterations_, result.iterations);
+    totalOuterIterations_ += result.outerIterations;
+    totalFunctionEvaluations_ += result.functionEvaluations;
+    if (!result.converged) {
+        ++nonConvergedCount_;
+    }
+    if (result.rank >= 0 && (minRank_ < 0 || result.rank < minRank_)) {
+        minRank_ = result.rank;
+    }
+    totalTimings_.setupNs += result.timings.setupNs;
+    totalTimings_.factorizationNs += result.timings.factorizationNs;
+    totalTimings_.refinementNs += result.timings.refinementNs;
+}
+
+void SolveDiagnosticsAccumulator::merge(const SolveDiagnosticsAccumulator& other) {
+    count_ += other.count_;
+    totalFinalCost_ += other.totalFinalCost_;
+    totalIterations_ += other.totalIterations_;
+    maxIterations_ = std::max(maxIterations_, other.maxIterations_);
+    totalOuterIterations_ += other.totalOuterIterations_;
+    totalFunctionEvaluations_ += other.totalFunctionEvaluations_;
+    nonConvergedCount_ += other.nonConvergedCount_;
+    if (other.minRank_ >= 0 && (minRank_ < 0 || other.minRank_ < minRank_)) {
+        minRank_ = other.minRank_;
+    }
+    totalTimings_.setupNs += other.totalTimings_.setupNs;
+    totalTimings_.factorizationNs += other.totalTimings_.factorizationNs;
+    totalTimings_.refinementNs += other.totalTimings_.refinementNs;
+}
+
+void SolveDiagnosticsAccumulator::reset() {
+    *this = SolveDiagnosticsAccumulator();
+}
+
+SolveDiagnosticsSummary SolveDiagnosticsAccumulator::summary() const {
+    SolveDiagnosticsSummary summary;
+    if (count_ == 0) {
+        return summary;
+    }
+
+    const double invCount = 1.0 / static_cast<double>(count_);
+    summary.count = count_;
+    summary.meanFinalCost = totalFinalCost_ * invCount;
+    summary.meanIterations = static_cast<double>(totalIterations_) * invCount;
+    summary.maxIterations = maxIterations_;
+    summary.meanOuterIterations = static_cast<double>(totalOuterIterations_) * invCount;
+    summary.meanFunctionEvaluations = static_cast<double>(totalFunctionEvaluations_) * invCount;
+    summary.nonConvergedCount = nonConvergedCount_;
+    summary.minRank = minRank_;
+    summary.meanSetupNs = static_cast<double>(totalTimings_.setupNs) * invCount;
+    summary.meanFactorizationNs = static_cast<double>(totalTimings_.factorizationNs) * invCount;
+    summary.meanRefinementNs = static_cast<double>(totalTimings_.refinementNs) * invCount;
+    return summary;
+}
+
+}  // namespace TrueRangeMultilateration
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+
+#include <Eigen/Dense>
+
+#include "simulation_types.h"
+
+namespace TrueRangeMultilateration {
+
+// Single-pass, O(1)-memory accumulator of position-error statistics.
+// Mean and centered co-moment use Welford's update; partial accumulators from
+// different threads or batches combine with the pairwise formula of Chan,
+// Golub and LeVeque. results() yields the same fields as computeResults().
+class ErrorStatisticsAccumulator {
+  public:
+    explicit ErrorStatisticsAccumulator(const Eigen::Vector3d& truePosition = Eigen::Vector3d::Zero());
+
+    void add(const Eigen::Vector3d& estimatedPosition);
+    // Folds in another accumulator for the same true position.
+    void merge(const ErrorStatisticsAccumulator& other);
+    void reset();
+
+    [[nodiscard]] size_t count() const { return count_; }
+    [[nodiscard]] const Eigen::Vector3d& truePosition() const { return truePosition_; }
+    // Zero-initialized results when no estimate has been added.
+    [[nodiscard]] TestResults results() const;
+
+  private:
+    Eigen::Vector3d truePosition_;
+    size_t count_ = 0;
+    Eigen::Vector3d meanError_ = Eigen::Vector3d::Zero();
+    Eigen::Vector3d meanAbsError_ = Eigen::Vector3d::Zero();
+    Eigen::Vector3d maxAbsError_ = Eigen::Vector3d::Zero();
+    // Sum of (e - mean)(e - mean)^T over all samples
+    Eigen::Matrix3d centeredComoment_ = Eigen::Matrix3d::Zero();
+};
+
+// Sums SolveResult diagnostics run by run; summary() reports per-run means. Costs and
+// counts are summed in the order runs are added, so a fixed order gives identical results.
+class SolveDiagnosticsAccumulator {
+  public:
+    void add(const SolveResult& result);
+    void merge(const SolveDiagnosticsAccumulator& other);
+    void reset();
+
+    [[nodiscard]] size_t count() const { return count_; }
+    // Zero-initialized summary when no result has been added.
+    [[nodiscard]] SolveDiagnosticsSummary summary() const;
+
+  private:
+    size_t count_ = 0;
+    double totalFinalCost_ = 0.0;
+    size_t totalIterations_ = 0;
+    size_t maxIterations_ = 0;
+    size_t totalOuterIterations_ = 0;
+    size_t totalFunctionEvaluations_ = 0;
+    size_t nonConvergedCount_ = 0;
+    int minRank_ = -1;
+    SolveStageTimings totalTimings_{};
+};
+
+}  // namespace TrueRangeMultilateration
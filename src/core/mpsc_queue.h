@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace TrueRangeMultilateration {
+
+// Bounded, lock-free queue for many producer threads and one consumer thread
+// (Vyukov's bounded ring). Each cell carries a sequence number that tells a
+// producer whether the cell is free and the consumer whether it is filled, so
+// tryPush and tryPop are one compare-and-swap or one load and never block. The
+// capacity is rounded up to a power of two and fixed at construction.
+template<typename T>
+class BoundedMpscQueue {
+    static_assert(std::is_trivially_copyable_v<T>, "BoundedMpscQueue stores plain values");
+
+  public:
+    explicit BoundedMpscQueue(size_t capacity)
+        : mask_(std::bit_ceil(capacity < 2 ? size_t{2} : capacity) - 1), cells_(new Cell[mask_ + 1]) {
+        for (size_t i = 0; i <= mask_; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedMpscQueue(const BoundedMpscQueue&) = delete;
+    BoundedMpscQueue& operator=(const BoundedMpscQueue&) = delete;
+
+    // Safe from any number of threads. Returns false if the queue is full.
+    bool tryPush(const T& value) {
+        size_t position = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[position & mask_];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+            if (difference == 0) {
+                if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Consumer thread only. Returns false if no completed push is waiting.
+    bool tryPop(T& value) {
+        Cell& cell = cells_[head_ & mask_];
+        const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (sequence != head_ + 1) {
+            return false;
+        }
+        value = cell.value;
+        cell.sequence.store(head_ + mask_ + 1, std::memory_order_release);
+        ++head_;
+        return true;
+    }
+
+    [[nodiscard]] size_t capacity() const { return mask_ + 1; }
+
+  private:
+    struct Cell {
+        std::atomic<size_t> sequence{0};
+        T value{};
+    };
+
+    // Producers contend on tail_; keep it off the consumer's cache line.
+    static constexpr size_t cacheLineSize = 64;
+
+    const size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+    alignas(cacheLineSize) std::atomic<size_t> tail_{0};
+    alignas(cacheLineSize) size_t head_ = 0;
+};
+
+}  // namespace TrueRangeMultilateration
@@ -0,0 +1,373 @@
+#include "parameter_sweep.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <format>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <numbers>
+#include <random>
+#include <stdexcept>
+#include <string_view>
+
+#include "algorithm_dispatch.h"
+#include "error_statistics.h"
+#include "work_stealing_pool.h"
+#include "../test_helpers.h"
+#include "../true_range_multilateration_methods.h"
+
+namespace TrueRangeMultilateration {
+
+namespace {
+
+std::string_view trim(std::string_view text) {
+    const size_t begin = text.find_first_not_of(" \t\r");
+    if (begin == std::string_view::npos) {
+        return {};
+    }
+    const size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+std::vector<std::string> splitList(std::string_view text) {
+    std::vector<std::string> values;
+    size_t begin = 0;
+    while (begin <= text.size()) {
+        const size_t end = std::min(text.find(',', begin), text.size());
+        values.emplace_back(trim(text.substr(begin, end - begin)));
+        begin = end + 1;
+    }
+    return values;
+}
+
+AnchorLayout parseAnchorLayout(const std::string& name) {
+    if (name == "ring") {
+        return AnchorLayout::Ring;
+    }
+    if (name == "ceiling") {
+        return AnchorLayout::Ceiling;
+    }
+    if (name == "random") {
+        return AnchorLayout::Random;
+    }
+    throw std::invalid_argument("unknown anchor layout '" + name + "'");
+}
+
+// Noisy inputs of every run of one scenario, shared by its algorithm jobs
+struct ScenarioInputs {
+    std::vector<std::vector<double>> ranges;
+    // Empty when the scenario has no anchor position noise
+    std::vector<std::vector<Eigen::Vector3d>> anchorPositions;
+};
+
+}  // namespace
+
+SweepConfig parseSweepConfig(std::istream& in) {
+    SweepConfig config;
+    std::string line;
+    for (size_t lineNumber = 1; std::getline(in, line); ++lineNumber) {
+        const std::string_view content = trim(std::string_view(line).substr(0, line.find('#')));
+        if (content.empty()) {
+            continue;
+        }
+
+        try {
+            const size_t equals = content.find('=');
+            if (equals == std::string_view::npos) {
+                throw std::invalid_argument("expected 'key = value'");
+            }
+            const std::string_view key = trim(content.substr(0, equals));
+            const std::vector<std::string> values = splitList(trim(content.substr(equals + 1)));
+            auto doubles = [&values] {
+                std::vector<double> parsed;
+                for (const std::string& value : values) {
+                    parsed.push_back(std::stod(value));
+                }
+                return parsed;
+            };
+            auto single = [&values, key] {
+                if (values.size() != 1) {
+                    throw std::invalid_argument(std::format("{} takes one value", key));
+                }
+                return values.front();
+            };
+
+            if (key == "range_noise_std_dev") {
+                config.rangeNoiseStdDevs = doubles();
+            } else if (key == "range_outlier_ratio") {
+                config.rangeOutlierRatios = doubles();
+            } else if (key == "anchor_position_noise") {
+                config.anchorPosNoiseStdDevs = doubles();
+            } else if (key == "anchor_count") {
+                config.anchorCounts.clear();
+                for (const std::string& value : values) {
+                    config.anchorCounts.push_back(static_cast<size_t>(std::stoull(value)));
+                }
+            } else if (key == "anchor_layout") {
+                config.anchorLayouts.clear();
+                for (const std::string& value : values) {
+                    config.anchorLayouts.push_back(parseAnchorLayout(value));
+                }
+            } else if (key == "algorithms") {
+                config.algorithms.clear();
+                const bool all = values.size() == 1 && values.front() == "all";
+                for (size_t i = 0; !all && i < values.size(); ++i) {
+                    const size_t id = static_cast<size_t>(std::stoull(values[i]));
+                    if (id >= algorithmCount) {
+                        throw std::invalid_argument(std::format("unknown AlgorithmId {}", id));
+                    }
+                    config.algorithms.push_back(static_cast<AlgorithmId>(id));
+                }
+            } else if (key == "outlier_magnitude") {
+                config.rangeOutlierMagnitude = std::stod(single());
+            } else if (key == "layout_size") {
+                config.layoutSize = std::stod(single());
+            } else if (key == "true_position") {
+                const std::vector<double> position = doubles();
+                if (position.size() != 3) {
+                    throw std::invalid_argument("true_position takes x, y, z");
+                }
+                config.truePosition = Eigen::Vector3d(position[0], position[1], position[2]);
+            } else if (key == "runs") {
+                config.numRuns = static_cast<size_t>(std::stoull(single()));
+            } else if (key == "seed") {
+                config.randomSeed = std::stoull(single());
+            } else {
+                throw std::invalid_argument(std::format("unknown key '{}'", key));
+            }
+        } catch (const std::logic_error& e) {
+            // std::stod and friends throw invalid_argument or out_of_range with terse messages
+            throw std::invalid_argument(std::format("Sweep config line {}: {}", lineNumber, e.what()));
+        }
+    }
+
+    for (const double ratio : config.rangeOutlierRatios) {
+        if (ratio < 0.0 || ratio > 1.0) {
+            throw std::invalid_argument("Sweep config: range_outlier_ratio must be in [0, 1].");
+        }
+    }
+    for (const size_t anchorCount : config.anchorCounts) {
+        if (anchorCount < 4) {
+            throw std::invalid_argument("Sweep config: anchor_count must be at least 4.");
+        }
+    }
+    if (config.numRuns == 0) {
+        throw std::invalid_argument("Sweep config: runs must be positive.");
+    }
+    return config;
+}
+
+SweepConfig loadSweepConfig(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("Cannot open sweep config " + path);
+    }
+    return parseSweepConfig(file);
+}
+
+std::vector<Eigen::Vector3d> makeAnchorLayout(
+    const AnchorLayout layout,
+    const size_t anchorCount,
+    const double layoutSize,
+    const uint64_t seed) {
+    std::vector<Eigen::Vector3d> anchors(anchorCount);
+    const double half = 0.5 * layoutSize;
+    switch (layout) {
+        case AnchorLayout::Ring:
+            for (size_t i = 0; i < anchorCount; ++i) {
+                const double angle = 2.0 * std::numbers::pi * static_cast<double>(i) / static_cast<double>(anchorCount);
+                anchors[i] = Eigen::Vector3d(half * std::cos(angle), half * std::sin(angle), (i % 2 == 0) ? 0.0 : layoutSize);
+            }
+            break;
+        case AnchorLayout::Ceiling: {
+            const size_t columns = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(anchorCount))));
+            const size_t rows = (anchorCount + columns - 1) / columns;
+            for (size_t i = 0; i < anchorCount; ++i) {
+                const double x = -half + layoutSize * (static_cast<double>(i % columns) + 0.5) / static_cast<double>(columns);
+                const double y = -half + layoutSize * (static_cast<double>(i / columns) + 0.5) / static_cast<double>(rows);
+                anchors[i] = Eigen::Vector3d(x, y, layoutSize);
+            }
+            break;
+        }
+        case AnchorLayout::Random: {
+            std::mt19937_64 rng = makeRunRandomEngine(seed, anchorCount);
+            std::uniform_real_distribution<double> horizontal(-half, half);
+            std::uniform_real_distribution<double> vertical(0.0, layoutSize);
+            for (Eigen::Vector3d& anchor : anchors) {
+                anchor = Eigen::Vector3d(horizontal(rng), horizontal(rng), vertical(rng));
+            }
+            break;
+        }
+    }
+    return anchors;
+}
+
+std::string anchorLayoutName(const AnchorLayout layout) {
+    switch (layout) {
+        case AnchorLayout::Ring:
+            return "ring";
+        case AnchorLayout::Ceiling:
+            return "ceiling";
+        case AnchorLayout::Random:
+            return "random";
+    }
+    return "unknown";
+}
+
+std::vector<SweepScenario> expandSweepGrid(const SweepConfig& config) {
+    std::vector<SweepScenario> scenarios;
+    for (const double rangeNoiseStdDev : config.rangeNoiseStdDevs) {
+        for (const double rangeOutlierRatio : config.rangeOutlierRatios) {
+            for (const size_t anchorCount : config.anchorCounts) {
+                for (const AnchorLayout layout : config.anchorLayouts) {
+                    for (const double anchorPosNoiseStdDev : config.anchorPosNoiseStdDevs) {
+                        SweepScenario scenario;
+                        scenario.index = scenarios.size();
+                        scenario.anchorLayout = layout;
+                        TestParameters& params = scenario.params;
+                        params.truePosition = config.truePosition;
+                        params.anchorPositions = makeAnchorLayout(layout, anchorCount, config.layoutSize, config.randomSeed);
+                        params.rangeNoiseStdDev = rangeNoiseStdDev;
+                        params.rangeOutlierRatio = rangeOutlierRatio;
+                        params.rangeOutlierMagnitude = config.rangeOutlierMagnitude;
+                        params.anchorPosNoiseStdDev = anchorPosNoiseStdDev;
+                        params.randomSeed = config.randomSeed;
+                        params.numRuns = config.numRuns;
+                        params.keepEstimates = false;
+                        scenarios.push_back(std::move(scenario));
+                    }
+                }
+            }
+        }
+    }
+    return scenarios;
+}
+
+std::vector<SweepResult> runSweep(
+    const SweepConfig& config,
+    const std::vector<SweepScenario>& scenarios,
+    const SweepOptions& options) {
+    std::vector<AlgorithmId> algorithms = config.algorithms;
+    if (algorithms.empty()) {
+        for (size_t id = 0; id < algorithmCount; ++id) {
+            algorithms.push_back(static_cast<AlgorithmId>(id));
+        }
+    }
+
+    std::vector<SweepResult> results(scenarios.size() * algorithms.size());
+    std::mutex sinkMutex;
+    WorkStealingPool pool(options.threadCount);
+
+    auto runJob = [&](const SweepScenario& scenario, const ScenarioInputs& inputs, const size_t algorithmIndex) {
+        const TestParameters& params = scenario.params;
+        const AlgorithmId algorithm = algorithms[algorithmIndex];
+        SweepResult& result = results[scenario.index * algorithms.size() + algorithmIndex];
+        result.algorithm = algorithm;
+
+        std::vector<Eigen::Vector3d> estimates(params.numRuns);
+        const auto startedAt = std::chrono::steady_clock::now();
+        for (size_t run = 0; run < params.numRuns; ++run) {
+            const std::vector<Eigen::Vector3d>& anchors =
+                inputs.anchorPositions.empty() ? params.anchorPositions : inputs.anchorPositions[run];
+            estimates[run] = runAlgorithm(algorithm, anchors, inputs.ranges[run], params.rangeNoiseStdDev);
+        }
+        const auto endedAt = std::chrono::steady_clock::now();
+        result.meanSolveNs = std::chrono::duration<double, std::nano>(endedAt - startedAt).count()
+            / static_cast<double>(params.numRuns);
+
+        ErrorStatisticsAccumulator statistics(params.truePosition);
+        for (const Eigen::Vector3d& estimate : estimates) {
+            if (estimate.allFinite()) {
+                statistics.add(estimate);
+            } else {
+                ++result.failedRuns;
+            }
+        }
+        result.results = statistics.results();
+
+        if (options.runSink != nullptr) {
+            RunRecord record;
+            record.scenarioIndex = static_cast<uint32_t>(scenario.index);
+            record.algorithm = algorithm;
+            std::lock_guard<std::mutex> lock(sinkMutex);
+            for (size_t run = 0; run < params.numRuns; ++run) {
+                record.runIndex = run;
+                record.result.position = estimates[run];
+                record.error = estimates[run] - params.truePosition;
+                options.runSink->write(record);
+            }
+        }
+    };
+
+    for (const SweepScenario& scenario : scenarios) {
+        pool.submit([&config, &algorithms, &results, &pool, &runJob, &scenario] {
+            const TestParameters& params = scenario.params;
+
+            // Generated once and released when the scenario's last algorithm job finishes
+            auto inputs = std::make_shared<ScenarioInputs>();
+            inputs->ranges.resize(params.numRuns);
+            if (params.anchorPosNoiseStdDev > 0.0) {
+                inputs->anchorPositions.resize(params.numRuns);
+            }
+            for (size_t run = 0; run < params.numRuns; ++run) {
+                std::mt19937_64 rng = makeRunRandomEngine(config.randomSeed, run);
+                inputs->ranges[run] = generateNoisyRanges(
+                    params.truePosition, params.anchorPositions, params.rangeNoiseStdDev,
+                    params.rangeOutlierRatio, params.rangeOutlierMagnitude, rng);
+                if (params.anchorPosNoiseStdDev > 0.0) {
+                    inputs->anchorPositions[run] =
+                        generateNoisyAnchorPositions(params.anchorPositions, params.anchorPosNoiseStdDev, rng);
+                }
+            }
+
+            const CrlbResult crlb = calculateRangePositionCrlb(
+                params.anchorPositions, params.truePosition, params.rangeNoiseStdDev, params.anchorPosNoiseStdDev);
+            const double crlbRmsError = crlb.valid ? std::sqrt(crlb.crlb.trace()) : std::numeric_limits<double>::quiet_NaN();
+            for (size_t algorithmIndex = 0; algorithmIndex < algorithms.size(); ++algorithmIndex) {
+                SweepResult& result = results[scenario.index * algorithms.size() + algorithmIndex];
+                result.scenarioIndex = scenario.index;
+                result.runs = params.numRuns;
+                result.crlbRmsError = crlbRmsError;
+            }
+
+            // The first algorithm runs here while the rest wait for idle threads to steal them
+            for (size_t algorithmIndex = 1; algorithmIndex < algorithms.size(); ++algorithmIndex) {
+                pool.submit([&runJob, &scenario, inputs, algorithmIndex] { runJob(scenario, *inputs, algorithmIndex); });
+            }
+            if (!algorithms.empty()) {
+                runJob(scenario, *inputs, 0);
+            }
+        });
+    }
+    pool.wait();
+    return results;
+}
+
+void writeSweepResultsCsv(
+    std::ostream& out,
+    const std::vector<SweepScenario>& scenarios,
+    const std::vector<SweepResult>& results) {
+    out << "scenario,range_noise_std_dev,range_outlier_ratio,anchor_count,anchor_layout,anchor_position_noise,"
+           "algorithm_id,algorithm,runs,failed_runs,rms_error_m,crlb_rms_error_m,"
+           "bias_x,bias_y,bias_z,mean_abs_error_x,mean_abs_error_y,mean_abs_error_z,"
+           "max_error_x,max_error_y,max_error_z,mean_solve_ns\n";
+    for (const SweepResult& result : results) {
+        const SweepScenario& scenario = scenarios.at(result.scenarioIndex);
+        const TestParameters& params = scenario.params;
+        const TestResults& stats = result.results;
+        out << std::format("{},{},{},{},{},{},{},\"{}\",{},{},{:.6g},{:.6g},",
+            scenario.index, params.rangeNoiseStdDev, params.rangeOutlierRatio, params.anchorPositions.size(),
+            anchorLayoutName(scenario.anchorLayout), params.anchorPosNoiseStdDev,
+            static_cast<int>(result.algorithm), algorithmDisplayName(result.algorithm),
+            result.runs, result.failedRuns, std::sqrt(stats.errorSecondMoment.trace()), result.crlbRmsError);
+        out << std::format("{:.6g},{:.6g},{:.6g},{:.6g},{:.6g},{:.6g},{:.6g},{:.6g},{:.6g},{:.1f}\n",
+            stats.meanSignedError.x(), stats.meanSignedError.y(), stats.meanSignedError.z(),
+            stats.meanAbsError.x(), stats.meanAbsError.y(), stats.meanAbsError.z(),
+            stats.maxError.x(), stats.maxError.y(), stats.maxError.z(), result.meanSolveNs);
+    }
+}
+
+}  // namespace TrueRangeMultilateration
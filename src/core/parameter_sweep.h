@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include "result_sink.h"
+#include "simulation_types.h"
+
+namespace TrueRangeMultilateration {
+
+enum class AnchorLayout {
+    // Evenly spaced on a circle of diameter layoutSize, alternating between z = 0 and z = layoutSize
+    Ring = 0,
+    // Square grid on the plane z = layoutSize, as for ceiling-mounted anchors (coplanar)
+    Ceiling,
+    // Uniform in [-layoutSize/2, layoutSize/2]^2 x [0, layoutSize], drawn from the sweep seed
+    Random,
+};
+
+// A scenario grid. Every combination of the list-valued axes is one scenario, and
+// each scenario is run once per algorithm.
+struct SweepConfig {
+    std::vector<double> rangeNoiseStdDevs = {0.1};
+    std::vector<double> rangeOutlierRatios = {0.0};
+    std::vector<size_t> anchorCounts = {8};
+    std::vector<AnchorLayout> anchorLayouts = {AnchorLayout::Ring};
+    std::vector<double> anchorPosNoiseStdDevs = {0.0};
+    // Empty selects every AlgorithmId
+    std::vector<AlgorithmId> algorithms = {};
+    double rangeOutlierMagnitude = 10.0;
+    double layoutSize = 10.0;
+    Eigen::Vector3d truePosition = Eigen::Vector3d(0.0, 0.0, 5.0);
+    size_t numRuns = 500;
+    uint64_t randomSeed = 42;
+};
+
+// Reads "key = value[, value...]" lines; '#' starts a comment. Keys are the snake_case
+// names of the SweepConfig fields: range_noise_std_dev, range_outlier_ratio, anchor_count,
+// anchor_layout (ring, ceiling, random), anchor_position_noise, algorithms (AlgorithmId
+// values or "all"), outlier_magnitude, layout_size, true_position (x, y, z), runs and seed.
+// Throws std::invalid_argument naming the line for unknown keys and bad values.
+SweepConfig parseSweepConfig(std::istream& in);
+
+// parseSweepConfig on a file; throws std::runtime_error if it cannot be opened.
+SweepConfig loadSweepConfig(const std::string& path);
+
+std::vector<Eigen::Vector3d> makeAnchorLayout(AnchorLayout layout, size_t anchorCount, double layoutSize, uint64_t seed);
+
+std::string anchorLayoutName(AnchorLayout layout);
+
+struct SweepScenario {
+    size_t index = 0;
+    AnchorLayout anchorLayout = AnchorLayout::Ring;
+    // Everything but algorithm and the execution fields
+    TestParameters params;
+};
+
+// Scenarios in row-major order of the axes as listed in SweepConfig, the last axis fastest.
+std::vector<SweepScenario> expandSweepGrid(const SweepConfig& config);
+
+struct SweepResult {
+    size_t scenarioIndex = 0;
+    AlgorithmId algorithm = AlgorithmId::OrdinaryLeastSquaresWikipedia;
+    // Over the runs with a finite estimate
+    TestResults results;
+    size_t runs = 0;
+    // Runs whose estimate was not finite; left out of results
+    size_t failedRuns = 0;
+    double meanSolveNs = 0.0;
+    // sqrt(trace(CRLB)) at the true position; NaN when the CRLB is not valid
+    double crlbRmsError = 0.0;
+};
+
+struct SweepOptions {
+    // Threads, including the caller; 0 selects the hardware concurrency.
+    size_t threadCount = 0;
+    // Receives every run as a RunRecord tagged with its scenario index. Records of one
+    // (scenario, algorithm) job are contiguous and in run order; jobs arrive in completion order.
+    ResultSink* runSink = nullptr;
+};
+
+// Runs every (scenario, algorithm) job on a WorkStealingPool. Each scenario's noisy
+// ranges and anchor coordinates are generated once and shared by its algorithms, so
+// the algorithms are compared on identical draws. Run i of every scenario draws from
+// makeRunRandomEngine(randomSeed, i). Results are ordered by scenario, then by the
+// order of config.algorithms, and do not depend on the thread count.
+std::vector<SweepResult> runSweep(
+    const SweepConfig& config,
+    const std::vector<SweepScenario>& scenarios,
+    const SweepOptions& options = {}
+);
+
+// One CSV row per result, with the scenario's axis values alongside its statistics.
+void writeSweepResultsCsv(
+    std::ostream& out,
+    const std::vector<SweepScenario>& scenarios,
+    const std::vector<SweepResult>& results
+);
+
+}  // namespace TrueRangeMultilateration
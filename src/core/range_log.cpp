@@ -0,0 +1,293 @@
+#include "range_log.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "algorithm_dispatch.h"
+#include "thread_pool.h"
+
+namespace TrueRangeMultilateration {
+
+static_assert(std::endian::native == std::endian::little, "Range logs are read and written in place as little-endian");
+
+namespace {
+
+constexpr size_t anchorEntrySize = 3 * sizeof(double);
+
+}  // namespace
+
+RangeLogWriter::RangeLogWriter(const std::string& path, const std::vector<Eigen::Vector3d>& anchorPositions) {
+    if (anchorPositions.size() > std::numeric_limits<uint16_t>::max()) {
+        throw std::invalid_argument("A range log holds at most 65535 anchors.");
+    }
+    file_.open(path, std::ios::binary | std::ios::trunc);
+    if (!file_) {
+        throw std::runtime_error("Cannot create range log " + path);
+    }
+
+    RangeLogHeader header;
+    std::memcpy(header.magic, rangeLogMagic, sizeof(header.magic));
+    header.version = rangeLogVersion;
+    header.anchorCount = static_cast<uint32_t>(anchorPositions.size());
+    file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const Eigen::Vector3d& anchor : anchorPositions) {
+        file_.write(reinterpret_cast<const char*>(anchor.data()), anchorEntrySize);
+    }
+}
+
+RangeLogWriter::~RangeLogWriter() {
+    try {
+        close();
+    } catch (...) {
+    }
+}
+
+void RangeLogWriter::write(const RangeLogRecord& record) {
+    file_.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    ++recordCount_;
+}
+
+void RangeLogWriter::write(const std::span<const RangeLogRecord> records) {
+    file_.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(records.size_bytes()));
+    recordCount_ += records.size();
+}
+
+void RangeLogWriter::close() {
+    if (!file_.is_open()) {
+        return;
+    }
+    file_.seekp(offsetof(RangeLogHeader, recordCount));
+    file_.write(reinterpret_cast<const char*>(&recordCount_), sizeof(recordCount_));
+    file_.close();
+    if (file_.fail()) {
+        throw std::runtime_error("Writing the range log failed.");
+    }
+}
+
+RangeLogReader::RangeLogReader(const std::string& path) {
+#ifdef _WIN32
+    file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file_ == INVALID_HANDLE_VALUE) {
+        file_ = nullptr;
+        throw std::runtime_error("Cannot open range log " + path);
+    }
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx(file_, &fileSize);
+    size_ = static_cast<size_t>(fileSize.QuadPart);
+    if (size_ > 0) {
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        const void* view = mapping_ ? MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (view == nullptr) {
+            unmap();
+            throw std::runtime_error("Cannot map range log " + path);
+        }
+        data_ = static_cast<const std::byte*>(view);
+    }
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open range log " + path);
+    }
+    struct stat status {};
+    if (::fstat(fd, &status) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot read the size of range log " + path);
+    }
+    size_ = static_cast<size_t>(status.st_size);
+    if (size_ > 0) {
+        void* view = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (view == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("Cannot map range log " + path);
+        }
+        // Replay walks the records once from front to back
+        ::madvise(view, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const std::byte*>(view);
+    }
+    // The mapping keeps the file referenced
+    ::close(fd);
+#endif
+
+    RangeLogHeader header;
+    if (size_ < sizeof(header)) {
+        unmap();
+        throw std::runtime_error("Range log " + path + " is shorter than its header.");
+    }
+    std::memcpy(&header, data_, sizeof(header));
+    if (std::memcmp(header.magic, rangeLogMagic, sizeof(header.magic)) != 0 || header.version != rangeLogVersion) {
+        unmap();
+        throw std::runtime_error(path + " is not a version 1 range log.");
+    }
+
+    const size_t anchorBytes = header.anchorCount * anchorEntrySize;
+    const size_t available = (size_ - sizeof(header)) / sizeof(RangeLogRecord);
+    if (header.recordCount > available
+        || sizeof(header) + anchorBytes + header.recordCount * sizeof(RangeLogRecord) != size_) {
+        unmap();
+        throw std::runtime_error("Range log " + path + " is truncated or its record count does not match its size.");
+    }
+
+    anchorPositions_.resize(header.anchorCount);
+    for (size_t i = 0; i < header.anchorCount; ++i) {
+        std::memcpy(anchorPositions_[i].data(), data_ + sizeof(header) + i * anchorEntrySize, anchorEntrySize);
+    }
+    records_ = std::span<const RangeLogRecord>(
+        reinterpret_cast<const RangeLogRecord*>(data_ + sizeof(header) + anchorBytes),
+        static_cast<size_t>(header.recordCount));
+}
+
+RangeLogReader::~RangeLogReader() {
+    unmap();
+}
+
+void RangeLogReader::unmap() {
+#ifdef _WIN32
+    if (data_ != nullptr) {
+        UnmapViewOfFile(data_);
+    }
+    if (mapping_ != nullptr) {
+        CloseHandle(mapping_);
+    }
+    if (file_ != nullptr) {
+        CloseHandle(file_);
+    }
+    mapping_ = nullptr;
+    file_ = nullptr;
+#else
+    if (data_ != nullptr) {
+        ::munmap(const_cast<std::byte*>(data_), size_);
+    }
+#endif
+    data_ = nullptr;
+    records_ = {};
+}
+
+size_t findRangeLogEpochEnd(
+    const std::span<const RangeLogRecord> records,
+    const size_t begin,
+    const double epochDuration) {
+    if (begin >= records.size()) {
+        return records.size();
+    }
+    const uint32_t tagId = records[begin].tagId;
+    const double latest = records[begin].timestamp + epochDuration;
+    size_t end = begin + 1;
+    while (end < records.size() && records[end].tagId == tagId && records[end].timestamp <= latest) {
+        ++end;
+    }
+    return end;
+}
+
+RangeLogReplayStats replayRangeLog(
+    const RangeLogReader& reader,
+    const RangeLogReplayOptions& options,
+    const RangeLogFixCallback& onFix) {
+    const std::span<const RangeLogRecord> records = reader.records();
+    const std::vector<Eigen::Vector3d>& anchorTable = reader.anchorPositions();
+    const size_t minRanges = std::max<size_t>(1, options.minRangesPerFix);
+
+    // A share of the log starts at its first tag change, so every thread splits
+    // epochs from the same points a serial replay would.
+    auto alignToTagChange = [&](size_t index) {
+        while (index > 0 && index < records.size() && records[index].tagId == records[index - 1].tagId) {
+            ++index;
+        }
+        return index;
+    };
+
+    RangeLogReplayStats stats;
+    std::mutex statsMutex;
+    auto replayShare = [&](const size_t shareBegin, const size_t shareEnd) {
+        const size_t begin = alignToTagChange(shareBegin);
+        const size_t end = alignToTagChange(shareEnd);
+
+        RangeLogReplayStats local;
+        std::vector<Eigen::Vector3d> anchors;
+        std::vector<double> ranges;
+        for (size_t epochBegin = begin; epochBegin < end;) {
+            const size_t epochEnd = findRangeLogEpochEnd(records, epochBegin, options.epochDuration);
+            ++local.epochs;
+
+            anchors.clear();
+            ranges.clear();
+            double newestTimestamp = records[epochBegin].timestamp;
+            double varianceSum = 0.0;
+            size_t varianceCount = 0;
+            for (size_t i = epochBegin; i < epochEnd; ++i) {
+                const RangeLogRecord& record = records[i];
+                if (record.anchorIndex >= anchorTable.size()) {
+                    ++local.invalidAnchorRecords;
+                    continue;
+                }
+                anchors.push_back(anchorTable[record.anchorIndex]);
+                ranges.push_back(record.range);
+                newestTimestamp = std::max(newestTimestamp, record.timestamp);
+                if (record.flags & rangeLogHasStdDev) {
+                    varianceSum += static_cast<double>(record.rangeStdDev) * record.rangeStdDev;
+                    ++varianceCount;
+                }
+            }
+
+            const uint32_t tagId = records[epochBegin].tagId;
+            epochBegin = epochEnd;
+            if (ranges.size() < minRanges) {
+                ++local.skippedEpochs;
+                continue;
+            }
+
+            const double rangeStdDev = (varianceCount > 0)
+                ? std::sqrt(varianceSum / static_cast<double>(varianceCount))
+                : options.rangeNoiseStdDev;
+            const Eigen::Vector3d position =
+                runAlgorithm(options.algorithm, anchors, ranges, rangeStdDev, options.robustLossParam);
+            if (!position.allFinite()) {
+                ++local.failedSolves;
+                continue;
+            }
+            ++local.fixes;
+            if (onFix) {
+                onFix(TagFix{tagId, newestTimestamp, position, ranges.size()});
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(statsMutex);
+        stats.epochs += local.epochs;
+        stats.fixes += local.fixes;
+        stats.skippedEpochs += local.skippedEpochs;
+        stats.invalidAnchorRecords += local.invalidAnchorRecords;
+        stats.failedSolves += local.failedSolves;
+    };
+
+    const auto startedAt = std::chrono::steady_clock::now();
+    if (options.threadCount == 1) {
+        replayShare(0, records.size());
+    } else {
+        ThreadPool pool(options.threadCount);
+        pool.parallelFor(0, records.size(), replayShare);
+    }
+    stats.records = records.size();
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startedAt).count();
+    return stats;
+}
+
+}  // namespace TrueRangeMultilateration
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include "simulation_types.h"
+#include "tracker_service.h"
+
+namespace TrueRangeMultilateration {
+
+// Binary range log, little-endian, no padding:
+//   RangeLogHeader
+//   anchorCount x (x, y, z) doubles, in metres
+//   recordCount x RangeLogRecord
+// Both sections start on an 8-byte boundary, so a mapped file is read in place.
+inline constexpr char rangeLogMagic[8] = {'M', 'L', 'R', 'N', 'G', 'L', 'O', 'G'};
+inline constexpr uint32_t rangeLogVersion = 1;
+
+struct RangeLogHeader {
+    char magic[8] = {};
+    uint32_t version = 0;
+    uint32_t anchorCount = 0;
+    uint64_t recordCount = 0;
+};
+
+// RangeLogRecord::flags bit: rangeStdDev holds the range's standard deviation.
+inline constexpr uint16_t rangeLogHasStdDev = 1;
+
+struct RangeLogRecord {
+    // Measurement time in seconds
+    double timestamp = 0.0;
+    uint32_t tagId = 0;
+    // Index into the anchor table
+    uint16_t anchorIndex = 0;
+    uint16_t flags = 0;
+    float range = 0.0f;
+    float rangeStdDev = 0.0f;
+};
+
+static_assert(sizeof(RangeLogHeader) == 24 && sizeof(RangeLogRecord) == 24, "Range log structs are the on-disk layout");
+
+// Streams records to a new range log through a buffered file. The header's record
+// count is patched in by close(), which the destructor calls if needed.
+class RangeLogWriter {
+  public:
+    // Throws std::runtime_error if the file cannot be created and std::invalid_argument
+    // for more than 65535 anchors.
+    RangeLogWriter(const std::string& path, const std::vector<Eigen::Vector3d>& anchorPositions);
+    ~RangeLogWriter();
+
+    RangeLogWriter(const RangeLogWriter&) = delete;
+    RangeLogWriter& operator=(const RangeLogWriter&) = delete;
+
+    void write(const RangeLogRecord& record);
+    void write(std::span<const RangeLogRecord> records);
+    void close();
+
+    [[nodiscard]] uint64_t recordCount() const { return recordCount_; }
+
+  private:
+    std::ofstream file_;
+    uint64_t recordCount_ = 0;
+};
+
+// Read-only memory mapping of a range log. records() points into the mapping, so
+// nothing is copied and pages are read from disk as they are first touched.
+// Throws std::runtime_error if the file cannot be mapped or is not a complete
+// version 1 range log.
+class RangeLogReader {
+  public:
+    explicit RangeLogReader(const std::string& path);
+    ~RangeLogReader();
+
+    RangeLogReader(const RangeLogReader&) = delete;
+    RangeLogReader& operator=(const RangeLogReader&) = delete;
+
+    [[nodiscard]] const std::vector<Eigen::Vector3d>& anchorPositions() const { return anchorPositions_; }
+    [[nodiscard]] std::span<const RangeLogRecord> records() const { return records_; }
+    [[nodiscard]] size_t fileSize() const { return size_; }
+
+  private:
+    void unmap();
+
+    const std::byte* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    void* file_ = nullptr;
+    void* mapping_ = nullptr;
+#endif
+    std::vector<Eigen::Vector3d> anchorPositions_;
+    std::span<const RangeLogRecord> records_;
+};
+
+// End of the epoch starting at records[begin]. An epoch is a run of consecutive records
+// for one tag whose timestamps stay within epochDuration of its first record, so
+// writers must emit each tag's ranging round contiguously.
+size_t findRangeLogEpochEnd(std::span<const RangeLogRecord> records, size_t begin, double epochDuration);
+
+struct RangeLogReplayOptions {
+    AlgorithmId algorithm = AlgorithmId::NonLinearLeastSquaresAnalyticLm;
+    // Range standard deviation for records without one. Epochs whose records carry
+    // their own pass the root mean square of those to runAlgorithm.
+    double rangeNoiseStdDev = 0.1;
+    double robustLossParam = 5.0;
+    double epochDuration = 0.05;
+    // Epochs with fewer valid ranges are skipped.
+    size_t minRangesPerFix = 4;
+    // Threads replaying the log, including the caller; 0 selects the hardware concurrency.
+    size_t threadCount = 0;
+};
+
+struct RangeLogReplayStats {
+    uint64_t records = 0;
+    uint64_t epochs = 0;
+    uint64_t fixes = 0;
+    // Epochs with fewer than minRangesPerFix valid ranges
+    uint64_t skippedEpochs = 0;
+    // Records whose anchor index is outside the anchor table
+    uint64_t invalidAnchorRecords = 0;
+    // Solves that returned a non-finite position
+    uint64_t failedSolves = 0;
+    double seconds = 0.0;
+};
+
+// Called once per fix. With more than one thread it is called concurrently, and
+// fixes arrive in log order only within each thread's share of the log.
+using RangeLogFixCallback = std::function<void(const TagFix&)>;
+
+// Solves every epoch of the log with runAlgorithm. The log is split between threads
+// at tag changes, so epochs and fixes do not depend on the thread count.
+RangeLogReplayStats replayRangeLog(
+    const RangeLogReader& reader,
+    const RangeLogReplayOptions& options,
+    const RangeLogFixCallback& onFix = {}
+);
+
+}  // namespace TrueRangeMultilateration
@@ -0,0 +1,379 @@
+#include "result_sink.h"
+
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace TrueRangeMultilateration {
+
+namespace {
+
+constexpr char binaryResultMagic[8] = {'M', 'L', 'R', 'U', 'N', 'S', '0', '1'};
+
+// Bytes one encoded record can exceed the flush threshold by
+constexpr size_t maxRecordBytes = 1024;
+
+constexpr uint8_t binaryHasDiagnostics = 1;
+constexpr uint8_t binaryConverged = 2;
+
+uint64_t zigZag(const int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unZigZag(const uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+class CsvResultSink final : public ResultSink {
+  public:
+    template<typename Target>
+    CsvResultSink(Target& target, const size_t bufferBytes) : ResultSink(target, bufferBytes) {
+        append("scenario,algorithm,run,x,y,z,error_x,error_y,error_z,error_norm,"
+               "final_cost,iterations,outer_iterations,evaluations,rank,converged,setup_ns,factorization_ns,refinement_ns\n");
+    }
+
+  private:
+    void encode(const RunRecord& record) override {
+        appendNumber(uint64_t{record.scenarioIndex});
+        append(",");
+        appendNumber(static_cast<uint64_t>(record.algorithm));
+        append(",");
+        appendNumber(record.runIndex);
+        for (const double value : {record.result.position.x(), record.result.position.y(), record.result.position.z(),
+                                   record.error.x(), record.error.y(), record.error.z(), record.error.norm()}) {
+            append(",");
+            appendNumber(value);
+        }
+        if (!record.hasDiagnostics) {
+            // Diagnostics columns stay empty
+            append(",,,,,,,,,\n");
+            return;
+        }
+        const SolveResult& result = record.result;
+        append(",");
+        appendNumber(result.finalCost);
+        append(",");
+        appendNumber(uint64_t{result.iterations});
+        append(",");
+        appendNumber(uint64_t{result.outerIterations});
+        append(",");
+        appendNumber(uint64_t{result.functionEvaluations});
+        append(",");
+        appendNumber(int64_t{result.rank});
+        append(result.converged ? ",1," : ",0,");
+        appendNumber(result.timings.setupNs);
+        append(",");
+        appendNumber(result.timings.factorizationNs);
+        append(",");
+        appendNumber(result.timings.refinementNs);
+        append("\n");
+    }
+};
+
+class JsonLinesResultSink final : public ResultSink {
+  public:
+    template<typename Target>
+    JsonLinesResultSink(Target& target, const size_t bufferBytes) : ResultSink(target, bufferBytes) {}
+
+  private:
+    void appendVector(const Eigen::Vector3d& value) {
+        append("[");
+        appendNumber(value.x());
+        append(",");
+        appendNumber(value.y());
+        append(",");
+        appendNumber(value.z());
+        append("]");
+    }
+
+    void encode(const RunRecord& record) override {
+        append("{\"scenario\":");
+        appendNumber(uint64_t{record.scenarioIndex});
+        append(",\"algorithm\":");
+        appendNumber(static_cast<uint64_t>(record.algorithm));
+        append(",\"run\":");
+        appendNumber(record.runIndex);
+        append(",\"position\":");
+        appendVector(record.result.position);
+        append(",\"error\":");
+        appendVector(record.error);
+        append(",\"error_norm\":");
+        appendNumber(record.error.norm());
+        if (record.hasDiagnostics) {
+            const SolveResult& result = record.result;
+            append(",\"final_cost\":");
+            appendNumber(result.finalCost);
+            append(",\"iterations\":");
+            appendNumber(uint64_t{result.iterations});
+            append(",\"outer_iterations\":");
+            appendNumber(uint64_t{result.outerIterations});
+            append(",\"evaluations\":");
+            appendNumber(uint64_t{result.functionEvaluations});
+            append(",\"rank\":");
+            appendNumber(int64_t{result.rank});
+            append(result.converged ? ",\"converged\":true" : ",\"converged\":false");
+            append(",\"setup_ns\":");
+            appendNumber(result.timings.setupNs);
+            append(",\"factorization_ns\":");
+            appendNumber(result.timings.factorizationNs);
+            append(",\"refinement_ns\":");
+            appendNumber(result.timings.refinementNs);
+        }
+        append("}\n");
+    }
+};
+
+// Each double is XORed with the same field of the previous record; the result is stored
+// as one byte holding its leading and trailing zero-byte counts, then the bytes between.
+// Estimates of one scenario share sign, exponent and leading mantissa bits, so this
+// drops the bytes they have in common. Integers are LEB128 varints.
+class BinaryResultSink final : public ResultSink {
+  public:
+    template<typename Target>
+    BinaryResultSink(Target& target, const size_t bufferBytes) : ResultSink(target, bufferBytes) {
+        append(std::string_view(binaryResultMagic, sizeof(binaryResultMagic)));
+    }
+
+  private:
+    void appendByte(const uint8_t byte) {
+        buffer_.push_back(static_cast<char>(byte));
+    }
+
+    void appendVarint(uint64_t value) {
+        while (value >= 0x80) {
+            appendByte(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        appendByte(static_cast<uint8_t>(value));
+    }
+
+    void appendDouble(const double value, const double previous) {
+        const uint64_t bits = std::bit_cast<uint64_t>(value) ^ std::bit_cast<uint64_t>(previous);
+        const int leading = bits == 0 ? 8 : std::countl_zero(bits) / 8;
+        const int trailing = bits == 0 ? 0 : std::countr_zero(bits) / 8;
+        appendByte(static_cast<uint8_t>((leading << 4) | trailing));
+        for (int byte = trailing; byte < 8 - leading; ++byte) {
+            appendByte(static_cast<uint8_t>(bits >> (8 * byte)));
+        }
+    }
+
+    void encode(const RunRecord& record) override {
+        uint8_t flags = 0;
+        if (record.hasDiagnostics) {
+            flags |= binaryHasDiagnostics;
+        }
+        if (record.result.converged) {
+            flags |= binaryConverged;
+        }
+        appendByte(flags);
+        appendVarint(record.scenarioIndex);
+        appendVarint(static_cast<uint64_t>(record.algorithm));
+        appendVarint(zigZag(static_cast<int64_t>(record.runIndex - previous_.runIndex)));
+        for (int axis = 0; axis < 3; ++axis) {
+            appendDouble(record.result.position[axis], previous_.result.position[axis]);
+        }
+        for (int axis = 0; axis < 3; ++axis) {
+            appendDouble(record.error[axis], previous_.error[axis]);
+        }
+        if (record.hasDiagnostics) {
+            const SolveResult& result = record.result;
+            appendDouble(result.finalCost, previous_.result.finalCost);
+            appendVarint(result.iterations);
+            appendVarint(result.outerIterations);
+            appendVarint(result.functionEvaluations);
+            appendVarint(zigZag(result.rank));
+            appendVarint(zigZag(result.timings.setupNs));
+            appendVarint(zigZag(result.timings.factorizationNs));
+            appendVarint(zigZag(result.timings.refinementNs));
+            previous_ = record;
+        } else {
+            // Match what the reader reconstructs, so the next deltas agree
+            previous_ = RunRecord{};
+            previous_.runIndex = record.runIndex;
+            previous_.error = record.error;
+            previous_.result.position = record.result.position;
+        }
+    }
+
+    RunRecord previous_;
+};
+
+template<typename Target>
+std::unique_ptr<ResultSink> createResultSink(const ResultFormat format, Target& target, const size_t bufferBytes) {
+    switch (format) {
+        case ResultFormat::Csv:
+            return std::make_unique<CsvResultSink>(target, bufferBytes);
+        case ResultFormat::JsonLines:
+            return std::make_unique<JsonLinesResultSink>(target, bufferBytes);
+        case ResultFormat::Binary:
+            return std::make_unique<BinaryResultSink>(target, bufferBytes);
+    }
+    throw std::invalid_argument("Unknown ResultFormat.");
+}
+
+}  // namespace
+
+ResultSink::ResultSink(std::ostream& out, const size_t bufferBytes) : out_(&out), capacity_(bufferBytes) {
+    buffer_.reserve(capacity_ + maxRecordBytes);
+}
+
+ResultSink::ResultSink(const std::string& path, const size_t bufferBytes)
+    : file_(path, std::ios::binary | std::ios::trunc), out_(&file_), capacity_(bufferBytes) {
+    if (!file_) {
+        throw std::runtime_error("Cannot create result file " + path);
+    }
+    buffer_.reserve(capacity_ + maxRecordBytes);
+}
+
+ResultSink::~ResultSink() {
+    try {
+        flush();
+    } catch (...) {
+    }
+}
+
+void ResultSink::write(const RunRecord& record) {
+    encode(record);
+    ++recordCount_;
+    if (buffer_.size() >= capacity_) {
+        flush();
+    }
+}
+
+void ResultSink::flush() {
+    if (!buffer_.empty()) {
+        out_->write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        bytesFlushed_ += buffer_.size();
+        buffer_.clear();
+    }
+    out_->flush();
+    if (!*out_) {
+        throw std::runtime_error("Writing results failed.");
+    }
+}
+
+void ResultSink::append(const std::string_view text) {
+    buffer_.insert(buffer_.end(), text.begin(), text.end());
+}
+
+void ResultSink::appendNumber(const double value) {
+    // Shortest representation that reads back to the same double
+    std::array<char, 32> digits;
+    const auto end = std::to_chars(digits.data(), digits.data() + digits.size(), value).ptr;
+    buffer_.insert(buffer_.end(), digits.data(), end);
+}
+
+void ResultSink::appendNumber(const uint64_t value) {
+    std::array<char, 24> digits;
+    const auto end = std::to_chars(digits.data(), digits.data() + digits.size(), value).ptr;
+    buffer_.insert(buffer_.end(), digits.data(), end);
+}
+
+void ResultSink::appendNumber(const int64_t value) {
+    std::array<char, 24> digits;
+    const auto end = std::to_chars(digits.data(), digits.data() + digits.size(), value).ptr;
+    buffer_.insert(buffer_.end(), digits.data(), end);
+}
+
+std::unique_ptr<ResultSink> makeResultSink(const ResultFormat format, std::ostream& out, const size_t bufferBytes) {
+    return createResultSink(format, out, bufferBytes);
+}
+
+std::unique_ptr<ResultSink> openResultSink(const ResultFormat format, const std::string& path, const size_t bufferBytes) {
+    return createResultSink(format, path, bufferBytes);
+}
+
+ResultFormat resultFormatFromPath(const std::string& path) {
+    auto endsWith = [&path](const std::string_view suffix) {
+        return path.size() >= suffix.size() && path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0;
+    };
+    if (endsWith(".csv")) {
+        return ResultFormat::Csv;
+    }
+    if (endsWith(".jsonl") || endsWith(".ndjson")) {
+        return ResultFormat::JsonLines;
+    }
+    if (endsWith(".bin")) {
+        return ResultFormat::Binary;
+    }
+    throw std::invalid_argument("Result files must end in .csv, .jsonl, .ndjson or .bin: " + path);
+}
+
+BinaryResultReader::BinaryResultReader(std::istream& in) : in_(in) {
+    char magic[sizeof(binaryResultMagic)] = {};
+    if (!in_.read(magic, sizeof(magic)) || std::memcmp(magic, binaryResultMagic, sizeof(magic)) != 0) {
+        throw std::runtime_error("Not a binary result stream.");
+    }
+}
+
+bool BinaryResultReader::next(RunRecord& record) {
+    auto readByte = [this]() {
+        const int byte = in_.get();
+        if (byte == std::char_traits<char>::eof()) {
+            throw std::runtime_error("Truncated binary result record.");
+        }
+        return static_cast<uint8_t>(byte);
+    };
+    auto readVarint = [&]() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            const uint8_t byte = readByte();
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        throw std::runtime_error("Malformed varint in binary result record.");
+    };
+    auto readDouble = [&](const double previous) {
+        const uint8_t sizes = readByte();
+        const int leading = sizes >> 4;
+        const int trailing = sizes & 0x0f;
+        if (leading + trailing > 8) {
+            throw std::runtime_error("Malformed double in binary result record.");
+        }
+        uint64_t bits = 0;
+        for (int byte = trailing; byte < 8 - leading; ++byte) {
+            bits |= static_cast<uint64_t>(readByte()) << (8 * byte);
+        }
+        return std::bit_cast<double>(bits ^ std::bit_cast<uint64_t>(previous));
+    };
+
+    const int flags = in_.get();
+    if (flags == std::char_traits<char>::eof()) {
+        return false;
+    }
+
+    RunRecord decoded;
+    decoded.hasDiagnostics = (flags & binaryHasDiagnostics) != 0;
+    decoded.result.converged = (flags & binaryConverged) != 0;
+    decoded.scenarioIndex = static_cast<uint32_t>(readVarint());
+    decoded.algorithm = static_cast<AlgorithmId>(readVarint());
+    decoded.runIndex = previous_.runIndex + static_cast<uint64_t>(unZigZag(readVarint()));
+    for (int axis = 0; axis < 3; ++axis) {
+        decoded.result.position[axis] = readDouble(previous_.result.position[axis]);
+    }
+    for (int axis = 0; axis < 3; ++axis) {
+        decoded.error[axis] = readDouble(previous_.error[axis]);
+    }
+    if (decoded.hasDiagnostics) {
+        SolveResult& result = decoded.result;
+        result.finalCost = readDouble(previous_.result.finalCost);
+        result.iterations = static_cast<size_t>(readVarint());
+        result.outerIterations = static_cast<size_t>(readVarint());
+        result.functionEvaluations = static_cast<size_t>(readVarint());
+        result.rank = static_cast<int>(unZigZag(readVarint()));
+        result.timings.setupNs = unZigZag(readVarint());
+        result.timings.factorizationNs = unZigZag(readVarint());
+        result.timings.refinementNs = unZigZag(readVarint());
+    }
+
+    previous_ = decoded;
+    record = decoded;
+    return true;
+}
+
+}  // namespace TrueRangeMultilateration
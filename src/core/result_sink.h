@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include "simulation_types.h"
+
+namespace TrueRangeMultilateration {
+
+// One Monte Carlo run as written by a ResultSink.
+struct RunRecord {
+    // Caller-defined scenario index, for sinks shared by several scenarios
+    uint32_t scenarioIndex = 0;
+    AlgorithmId algorithm = AlgorithmId::OrdinaryLeastSquaresWikipedia;
+    uint64_t runIndex = 0;
+    // estimate - truePosition
+    Eigen::Vector3d error = Eigen::Vector3d::Zero();
+    // Only the position is meaningful unless hasDiagnostics is set.
+    SolveResult result;
+    bool hasDiagnostics = false;
+};
+
+enum class ResultFormat {
+    Csv = 0,
+    JsonLines,
+    // XOR-delta coded doubles and varint integers; read back with BinaryResultReader
+    Binary,
+};
+
+// Streams per-run records to an output stream through a fixed-size buffer, so memory
+// stays bounded however many runs are written. Records reach the stream when the
+// buffer fills, on flush(), and on destruction. Not thread-safe: write from one
+// thread, in the order the records should appear.
+class ResultSink {
+  public:
+    virtual ~ResultSink();
+
+    ResultSink(const ResultSink&) = delete;
+    ResultSink& operator=(const ResultSink&) = delete;
+
+    void write(const RunRecord& record);
+    void flush();
+
+    [[nodiscard]] uint64_t recordCount() const { return recordCount_; }
+    // Bytes handed to the stream or still buffered
+    [[nodiscard]] uint64_t bytesWritten() const { return bytesFlushed_ + buffer_.size(); }
+
+  protected:
+    ResultSink(std::ostream& out, size_t bufferBytes);
+    ResultSink(const std::string& path, size_t bufferBytes);
+
+    // Appends one encoded record to buffer_.
+    virtual void encode(const RunRecord& record) = 0;
+    void append(std::string_view text);
+    void appendNumber(double value);
+    void appendNumber(uint64_t value);
+    void appendNumber(int64_t value);
+
+    std::vector<char> buffer_;
+
+  private:
+    std::ofstream file_;
+    std::ostream* out_ = nullptr;
+    size_t capacity_ = 0;
+    uint64_t recordCount_ = 0;
+    uint64_t bytesFlushed_ = 0;
+};
+
+// bufferBytes is the flush threshold; one record is at most a few hundred bytes beyond it.
+inline constexpr size_t defaultResultSinkBufferBytes = size_t{1} << 20;
+
+std::unique_ptr<ResultSink> makeResultSink(
+    ResultFormat format,
+    std::ostream& out,
+    size_t bufferBytes = defaultResultSinkBufferBytes
+);
+
+// Throws std::runtime_error if the file cannot be created.
+std::unique_ptr<ResultSink> openResultSink(
+    ResultFormat format,
+    const std::string& path,
+    size_t bufferBytes = defaultResultSinkBufferBytes
+);
+
+// .csv, .jsonl/.ndjson or .bin; throws std::invalid_argument for anything else.
+ResultFormat resultFormatFromPath(const std::string& path);
+
+// Decodes a ResultFormat::Binary stream record by record.
+class BinaryResultReader {
+  public:
+    // Throws std::runtime_error if the stream does not start with the binary result header.
+    explicit BinaryResultReader(std::istream& in);
+
+    // False at the end of the stream; throws std::runtime_error on a truncated record.
+    bool next(RunRecord& record);
+
+  private:
+    std::istream& in_;
+    RunRecord previous_;
+};
+
+}  // namespace TrueRangeMultilateration
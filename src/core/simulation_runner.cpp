@@ -1,5 +1,8 @@
 #include "simulation_runner.h"
 
+#include <algorithm>
+#include <thread>
+
 #include "algorithm_dispatch.h"
 #include "../test_helpers.h"
 
@@ -11,13 +14,47 @@ void SimulationRunner::begin(const TestParameters& params) {
     currentRun_ = 0;
     errorMessage_.clear();
     estimatedPositions_.clear();
-    estimatedPositions_.reserve(params_.numRuns);
+    if (params_.keepEstimates) {
+        estimatedPositions_.reserve(params_.numRuns);
+    }
+    stepEstimates_.clear();
+    stepDiagnostics_.clear();
+    statistics_ = ErrorStatisticsAccumulator(params_.truePosition);
+    solveDiagnostics_.reset();
     results_ = TestResults{};
     rng_ = makeRandomEngine(params_.randomSeed);
+    if (params_.executionMode == ExecutionMode::Parallel) {
+        runSeed_ = params_.randomSeed.value_or(std::random_device{}());
+        const size_t threadCount = (params_.numThreads == 0)
+            ? std::max<size_t>(1, std::thread::hardware_concurrency())
+            : params_.numThreads;
+        if (!pool_ || pool_->threadCount() != threadCount) {
+            pool_ = std::make_unique<ThreadPool>(threadCount);
+        }
+    }
     startedAt_ = std::chrono::steady_clock::now();
     endedAt_ = startedAt_;
 }
 
+void SimulationRunner::setResultSink(ResultSink* const sink, const uint32_t scenarioIndex) {
+    if (resultSink_ != nullptr && resultSink_ != sink) {
+        resultSink_->flush();
+    }
+    resultSink_ = sink;
+    scenarioIndex_ = scenarioIndex;
+}
+
+void SimulationRunner::writeRecord(const size_t run, const SolveResult& trial) {
+    RunRecord record;
+    record.scenarioIndex = scenarioIndex_;
+    record.algorithm = params_.algorithm;
+    record.runIndex = run;
+    record.error = trial.position - params_.truePosition;
+    record.result = trial;
+    record.hasDiagnostics = params_.collectSolveDiagnostics;
+    resultSink_->write(record);
+}
+
 void SimulationRunner::step(const size_t maxIterationsPerFrame) {
     if (status_ != Status::Running) {
         return;
@@ -25,28 +62,64 @@ void SimulationRunner::step(const size_t maxIterationsPerFrame) {
 
     try {
         const size_t end = std::min(params_.numRuns, currentRun_ + maxIterationsPerFrame);
-        for (; currentRun_ < end; ++currentRun_) {
-            const auto noisyRanges = generateNoisyRanges(
-                params_.truePosition,
-                params_.anchorPositions,
-                params_.rangeNoiseStdDev,
-                params_.rangeOutlierRatio,
-                params_.rangeOutlierMagnitude,
-                rng_);
-
-            std::vector<Eigen::Vector3d> estimatedAnchorPositions = params_.anchorPositions;
-            if (params_.anchorPosNoiseStdDev > 0.0) {
-                estimatedAnchorPositions = generateNoisyAnchorPositions(
-                    params_.anchorPositions,
-                    params_.anchorPosNoiseStdDev,
-                    rng_);
+        if (params_.executionMode == ExecutionMode::Parallel) {
+            // Estimates land at their run index; statistics are then accumulated in run
+            // order so they too are independent of the thread count.
+            const size_t stepBegin = currentRun_;
+            Eigen::Vector3d* estimates = nullptr;
+            if (params_.keepEstimates) {
+                estimatedPositions_.resize(end);
+                estimates = estimatedPositions_.data() + stepBegin;
+            } else {
+                stepEstimates_.resize(end - stepBegin);
+                estimates = stepEstimates_.data();
             }
+            SolveResult* diagnostics = nullptr;
+            if (params_.collectSolveDiagnostics) {
+                stepDiagnostics_.resize(end - stepBegin);
+                diagnostics = stepDiagnostics_.data();
+            }
+
+            pool_->parallelFor(stepBegin, end, [this, estimates, diagnostics, stepBegin](const size_t chunkBegin, const size_t chunkEnd) {
+                for (size_t run = chunkBegin; run < chunkEnd; ++run) {
+                    std::mt19937_64 runRng = makeRunRandomEngine(runSeed_, run);
+                    const SolveResult trial = runTrial(runRng);
+                    estimates[run - stepBegin] = trial.position;
+                    if (diagnostics != nullptr) {
+                        diagnostics[run - stepBegin] = trial;
+                    }
+                }
+            });
 
-            estimatedPositions_.push_back(runAlgorithm(
-                params_.algorithm,
-                estimatedAnchorPositions,
-                noisyRanges,
-                params_.rangeNoiseStdDev));
+            for (size_t i = 0; i < end - stepBegin; ++i) {
+                statistics_.add(estimates[i]);
+                if (diagnostics != nullptr) {
+                    solveDiagnostics_.add(diagnostics[i]);
+                }
+                if (resultSink_ != nullptr) {
+                    SolveResult trial;
+                    if (diagnostics != nullptr) {
+                        trial = diagnostics[i];
+                    }
+                    trial.position = estimates[i];
+                    writeRecord(stepBegin + i, trial);
+                }
+            }
+            currentRun_ = end;
+        } else {
+            for (; currentRun_ < end; ++currentRun_) {
+                const SolveResult trial = runTrial(rng_);
+                statistics_.add(trial.position);
+                if (params_.collectSolveDiagnostics) {
+                    solveDiagnostics_.add(trial);
+                }
+                if (params_.keepEstimates) {
+                    estimatedPositions_.push_back(trial.position);
+                }
+                if (resultSink_ != nullptr) {
+                    writeRecord(currentRun_, trial);
+                }
+            }
         }
 
         if (currentRun_ >= params_.numRuns) {
@@ -58,14 +131,53 @@ void SimulationRunner::step(const size_t maxIterationsPerFrame) {
     }
 }
 
+SolveResult SimulationRunner::runTrial(std::mt19937_64& rng) const {
+    const auto noisyRanges = generateNoisyRanges(
+        params_.truePosition,
+        params_.anchorPositions,
+        params_.rangeNoiseStdDev,
+        params_.rangeOutlierRatio,
+        params_.rangeOutlierMagnitude,
+        rng);
+
+    std::vector<Eigen::Vector3d> estimatedAnchorPositions = params_.anchorPositions;
+    if (params_.anchorPosNoiseStdDev > 0.0) {
+        estimatedAnchorPositions = generateNoisyAnchorPositions(
+            params_.anchorPositions,
+            params_.anchorPosNoiseStdDev,
+            rng);
+    }
+
+    if (params_.collectSolveDiagnostics) {
+        return runAlgorithmWithDiagnostics(
+            params_.algorithm,
+            estimatedAnchorPositions,
+            noisyRanges,
+            params_.rangeNoiseStdDev);
+    }
+
+    SolveResult result;
+    result.position = runAlgorithm(
+        params_.algorithm,
+        estimatedAnchorPositions,
+        noisyRanges,
+        params_.rangeNoiseStdDev);
+    return result;
+}
+
 void SimulationRunner::finalize() {
-    if (estimatedPositions_.empty()) {
+    if (statistics_.count() == 0) {
         status_ = Status::Error;
         errorMessage_ = "No estimates produced";
         return;
     }
 
-    results_ = computeResults(estimatedPositions_, params_);
+    results_ = statistics_.results();
+    if (resultSink_ != nullptr) {
+        resultSink_->flush();
+    }
+    stepEstimates_ = std::vector<Eigen::Vector3d>{};
+    stepDiagnostics_ = std::vector<SolveResult>{};
     status_ = Status::Completed;
     endedAt_ = std::chrono::steady_clock::now();
 }
@@ -74,6 +186,10 @@ void SimulationRunner::cancel() {
     status_ = Status::Idle;
     currentRun_ = 0;
     estimatedPositions_.clear();
+    stepEstimates_ = std::vector<Eigen::Vector3d>{};
+    stepDiagnostics_ = std::vector<SolveResult>{};
+    statistics_.reset();
+    solveDiagnostics_.reset();
     errorMessage_.clear();
 }
 
@@ -1,12 +1,17 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
+#include <memory>
 #include <random>
 #include <vector>
 
 #include <Eigen/Dense>
 
+#include "error_statistics.h"
+#include "result_sink.h"
 #include "simulation_types.h"
+#include "thread_pool.h"
 
 namespace TrueRangeMultilateration {
 
@@ -15,6 +20,12 @@ class SimulationRunner {
     enum class Status { Idle, Running, Completed, Error };
 
     void begin(const TestParameters& params);
+    // Streams every later run to sink as a RunRecord tagged with scenarioIndex, in run
+    // order, and flushes the sink it replaces. The sink must outlive the runs; nullptr
+    // stops streaming.
+    void setResultSink(ResultSink* sink, uint32_t scenarioIndex = 0);
+    // Executes up to maxIterationsPerFrame further runs. In ExecutionMode::Parallel
+    // they are split across the thread pool; estimates keep run order either way.
     void step(size_t maxIterationsPerFrame);
     void finalize();
     void cancel();
@@ -24,16 +35,35 @@ class SimulationRunner {
     [[nodiscard]] size_t totalRuns() const { return params_.numRuns; }
     [[nodiscard]] double progress() const;
     [[nodiscard]] const TestResults& results() const { return results_; }
+    // Empty when TestParameters::keepEstimates is false.
     [[nodiscard]] const std::vector<Eigen::Vector3d>& estimatedPositions() const { return estimatedPositions_; }
+    [[nodiscard]] const ErrorStatisticsAccumulator& statistics() const { return statistics_; }
+    // Empty unless TestParameters::collectSolveDiagnostics is set.
+    [[nodiscard]] const SolveDiagnosticsAccumulator& solveDiagnostics() const { return solveDiagnostics_; }
     [[nodiscard]] double elapsedMs() const;
     [[nodiscard]] const std::string& errorMessage() const { return errorMessage_; }
 
   private:
+    // Only the position is filled unless TestParameters::collectSolveDiagnostics is set.
+    SolveResult runTrial(std::mt19937_64& rng) const;
+    void writeRecord(size_t run, const SolveResult& trial);
+
     TestParameters params_{};
     Status status_ = Status::Idle;
     size_t currentRun_ = 0;
     std::mt19937_64 rng_;
+    // Seed the per-run streams of ExecutionMode::Parallel are derived from.
+    uint64_t runSeed_ = 0;
+    std::unique_ptr<ThreadPool> pool_;
+    ResultSink* resultSink_ = nullptr;
+    uint32_t scenarioIndex_ = 0;
     std::vector<Eigen::Vector3d> estimatedPositions_;
+    // Estimates of the current parallel step when estimatedPositions_ is not kept.
+    std::vector<Eigen::Vector3d> stepEstimates_;
+    // Diagnostics of the current parallel step, accumulated in run order after it completes.
+    std::vector<SolveResult> stepDiagnostics_;
+    ErrorStatisticsAccumulator statistics_;
+    SolveDiagnosticsAccumulator solveDiagnostics_;
     TestResults results_{};
     std::chrono::steady_clock::time_point startedAt_{};
     std::chrono::steady_clock::time_point endedAt_{};
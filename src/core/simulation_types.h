@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <string>
@@ -17,8 +18,22 @@ enum class AlgorithmId {
     LinearLeastSquaresIYueWang,
     LinearLeastSquaresII2YueWang,
     TwoStepWeightedLinearLeastSquaresIYueWang,
+    NonLinearLeastSquaresAnalyticLm,
+    RobustNonLinearLeastSquaresAnalyticLm,
 };
 
+// Number of AlgorithmId values; update when appending an algorithm.
+inline constexpr size_t algorithmCount =
+    static_cast<size_t>(AlgorithmId::RobustNonLinearLeastSquaresAnalyticLm) + 1;
+
+// How SimulationRunner executes Monte Carlo runs.
+enum class ExecutionMode {
+    // One random stream consumed run after run on the calling thread (legacy sequence).
+    Serial = 0,
+    // Runs spread over a thread pool, each with its own stream derived from (randomSeed, runIndex).
+    // Results are bit-identical for any thread count but differ from Serial.
+    Parallel,
+};
 
 struct CrlbResult {
     Eigen::Matrix3d crlb = Eigen::Matrix3d::Zero();
@@ -44,6 +59,60 @@ struct TestParameters {
     std::optional<uint64_t> randomSeed = std::nullopt;
     size_t numRuns = 1;
     AlgorithmId algorithm = AlgorithmId::OrdinaryLeastSquaresWikipedia;
+    ExecutionMode executionMode = ExecutionMode::Serial;
+    // Worker threads for ExecutionMode::Parallel; 0 selects the hardware concurrency.
+    size_t numThreads = 0;
+    // Retain every estimate for SimulationRunner::estimatedPositions(). When false,
+    // statistics are accumulated online and memory no longer grows with numRuns.
+    bool keepEstimates = true;
+    // Solve through runAlgorithmWithDiagnostics and aggregate SolveResult diagnostics per run
+    // (SimulationRunner::solveDiagnostics()). Adds a few clock reads to every solve.
+    bool collectSolveDiagnostics = false;
+};
+
+// Wall time spent in the internal stages of one solve, in nanoseconds. Stages a solver
+// does not have stay zero; the nonlinear solvers include their linear initial guess.
+struct SolveStageTimings {
+    // Forming the linear system (design matrix and right-hand side)
+    int64_t setupNs = 0;
+    // Decomposing it (SVD, or the normal-matrix inverse)
+    int64_t factorizationNs = 0;
+    // Back-substitution, the TS-WLLS-I second step and nonlinear iterations
+    int64_t refinementNs = 0;
+};
+
+// Estimate and diagnostics of one solve (see runAlgorithmWithDiagnostics).
+struct SolveResult {
+    Eigen::Vector3d position = Eigen::Vector3d::Zero();
+    // 0.5 * sum_i (|x - p_i| - d_i)^2 at position, unweighted so algorithms compare directly
+    double finalCost = 0.0;
+    // Levenberg-Marquardt iterations, summed over IRLS passes; 0 for closed-form solvers
+    size_t iterations = 0;
+    // IRLS reweighting passes; 0 for non-robust solvers
+    size_t outerIterations = 0;
+    // Residual sweeps over the anchors, including finite-difference and reweighting sweeps
+    size_t functionEvaluations = 0;
+    // Numerical rank of the SVD-factored design matrix; -1 when no SVD was computed
+    int rank = -1;
+    // False when an iterative solver stopped on its iteration or evaluation limit
+    bool converged = true;
+    SolveStageTimings timings;
+};
+
+// Per-run means of SolveResult diagnostics over a simulation.
+struct SolveDiagnosticsSummary {
+    size_t count = 0;
+    double meanFinalCost = 0.0;
+    double meanIterations = 0.0;
+    size_t maxIterations = 0;
+    double meanOuterIterations = 0.0;
+    double meanFunctionEvaluations = 0.0;
+    size_t nonConvergedCount = 0;
+    // Smallest rank any run reported; -1 when no run computed an SVD
+    int minRank = -1;
+    double meanSetupNs = 0.0;
+    double meanFactorizationNs = 0.0;
+    double meanRefinementNs = 0.0;
 };
 
 struct TestResults {
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include "simulation_types.h"
+
+namespace TrueRangeMultilateration {
+
+// Adds the time since the previous lap to one SolveStageTimings field of a solve's diagnostics.
+// Does nothing, and reads no clock, when diagnostics is null.
+class StageTimer {
+  public:
+    explicit StageTimer(SolveResult* diagnostics) : diagnostics_(diagnostics) {
+        if (diagnostics_ != nullptr) {
+            last_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    void lap(int64_t SolveStageTimings::* stage) {
+        if (diagnostics_ == nullptr) {
+            return;
+        }
+        const auto now = std::chrono::steady_clock::now();
+        diagnostics_->timings.*stage += std::chrono::duration_cast<std::chrono::nanoseconds>(now - last_).count();
+        last_ = now;
+    }
+
+  private:
+    SolveResult* diagnostics_;
+    std::chrono::steady_clock::time_point last_{};
+};
+
+}  // namespace TrueRangeMultilateration
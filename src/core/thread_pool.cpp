@@ -0,0 +1,104 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <exception>
+
+namespace TrueRangeMultilateration {
+
+ThreadPool::ThreadPool(const size_t threadCount) {
+    size_t count = threadCount;
+    if (count == 0) {
+        count = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    workers_.reserve(count - 1);
+    for (size_t i = 1; i < count; ++i) {
+        workers_.emplace_back([this] { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    taskAvailable_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::workerLoop() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            taskAvailable_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+            if (stopping_ && tasks_.empty()) {
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
+
+void ThreadPool::parallelFor(
+    const size_t begin,
+    const size_t end,
+    const std::function<void(size_t, size_t)>& body) {
+    if (end <= begin) {
+        return;
+    }
+
+    const size_t count = end - begin;
+    // A few chunks per thread so uneven per-item cost still balances.
+    const size_t chunkCount = std::min(count, threadCount() * 4);
+    if (chunkCount <= 1 || workers_.empty()) {
+        body(begin, end);
+        return;
+    }
+
+    std::mutex doneMutex;
+    std::condition_variable allDone;
+    size_t remaining = chunkCount;
+    std::exception_ptr firstError;
+
+    auto runChunk = [&](const size_t chunk) {
+        const size_t chunkBegin = begin + count * chunk / chunkCount;
+        const size_t chunkEnd = begin + count * (chunk + 1) / chunkCount;
+        std::exception_ptr error;
+        try {
+            body(chunkBegin, chunkEnd);
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        std::lock_guard<std::mutex> lock(doneMutex);
+        if (error && !firstError) {
+            firstError = error;
+        }
+        if (--remaining == 0) {
+            allDone.notify_one();
+        }
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t chunk = 1; chunk < chunkCount; ++chunk) {
+            tasks_.emplace_back([&runChunk, chunk] { runChunk(chunk); });
+        }
+    }
+    taskAvailable_.notify_all();
+
+    runChunk(0);
+
+    std::unique_lock<std::mutex> lock(doneMutex);
+    allDone.wait(lock, [&] { return remaining == 0; });
+    if (firstError) {
+        std::rethrow_exception(firstError);
+    }
+}
+
+}  // namespace TrueRangeMultilateration
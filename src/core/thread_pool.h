@@ -0,0 +1,44 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace TrueRangeMultilateration {
+
+// Fixed-size pool of worker threads for data-parallel loops. A pool with one
+// thread runs everything on the caller, so single-threaded and Emscripten
+// builds never spawn a thread.
+class ThreadPool {
+  public:
+    // threadCount == 0 selects std::thread::hardware_concurrency().
+    explicit ThreadPool(size_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Threads that execute parallelFor chunks, including the calling thread.
+    [[nodiscard]] size_t threadCount() const { return workers_.size() + 1; }
+
+    // Calls body(chunkBegin, chunkEnd) on disjoint chunks covering [begin, end)
+    // and returns once every chunk has finished. The calling thread executes
+    // chunks too. The first exception thrown by body is rethrown here after
+    // the remaining chunks have completed.
+    void parallelFor(size_t begin, size_t end, const std::function<void(size_t, size_t)>& body);
+
+  private:
+    void workerLoop();
+
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable taskAvailable_;
+    bool stopping_ = false;
+};
+
+}  // namespace TrueRangeMultilateration
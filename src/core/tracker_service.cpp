@@ -0,0 +1,169 @@
+#include "tracker_service.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "algorithm_dispatch.h"
+
+namespace TrueRangeMultilateration {
+
+struct TrackerService::Shard {
+    explicit Shard(const size_t queueCapacity) : queue(queueCapacity) {}
+
+    BoundedMpscQueue<RangeMeasurement> queue;
+    std::unordered_map<uint32_t, TagState> tags;
+    // Tags solved in the current process() call; the pointers stay valid because
+    // the map is not modified while solve tasks run.
+    std::vector<std::pair<uint32_t, TagState*>> ready;
+    uint64_t droppedInvalidAnchor = 0;
+    uint64_t droppedStale = 0;
+    std::atomic<uint64_t> fixes{0};
+    std::atomic<uint64_t> failedSolves{0};
+};
+
+TrackerService::TrackerService(TrackerServiceOptions options)
+    : options_(std::move(options)), pool_(options_.threadCount) {
+    if (options_.shardCount == 0) {
+        throw std::invalid_argument("TrackerService needs at least one shard.");
+    }
+    options_.tagsPerSolveTask = std::max<size_t>(1, options_.tagsPerSolveTask);
+
+    shards_.reserve(options_.shardCount);
+    for (size_t i = 0; i < options_.shardCount; ++i) {
+        shards_.push_back(std::make_unique<Shard>(options_.queueCapacity));
+    }
+}
+
+TrackerService::~TrackerService() = default;
+
+bool TrackerService::ingest(const RangeMeasurement& measurement) {
+    Shard& shard = *shards_[measurement.tagId % shards_.size()];
+    if (!shard.queue.tryPush(measurement)) {
+        droppedQueueFull_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    ingested_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+size_t TrackerService::process() {
+    fixesThisCall_.store(0);
+    for (const std::unique_ptr<Shard>& shard : shards_) {
+        pool_.submit([this, &shard = *shard] { drainShard(shard); });
+    }
+    pool_.wait();
+    return fixesThisCall_.load();
+}
+
+void TrackerService::drainShard(Shard& shard) {
+    const size_t anchorCount = options_.anchorPositions.size();
+    shard.ready.clear();
+
+    RangeMeasurement measurement;
+    while (shard.queue.tryPop(measurement)) {
+        if (measurement.anchorIndex >= anchorCount) {
+            ++shard.droppedInvalidAnchor;
+            continue;
+        }
+
+        TagState& tag = shard.tags[measurement.tagId];
+        auto held = std::find_if(tag.ranges.begin(), tag.ranges.end(), [&](const HeldRange& range) {
+            return range.anchorIndex == measurement.anchorIndex;
+        });
+        if (held == tag.ranges.end()) {
+            tag.ranges.push_back({measurement.anchorIndex, measurement.timestamp, measurement.range});
+        } else if (measurement.timestamp >= held->timestamp) {
+            *held = {measurement.anchorIndex, measurement.timestamp, measurement.range};
+        } else {
+            ++shard.droppedStale;
+            continue;
+        }
+
+        tag.newestTimestamp = std::max(tag.newestTimestamp, measurement.timestamp);
+        if (!tag.pending) {
+            tag.pending = true;
+            shard.ready.emplace_back(measurement.tagId, &tag);
+        }
+    }
+
+    // Drop ranges that fell out of the window and keep the tags that can be solved
+    const size_t minRanges = std::max<size_t>(1, options_.minRangesPerFix);
+    size_t readyCount = 0;
+    for (const auto& [tagId, tag] : shard.ready) {
+        const double oldest = tag->newestTimestamp - options_.rangeWindow;
+        std::erase_if(tag->ranges, [oldest](const HeldRange& range) { return range.timestamp < oldest; });
+        tag->pending = false;
+        if (tag->ranges.size() >= minRanges) {
+            shard.ready[readyCount++] = {tagId, tag};
+        }
+    }
+    shard.ready.resize(readyCount);
+
+    // The first chunk runs here; the rest wait on this thread's deque for thieves
+    const size_t chunk = options_.tagsPerSolveTask;
+    for (size_t begin = chunk; begin < readyCount; begin += chunk) {
+        pool_.submit([this, &shard, begin, end = std::min(readyCount, begin + chunk)] {
+            solveTags(shard, begin, end);
+        });
+    }
+    solveTags(shard, 0, std::min(readyCount, chunk));
+}
+
+void TrackerService::solveTags(Shard& shard, const size_t begin, const size_t end) {
+    std::vector<Eigen::Vector3d> anchors;
+    std::vector<double> ranges;
+    size_t fixes = 0;
+    for (size_t i = begin; i < end; ++i) {
+        const auto [tagId, tag] = shard.ready[i];
+        anchors.clear();
+        ranges.clear();
+        for (const HeldRange& held : tag->ranges) {
+            anchors.push_back(options_.anchorPositions[held.anchorIndex]);
+            ranges.push_back(held.range);
+        }
+
+        const Eigen::Vector3d position = runAlgorithm(
+            options_.algorithm, anchors, ranges, options_.rangeNoiseStdDev, options_.robustLossParam);
+        if (!position.allFinite()) {
+            shard.failedSolves.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        tag->fix = TagFix{tagId, tag->newestTimestamp, position, ranges.size()};
+        ++fixes;
+    }
+    shard.fixes.fetch_add(fixes, std::memory_order_relaxed);
+    fixesThisCall_.fetch_add(fixes, std::memory_order_relaxed);
+}
+
+std::optional<TagFix> TrackerService::latestFix(const uint32_t tagId) const {
+    const Shard& shard = *shards_[tagId % shards_.size()];
+    const auto it = shard.tags.find(tagId);
+    if (it == shard.tags.end()) {
+        return std::nullopt;
+    }
+    return it->second.fix;
+}
+
+size_t TrackerService::tagCount() const {
+    size_t count = 0;
+    for (const std::unique_ptr<Shard>& shard : shards_) {
+        count += shard->tags.size();
+    }
+    return count;
+}
+
+TrackerServiceStats TrackerService::stats() const {
+    TrackerServiceStats stats;
+    stats.ingested = ingested_.load(std::memory_order_relaxed);
+    stats.droppedQueueFull = droppedQueueFull_.load(std::memory_order_relaxed);
+    for (const std::unique_ptr<Shard>& shard : shards_) {
+        stats.droppedInvalidAnchor += shard->droppedInvalidAnchor;
+        stats.droppedStale += shard->droppedStale;
+        stats.fixes += shard->fixes.load(std::memory_order_relaxed);
+        stats.failedSolves += shard->failedSolves.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+}  // namespace TrueRangeMultilateration
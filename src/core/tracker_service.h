@@ -0,0 +1,124 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include "mpsc_queue.h"
+#include "simulation_types.h"
+#include "work_stealing_pool.h"
+
+namespace TrueRangeMultilateration {
+
+// One range reported by an anchor gateway. anchorIndex refers to
+// TrackerServiceOptions::anchorPositions; timestamp is the measurement time in seconds.
+struct RangeMeasurement {
+    uint32_t tagId = 0;
+    uint32_t anchorIndex = 0;
+    double timestamp = 0.0;
+    double range = 0.0;
+};
+
+struct TrackerServiceOptions {
+    std::vector<Eigen::Vector3d> anchorPositions = {};
+    AlgorithmId algorithm = AlgorithmId::NonLinearLeastSquaresAnalyticLm;
+    double rangeNoiseStdDev = 0.1;
+    double robustLossParam = 5.0;
+    // Tags are assigned to shards by tagId % shardCount; each shard has its own ingest queue.
+    size_t shardCount = 64;
+    // Threads of the work-stealing pool, including the caller of process(); 0 selects the hardware concurrency.
+    size_t threadCount = 0;
+    // Ranges each shard queue holds between process() calls (rounded up to a power of two).
+    size_t queueCapacity = size_t{1} << 14;
+    // A tag is solved once it holds this many ranges inside the window and has a range newer than its last fix.
+    size_t minRangesPerFix = 4;
+    // Ranges older than the tag's newest range by more than this (s) are not used.
+    double rangeWindow = 0.1;
+    // Ready tags per solve task; smaller tasks balance better across threads.
+    size_t tagsPerSolveTask = 32;
+};
+
+struct TagFix {
+    uint32_t tagId = 0;
+    // Timestamp of the newest range used.
+    double timestamp = 0.0;
+    Eigen::Vector3d position = Eigen::Vector3d::Zero();
+    size_t rangeCount = 0;
+};
+
+struct TrackerServiceStats {
+    uint64_t ingested = 0;
+    // Rejected by ingest() because the shard queue was full.
+    uint64_t droppedQueueFull = 0;
+    // Anchor index outside the anchor set.
+    uint64_t droppedInvalidAnchor = 0;
+    // Older than the range already held from the same anchor for the tag (late out-of-order delivery).
+    uint64_t droppedStale = 0;
+    uint64_t fixes = 0;
+    // Solves that returned a non-finite position; the previous fix is kept.
+    uint64_t failedSolves = 0;
+};
+
+// Tracks many tags at once from ranges that arrive out of order from many gateways.
+// ingest() may be called from any number of threads at any time; it pushes onto the
+// lock-free queue of the tag's shard and never blocks. process() drains every shard
+// on a WorkStealingPool, one task per shard, and each shard task submits solve tasks
+// for its ready tags, so idle threads steal solves from busy shards. A tag's state is
+// only touched by its shard's task or by solve tasks of that shard in the same call,
+// so per-tag state needs no locks. Solves go through runAlgorithm.
+class TrackerService {
+  public:
+    explicit TrackerService(TrackerServiceOptions options);
+    ~TrackerService();
+
+    TrackerService(const TrackerService&) = delete;
+    TrackerService& operator=(const TrackerService&) = delete;
+
+    // Thread-safe and lock-free. Returns false, and counts the drop, when the shard queue is full.
+    bool ingest(const RangeMeasurement& measurement);
+
+    // Applies every range ingested so far and solves each ready tag once. Returns the
+    // number of new fixes. Must not run concurrently with itself or the accessors below.
+    size_t process();
+
+    [[nodiscard]] std::optional<TagFix> latestFix(uint32_t tagId) const;
+    [[nodiscard]] size_t tagCount() const;
+    [[nodiscard]] TrackerServiceStats stats() const;
+    [[nodiscard]] size_t threadCount() const { return pool_.threadCount(); }
+    [[nodiscard]] const TrackerServiceOptions& options() const { return options_; }
+
+  private:
+    struct HeldRange {
+        uint32_t anchorIndex = 0;
+        double timestamp = 0.0;
+        double range = 0.0;
+    };
+
+    struct TagState {
+        // Newest range per anchor, at most one entry per anchor
+        std::vector<HeldRange> ranges;
+        double newestTimestamp = 0.0;
+        bool pending = false;
+        std::optional<TagFix> fix;
+    };
+
+    struct Shard;
+
+    void drainShard(Shard& shard);
+    void solveTags(Shard& shard, size_t begin, size_t end);
+
+    TrackerServiceOptions options_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    WorkStealingPool pool_;
+    std::atomic<uint64_t> ingested_{0};
+    std::atomic<uint64_t> droppedQueueFull_{0};
+    std::atomic<size_t> fixesThisCall_{0};
+};
+
+}  // namespace TrueRangeMultilateration
@@ -0,0 +1,143 @@
+#include "work_stealing_pool.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace TrueRangeMultilateration {
+
+namespace {
+
+// The pool and deque index of the current thread while it runs pool tasks, so
+// submit() from inside a task pushes onto the deque of the thread running it.
+thread_local const WorkStealingPool* currentPool = nullptr;
+thread_local size_t currentQueue = 0;
+
+}  // namespace
+
+WorkStealingPool::WorkStealingPool(const size_t threadCount) {
+    size_t count = threadCount;
+    if (count == 0) {
+        count = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    // Deque 0 belongs to the thread calling wait(); workers own the rest.
+    queues_.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        queues_.push_back(std::make_unique<TaskQueue>());
+    }
+    workers_.reserve(count - 1);
+    for (size_t i = 1; i < count; ++i) {
+        workers_.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stopping_ = true;
+    }
+    taskAvailable_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+void WorkStealingPool::submit(std::function<void()> task) {
+    const size_t index = (currentPool == this)
+        ? currentQueue
+        : nextQueue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+
+    // Counted before the push so a thief never decrements below zero.
+    unfinished_.fetch_add(1);
+    queued_.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        queues_[index]->tasks.push_back(std::move(task));
+    }
+
+    if (!workers_.empty()) {
+        // Taking the lock orders this notify after a sleeper's predicate check.
+        { std::lock_guard<std::mutex> lock(sleepMutex_); }
+        taskAvailable_.notify_one();
+    }
+}
+
+void WorkStealingPool::wait() {
+    const WorkStealingPool* const previousPool = std::exchange(currentPool, this);
+    const size_t previousQueue = std::exchange(currentQueue, 0);
+
+    while (unfinished_.load() != 0) {
+        if (!runOne(0)) {
+            std::unique_lock<std::mutex> lock(sleepMutex_);
+            allDone_.wait(lock, [this] { return unfinished_.load() == 0; });
+        }
+    }
+
+    currentPool = previousPool;
+    currentQueue = previousQueue;
+
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(errorMutex_);
+        error = std::exchange(firstError_, nullptr);
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void WorkStealingPool::workerLoop(const size_t index) {
+    currentPool = this;
+    currentQueue = index;
+    for (;;) {
+        if (runOne(index)) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        taskAvailable_.wait(lock, [this] { return stopping_ || queued_.load() != 0; });
+        if (stopping_ && queued_.load() == 0) {
+            return;
+        }
+    }
+}
+
+bool WorkStealingPool::runOne(const size_t index) {
+    std::function<void()> task;
+    {
+        TaskQueue& own = *queues_[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+        }
+    }
+    for (size_t offset = 1; !task && offset < queues_.size(); ++offset) {
+        TaskQueue& victim = *queues_[(index + offset) % queues_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+        }
+    }
+    if (!task) {
+        return false;
+    }
+    queued_.fetch_sub(1);
+
+    try {
+        task();
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(errorMutex_);
+        if (!firstError_) {
+            firstError_ = std::current_exception();
+        }
+    }
+
+    if (unfinished_.fetch_sub(1) == 1) {
+        { std::lock_guard<std::mutex> lock(sleepMutex_); }
+        allDone_.notify_all();
+    }
+    return true;
+}
+
+}  // namespace TrueRangeMultilateration
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace TrueRangeMultilateration {
+
+// Worker pool for irregular task graphs whose tasks submit further tasks.
+// Every thread owns a deque: a task submitted from a worker goes onto that
+// worker's deque, which it pops newest-first, and idle threads steal the oldest
+// task from another deque. As with ThreadPool, the calling thread counts as one
+// of the threads and runs tasks inside wait(), so a pool with one thread never
+// spawns a thread.
+class WorkStealingPool {
+  public:
+    // threadCount == 0 selects std::thread::hardware_concurrency().
+    explicit WorkStealingPool(size_t threadCount = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // Threads that execute tasks, including the thread calling wait().
+    [[nodiscard]] size_t threadCount() const { return queues_.size(); }
+
+    // Queues a task. Safe from any thread, including from inside a running task.
+    void submit(std::function<void()> task);
+
+    // Runs tasks on the calling thread until every submitted task, including
+    // those submitted while waiting, has finished. The first exception thrown
+    // by a task is rethrown here. Only one thread may wait at a time.
+    void wait();
+
+  private:
+    struct TaskQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void workerLoop(size_t index);
+    // Pops from queue `index`, or steals from the others; false if all are empty.
+    bool runOne(size_t index);
+
+    std::vector<std::unique_ptr<TaskQueue>> queues_;
+    std::vector<std::thread> workers_;
+    // Tasks submitted and not yet finished, and tasks still sitting in a deque.
+    std::atomic<size_t> unfinished_{0};
+    std::atomic<size_t> queued_{0};
+    // Round-robin target for tasks submitted from outside the pool.
+    std::atomic<size_t> nextQueue_{0};
+    std::mutex sleepMutex_;
+    std::condition_variable taskAvailable_;
+    std::condition_variable allDone_;
+    bool stopping_ = false;
+    std::mutex errorMutex_;
+    std::exception_ptr firstError_;
+};
+
+}  // namespace TrueRangeMultilateration
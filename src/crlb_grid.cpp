@@ -0,0 +1,413 @@
+#include "crlb_grid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "true_range_multilateration_methods.h"
+
+namespace // anonymous namespace for helper functions
+{
+    // Anchors closer than this to a cell are skipped, as in calculateRangePositionCrlb
+    constexpr double minRange = 1e-12;
+
+    // Cells per vectorized packet; the packet arrays live on the stack
+    constexpr Eigen::Index packetCapacity = 128;
+    using Packet = Eigen::Array<double, Eigen::Dynamic, 1, Eigen::ColMajor, packetCapacity, 1>;
+
+    // Upper-triangle column order of CrlbGridResult::crlb and the per-anchor covariance blocks
+    enum : Eigen::Index { XX = 0, YY, ZZ, XY, XZ, YZ };
+
+    // Fisher information is safely full rank when its smallest eigenvalue, bounded below by det / trace^2,
+    // exceeds the rank tolerance 1e-12 * max(1, largest eigenvalue) of calculateRangePositionCrlb
+    // (the largest eigenvalue is bounded above by the trace)
+    bool closedFormInverseIsSafe(const double det, const double trace)
+    {
+        return det > 1e-12 * std::max(1.0, trace) * trace * trace;
+    }
+
+    // Eigen-decomposition pseudo-inverse with the rank tolerance of calculateRangePositionCrlb
+    void writePseudoInverse(
+        const Eigen::Matrix3d& fisherInformation,
+        const size_t cellIndex,
+        TrueRangeMultilateration::CrlbGridResult& result
+    )
+    {
+        const Eigen::Index row = static_cast<Eigen::Index>(cellIndex);
+        Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> eigensolver(fisherInformation);
+        if(eigensolver.info() != Eigen::Success)
+        {
+            result.crlb.row(row).setConstant(std::numeric_limits<double>::quiet_NaN());
+            result.positionErrorBound(row) = std::numeric_limits<double>::quiet_NaN();
+            result.rank[cellIndex] = 0;
+            return;
+        }
+
+        const Eigen::Vector3d eigenvalues = eigensolver.eigenvalues();
+        const Eigen::Matrix3d eigenvectors = eigensolver.eigenvectors();
+        const double tolerance = 1e-12 * std::max(1.0, eigenvalues.cwiseAbs().maxCoeff());
+
+        Eigen::Vector3d inverseEigenvalues = Eigen::Vector3d::Zero();
+        uint8_t rank = 0;
+        for(Eigen::Index i = 0; i < 3; ++i)
+        {
+            if(eigenvalues(i) > tolerance)
+            {
+                inverseEigenvalues(i) = 1.0 / eigenvalues(i);
+                ++rank;
+            }
+        }
+
+        Eigen::Matrix3d crlb = eigenvectors * inverseEigenvalues.asDiagonal() * eigenvectors.transpose();
+        crlb = 0.5 * (crlb + crlb.transpose());
+
+        result.crlb.row(row) << crlb(0, 0), crlb(1, 1), crlb(2, 2), crlb(0, 1), crlb(0, 2), crlb(1, 2);
+        result.positionErrorBound(row) = std::sqrt(std::max(0.0, crlb.trace()));
+        result.rank[cellIndex] = rank;
+    }
+
+    // Adjugate inverse when it is safe, otherwise the pseudo-inverse
+    void writeInverse(
+        const Eigen::Matrix3d& J,
+        const size_t cellIndex,
+        TrueRangeMultilateration::CrlbGridResult& result
+    )
+    {
+        const double c00 = J(1, 1) * J(2, 2) - J(1, 2) * J(1, 2);
+        const double c01 = J(0, 2) * J(1, 2) - J(0, 1) * J(2, 2);
+        const double c02 = J(0, 1) * J(1, 2) - J(0, 2) * J(1, 1);
+        const double det = J(0, 0) * c00 + J(0, 1) * c01 + J(0, 2) * c02;
+        if(!closedFormInverseIsSafe(det, J.trace()))
+        {
+            writePseudoInverse(J, cellIndex, result);
+            return;
+        }
+
+        const double c11 = J(0, 0) * J(2, 2) - J(0, 2) * J(0, 2);
+        const double c12 = J(0, 1) * J(0, 2) - J(0, 0) * J(1, 2);
+        const double c22 = J(0, 0) * J(1, 1) - J(0, 1) * J(0, 1);
+        const double invDet = 1.0 / det;
+
+        const Eigen::Index row = static_cast<Eigen::Index>(cellIndex);
+        result.crlb.row(row) << c00 * invDet, c11 * invDet, c22 * invDet, c01 * invDet, c02 * invDet, c12 * invDet;
+        result.positionErrorBound(row) = std::sqrt((c00 + c11 + c22) * invDet);
+        result.rank[cellIndex] = 3;
+    }
+
+} // namespace anonymous
+
+namespace TrueRangeMultilateration
+{
+
+Eigen::Vector3d CrlbGridSpec::cellPosition(const size_t cellIndex) const
+{
+    const size_t ix = cellIndex % countX;
+    const size_t iy = (cellIndex / countX) % countY;
+    const size_t iz = cellIndex / (countX * countY);
+    return origin + Eigen::Vector3d(
+        static_cast<double>(ix) * spacing.x(),
+        static_cast<double>(iy) * spacing.y(),
+        static_cast<double>(iz) * spacing.z()
+    );
+}
+
+CrlbGridEvaluator::CrlbGridEvaluator(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const double rangeStdDev,
+    const double anchorPositionStdDev
+)
+: anchorPositions_(anchorPositions),
+  rangeVariance_(rangeStdDev * rangeStdDev)
+{
+    if(rangeStdDev <= 0.0 || !std::isfinite(rangeStdDev))
+    {
+        warning_ = "Range standard deviation must be positive and finite.";
+        return;
+    }
+    if(anchorPositionStdDev < 0.0 || !std::isfinite(anchorPositionStdDev))
+    {
+        warning_ = "Anchor-position standard deviation must be nonnegative and finite.";
+        return;
+    }
+    initialize(nullptr, anchorPositionStdDev);
+}
+
+CrlbGridEvaluator::CrlbGridEvaluator(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const double rangeStdDev,
+    const Eigen::MatrixXd& anchorPositionCovariance
+)
+: anchorPositions_(anchorPositions),
+  rangeVariance_(rangeStdDev * rangeStdDev)
+{
+    if(rangeStdDev <= 0.0 || !std::isfinite(rangeStdDev))
+    {
+        warning_ = "Range standard deviation must be positive and finite.";
+        return;
+    }
+    initialize(&anchorPositionCovariance, 0.0);
+}
+
+void CrlbGridEvaluator::initialize(const Eigen::MatrixXd* anchorPositionCovariance, const double anchorPositionStdDev)
+{
+    if(!std::isfinite(rangeVariance_))
+    {
+        warning_ = "Range variance overflowed; use a smaller standard deviation.";
+        return;
+    }
+    for(const Eigen::Vector3d& anchorPosition : anchorPositions_)
+    {
+        if(!anchorPosition.allFinite())
+        {
+            warning_ = "Anchor positions must contain only finite coordinates.";
+            return;
+        }
+    }
+
+    const Eigen::Index anchorCount = static_cast<Eigen::Index>(anchorPositions_.size());
+    anchorCovarianceBlocks_ = Eigen::Matrix<double, Eigen::Dynamic, 6>::Zero(anchorCount, 6);
+
+    if(anchorPositionCovariance == nullptr)
+    {
+        const double anchorVariance = anchorPositionStdDev * anchorPositionStdDev;
+        if(!std::isfinite(anchorVariance))
+        {
+            warning_ = "Anchor-position variance overflowed; use a smaller standard deviation.";
+            return;
+        }
+        anchorCovarianceBlocks_.leftCols<3>().setConstant(anchorVariance);
+    }
+    else
+    {
+        Eigen::MatrixXd validatedCovariance;
+        warning_ = validateAnchorPositionCovariance(*anchorPositionCovariance, anchorPositions_.size(), validatedCovariance);
+        if(!warning_.empty())
+        {
+            return;
+        }
+
+        for(Eigen::Index i = 0; i < anchorCount && blockDiagonal_; ++i)
+        {
+            for(Eigen::Index j = 0; j < anchorCount; ++j)
+            {
+                if(i != j && !validatedCovariance.block<3, 3>(3 * i, 3 * j).isZero(0.0))
+                {
+                    blockDiagonal_ = false;
+                    break;
+                }
+            }
+        }
+
+        if(blockDiagonal_)
+        {
+            for(Eigen::Index i = 0; i < anchorCount; ++i)
+            {
+                const auto block = validatedCovariance.block<3, 3>(3 * i, 3 * i);
+                anchorCovarianceBlocks_.row(i) << block(0, 0), block(1, 1), block(2, 2), block(0, 1), block(0, 2), block(1, 2);
+            }
+        }
+        else
+        {
+            anchorPositionCovariance_ = std::move(validatedCovariance);
+        }
+    }
+
+    valid_ = true;
+    if(anchorPositions_.size() < 4)
+    {
+        warning_ = "Fewer than 4 anchors cannot fully constrain a 3D true-range position; displaying pseudo-inverse CRLB.";
+    }
+}
+
+CrlbGridResult CrlbGridEvaluator::evaluate(const CrlbGridSpec& grid, ThreadPool* pool) const
+{
+    if(!valid_)
+    {
+        throw std::logic_error("CrlbGridEvaluator::evaluate called on an invalid evaluator: " + warning_);
+    }
+
+    const size_t cellCount = grid.cellCount();
+    CrlbGridResult result;
+    result.crlb.resize(static_cast<Eigen::Index>(cellCount), 6);
+    result.positionErrorBound.resize(static_cast<Eigen::Index>(cellCount));
+    result.rank.assign(cellCount, 0);
+
+    auto evaluateRange = [this, &grid, &result](const size_t begin, const size_t end) {
+        if(blockDiagonal_)
+        {
+            evaluateDiagonalCells(grid, begin, end, result);
+        }
+        else
+        {
+            evaluateCorrelatedCells(grid, begin, end, result);
+        }
+    };
+
+    if(pool != nullptr)
+    {
+        // Whole packets per chunk so vector work is not split across threads
+        const size_t packetCount = (cellCount + packetCapacity - 1) / packetCapacity;
+        pool->parallelFor(0, packetCount, [&evaluateRange, cellCount](const size_t packetBegin, const size_t packetEnd) {
+            evaluateRange(packetBegin * packetCapacity, std::min(cellCount, packetEnd * packetCapacity));
+        });
+    }
+    else
+    {
+        evaluateRange(0, cellCount);
+    }
+
+    result.rankDeficientCellCount = static_cast<size_t>(
+        std::count_if(result.rank.begin(), result.rank.end(), [](const uint8_t rank) { return rank < 3; })
+    );
+    return result;
+}
+
+void CrlbGridEvaluator::evaluateDiagonalCells(
+    const CrlbGridSpec& grid,
+    const size_t begin,
+    const size_t end,
+    CrlbGridResult& result
+) const
+{
+    for(size_t packetBegin = begin; packetBegin < end; packetBegin += packetCapacity)
+    {
+        const Eigen::Index n = static_cast<Eigen::Index>(std::min<size_t>(packetCapacity, end - packetBegin));
+
+        Packet X(n), Y(n), Z(n);
+        for(Eigen::Index k = 0; k < n; ++k)
+        {
+            const Eigen::Vector3d position = grid.cellPosition(packetBegin + static_cast<size_t>(k));
+            X(k) = position.x();
+            Y(k) = position.y();
+            Z(k) = position.z();
+        }
+
+        // Fisher information sum_i d_i d_i^T / (sigma_r^2 |d_i|^2 + d_i^T C_ii d_i), one array per entry
+        Packet Jxx = Packet::Zero(n), Jyy = Packet::Zero(n), Jzz = Packet::Zero(n);
+        Packet Jxy = Packet::Zero(n), Jxz = Packet::Zero(n), Jyz = Packet::Zero(n);
+        for(size_t i = 0; i < anchorPositions_.size(); ++i)
+        {
+            const Eigen::Vector3d& p_i = anchorPositions_[i];
+            const auto C_i = anchorCovarianceBlocks_.row(static_cast<Eigen::Index>(i));
+
+            const Packet dx = X - p_i.x();
+            const Packet dy = Y - p_i.y();
+            const Packet dz = Z - p_i.z();
+            const Packet squaredRange = dx.square() + dy.square() + dz.square();
+            const Packet projectedAnchorVariance =
+                C_i(XX) * dx.square() + C_i(YY) * dy.square() + C_i(ZZ) * dz.square()
+                + 2.0 * (C_i(XY) * dx * dy + C_i(XZ) * dx * dz + C_i(YZ) * dy * dz);
+            const Packet w = (squaredRange > minRange * minRange)
+                .select((rangeVariance_ * squaredRange + projectedAnchorVariance).inverse(), 0.0);
+
+            const Packet wdx = w * dx;
+            const Packet wdy = w * dy;
+            Jxx += wdx * dx;
+            Jyy += wdy * dy;
+            Jzz += w * dz.square();
+            Jxy += wdx * dy;
+            Jxz += wdx * dz;
+            Jyz += wdy * dz;
+        }
+
+        // Closed-form inverse via the adjugate
+        const Packet cxx = Jyy * Jzz - Jyz.square();
+        const Packet cxy = Jxz * Jyz - Jxy * Jzz;
+        const Packet cxz = Jxy * Jyz - Jxz * Jyy;
+        const Packet cyy = Jxx * Jzz - Jxz.square();
+        const Packet cyz = Jxy * Jxz - Jxx * Jyz;
+        const Packet czz = Jxx * Jyy - Jxy.square();
+        const Packet det = Jxx * cxx + Jxy * cxy + Jxz * cxz;
+        const Packet invDet = det.inverse();
+
+        const Eigen::Index row = static_cast<Eigen::Index>(packetBegin);
+        result.crlb.col(XX).segment(row, n) = (cxx * invDet).matrix();
+        result.crlb.col(YY).segment(row, n) = (cyy * invDet).matrix();
+        result.crlb.col(ZZ).segment(row, n) = (czz * invDet).matrix();
+        result.crlb.col(XY).segment(row, n) = (cxy * invDet).matrix();
+        result.crlb.col(XZ).segment(row, n) = (cxz * invDet).matrix();
+        result.crlb.col(YZ).segment(row, n) = (cyz * invDet).matrix();
+        result.positionErrorBound.segment(row, n) = ((cxx + cyy + czz) * invDet).sqrt().matrix();
+
+        const Packet trace = Jxx + Jyy + Jzz;
+        for(Eigen::Index k = 0; k < n; ++k)
+        {
+            const size_t cellIndex = packetBegin + static_cast<size_t>(k);
+            if(closedFormInverseIsSafe(det(k), trace(k)))
+            {
+                result.rank[cellIndex] = 3;
+                continue;
+            }
+
+            Eigen::Matrix3d J;
+            J << Jxx(k), Jxy(k), Jxz(k),
+                 Jxy(k), Jyy(k), Jyz(k),
+                 Jxz(k), Jyz(k), Jzz(k);
+            writePseudoInverse(J, cellIndex, result);
+        }
+    }
+}
+
+void CrlbGridEvaluator::evaluateCorrelatedCells(
+    const CrlbGridSpec& grid,
+    const size_t begin,
+    const size_t end,
+    CrlbGridResult& result
+) const
+{
+    const Eigen::Index anchorCount = static_cast<Eigen::Index>(anchorPositions_.size());
+    Eigen::MatrixXd U(anchorCount, 3);
+    Eigen::MatrixXd effectiveRangeCovariance(anchorCount, anchorCount);
+    std::vector<Eigen::Index> usableAnchors;
+    usableAnchors.reserve(anchorPositions_.size());
+
+    for(size_t cellIndex = begin; cellIndex < end; ++cellIndex)
+    {
+        const Eigen::Vector3d position = grid.cellPosition(cellIndex);
+
+        usableAnchors.clear();
+        for(Eigen::Index i = 0; i < anchorCount; ++i)
+        {
+            const Eigen::Vector3d delta = position - anchorPositions_[static_cast<size_t>(i)];
+            const double rho = delta.norm();
+            if(rho <= minRange) continue;
+
+            U.row(static_cast<Eigen::Index>(usableAnchors.size())) = (delta / rho).transpose();
+            usableAnchors.push_back(i);
+        }
+
+        const Eigen::Index m = static_cast<Eigen::Index>(usableAnchors.size());
+        if(m == 0)
+        {
+            writePseudoInverse(Eigen::Matrix3d::Zero(), cellIndex, result);
+            continue;
+        }
+
+        // S = sigma_r^2 I + B C_a B^T with B's row a = -u_a^T in anchor a's block, i.e. S_ab = u_a^T C_ab u_b
+        const auto Um = U.topRows(m);
+        auto S = effectiveRangeCovariance.topLeftCorner(m, m);
+        for(Eigen::Index a = 0; a < m; ++a)
+        {
+            for(Eigen::Index b = a; b < m; ++b)
+            {
+                const Eigen::Index blockRow = 3 * usableAnchors[static_cast<size_t>(a)];
+                const Eigen::Index blockCol = 3 * usableAnchors[static_cast<size_t>(b)];
+                const double s_ab = (Um.row(a)
+                    * anchorPositionCovariance_.block<3, 3>(blockRow, blockCol)
+                    * Um.row(b).transpose()).value();
+                S(a, b) = s_ab;
+                S(b, a) = s_ab;
+            }
+            S(a, a) += rangeVariance_;
+        }
+
+        const Eigen::LLT<Eigen::MatrixXd> factorization(S);
+        const Eigen::Matrix3d J = Um.transpose() * factorization.solve(Um);
+        writeInverse(0.5 * (J + J.transpose()), cellIndex, result);
+    }
+}
+
+} // namespace TrueRangeMultilateration
+
+// END OF FILE //
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include "core/simulation_types.h"
+#include "core/thread_pool.h"
+
+namespace TrueRangeMultilateration
+{
+
+/**
+ * @brief Regular 1D/2D/3D grid of CRLB evaluation positions
+ * Cell (ix, iy, iz) lies at origin + (ix, iy, iz) .* spacing and has the flat index ix + countX * (iy + countY * iz).
+ * A 2D map uses countZ = 1.
+ */
+struct CrlbGridSpec {
+    Eigen::Vector3d origin = Eigen::Vector3d::Zero();
+    Eigen::Vector3d spacing = Eigen::Vector3d::Ones();
+    size_t countX = 1;
+    size_t countY = 1;
+    size_t countZ = 1;
+
+    [[nodiscard]] size_t cellCount() const { return countX * countY * countZ; }
+    [[nodiscard]] Eigen::Vector3d cellPosition(size_t cellIndex) const;
+};
+
+/**
+ * @brief Per-cell CRLB of a grid evaluation, stored structure-of-arrays
+ */
+struct CrlbGridResult {
+    // Upper triangle of the (pseudo-inverse) CRLB per cell; columns xx, yy, zz, xy, xz, yz, in square metres
+    Eigen::Matrix<double, Eigen::Dynamic, 6> crlb;
+    // sqrt(trace(CRLB)), the position error bound per cell, in metres. GDOP is this divided by rangeStdDev.
+    Eigen::VectorXd positionErrorBound;
+    // Rank of the Fisher information per cell; cells below 3 hold the pseudo-inverse CRLB
+    std::vector<uint8_t> rank;
+    size_t rankDeficientCellCount = 0;
+};
+
+/**
+ * @brief Evaluates calculateRangePositionCrlb over a grid of positions for one anchor set and noise model
+ *
+ * The anchor-position covariance is validated (validateAnchorPositionCovariance) once, at construction. When it is
+ * block diagonal - zero, isotropic, or independent per anchor - the effective range covariance is diagonal, and
+ * each Fisher matrix is sum_i d_i d_i^T / (sigma_r^2 |d_i|^2 + d_i^T C_ii d_i) with d_i = x - p_i. Those sums
+ * and the closed-form (adjugate) 3x3 inversion are evaluated on Eigen arrays of grid cells, so they vectorize
+ * across cells. Cells whose Fisher matrix is not safely full rank by a determinant bound fall back to the
+ * eigen-decomposition pseudo-inverse used by calculateRangePositionCrlb. A correlated covariance is handled per
+ * cell with an N x N factorization of the effective range covariance.
+ *
+ * Anchors within 1e-12 m of a cell are skipped for that cell, as in calculateRangePositionCrlb.
+ */
+class CrlbGridEvaluator {
+  public:
+    /**
+     * @brief Exact anchors, or independent isotropic anchor-coordinate noise
+     * @param anchorPositions Nominal 3D anchor positions, in metres
+     * @param rangeStdDev Shared range noise standard deviation, in metres; positive and finite
+     * @param anchorPositionStdDev Shared anchor-coordinate standard deviation, in metres; finite and nonnegative
+     */
+    CrlbGridEvaluator(
+        const std::vector<Eigen::Vector3d>& anchorPositions,
+        double rangeStdDev,
+        double anchorPositionStdDev = 0.0
+    );
+
+    /**
+     * @brief General stacked 3N x 3N anchor-position covariance, in square metres
+     */
+    CrlbGridEvaluator(
+        const std::vector<Eigen::Vector3d>& anchorPositions,
+        double rangeStdDev,
+        const Eigen::MatrixXd& anchorPositionCovariance
+    );
+
+    // False if the inputs were rejected; warning() then holds the reason
+    [[nodiscard]] bool valid() const { return valid_; }
+    // Rejection reason, or input notes such as fewer than 4 anchors
+    [[nodiscard]] const std::string& warning() const { return warning_; }
+    // True when the vectorized diagonal-covariance kernel is used
+    [[nodiscard]] bool blockDiagonal() const { return blockDiagonal_; }
+
+    /**
+     * @brief Computes the CRLB for every cell of @p grid
+     * @param grid
+     * @param pool Optional thread pool; cells are split across its threads
+     * @return CrlbGridResult
+     * @throws std::logic_error if the evaluator is not valid()
+     */
+    CrlbGridResult evaluate(const CrlbGridSpec& grid, ThreadPool* pool = nullptr) const;
+
+  private:
+    void initialize(const Eigen::MatrixXd* anchorPositionCovariance, double anchorPositionStdDev);
+    void evaluateDiagonalCells(const CrlbGridSpec& grid, size_t begin, size_t end, CrlbGridResult& result) const;
+    void evaluateCorrelatedCells(const CrlbGridSpec& grid, size_t begin, size_t end, CrlbGridResult& result) const;
+
+    std::vector<Eigen::Vector3d> anchorPositions_;
+    double rangeVariance_ = 0.0;
+    bool valid_ = false;
+    bool blockDiagonal_ = true;
+    std::string warning_;
+    // Per-anchor covariance blocks C_ii as columns xx, yy, zz, xy, xz, yz (block-diagonal case)
+    Eigen::Matrix<double, Eigen::Dynamic, 6> anchorCovarianceBlocks_;
+    // Validated full covariance (correlated case only)
+    Eigen::MatrixXd anchorPositionCovariance_;
+};
+
+} // namespace TrueRangeMultilateration
+
+
+// END OF FILE //
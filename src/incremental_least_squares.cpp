@@ -0,0 +1,172 @@
+#include "incremental_least_squares.h"
+
+#include <format>
+#include <stdexcept>
+
+namespace // anonymous namespace for helper functions
+{
+    // Eigenvalues of the information matrix below this fraction of the largest are treated as zero; the
+    // matrix is A^T A, so this is a relative singular value of 1e-6 in the design matrix
+    constexpr double rankTolerance = 1e-12;
+
+} // namespace anonymous
+
+namespace TrueRangeMultilateration
+{
+
+IncrementalLinearLeastSquaresI::IncrementalLinearLeastSquaresI(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    size_t rebuildInterval
+)
+: anchors_(anchorPositions.size()),
+  ranges_(anchorPositions.size(), 0.0),
+  held_(anchorPositions.size(), false),
+  rebuildInterval_(rebuildInterval)
+{
+    for(const Eigen::Vector3d& p_i : anchorPositions)
+    {
+        centroid_ += p_i;
+    }
+    if(!anchorPositions.empty())
+    {
+        centroid_ /= static_cast<double>(anchorPositions.size());
+    }
+
+    for(size_t i = 0; i < anchorPositions.size(); ++i)
+    {
+        AnchorRow& anchor = anchors_[i];
+        anchor.centred = anchorPositions[i] - centroid_;
+        anchor.row << -2.0 * anchor.centred, 1.0;
+        anchor.outerProduct = anchor.row * anchor.row.transpose();
+        anchor.squaredNorm = anchor.centred.squaredNorm();
+    }
+}
+
+void IncrementalLinearLeastSquaresI::setRange(size_t anchorIndex, double range)
+{
+    checkIndex(anchorIndex);
+    if(held_[anchorIndex])
+    {
+        accumulate(anchorIndex, ranges_[anchorIndex], -1.0);
+        ++downdatesSinceRebuild_;
+    }
+    else
+    {
+        held_[anchorIndex] = true;
+        ++rangeCount_;
+    }
+
+    ranges_[anchorIndex] = range;
+    accumulate(anchorIndex, range, 1.0);
+
+    if(rebuildInterval_ > 0 && downdatesSinceRebuild_ >= rebuildInterval_)
+    {
+        rebuild();
+    }
+}
+
+void IncrementalLinearLeastSquaresI::expireRange(size_t anchorIndex)
+{
+    checkIndex(anchorIndex);
+    if(!held_[anchorIndex])
+    {
+        return;
+    }
+
+    held_[anchorIndex] = false;
+    --rangeCount_;
+    accumulate(anchorIndex, ranges_[anchorIndex], -1.0);
+    ++downdatesSinceRebuild_;
+
+    if(rebuildInterval_ > 0 && downdatesSinceRebuild_ >= rebuildInterval_)
+    {
+        rebuild();
+    }
+}
+
+void IncrementalLinearLeastSquaresI::clear()
+{
+    held_.assign(held_.size(), false);
+    rangeCount_ = 0;
+    information_.setZero();
+    informationVector_.setZero();
+    downdatesSinceRebuild_ = 0;
+}
+
+void IncrementalLinearLeastSquaresI::rebuild()
+{
+    information_.setZero();
+    informationVector_.setZero();
+    for(size_t i = 0; i < anchors_.size(); ++i)
+    {
+        if(held_[i])
+        {
+            accumulate(i, ranges_[i], 1.0);
+        }
+    }
+    downdatesSinceRebuild_ = 0;
+}
+
+Eigen::Vector3d IncrementalLinearLeastSquaresI::estimate() const
+{
+    if(rangeCount_ < 4)
+    {
+        throw std::logic_error(std::format(
+            "The incremental LLS-I estimator needs at least 4 ranges, but holds {}.",
+            rangeCount_
+        ));
+    }
+
+    Eigen::Vector4d x;
+    const Eigen::LDLT<Eigen::Matrix4d> ldlt(information_);
+    if(ldlt.info() == Eigen::Success && ldlt.isPositive() && ldlt.rcond() > rankTolerance)
+    {
+        x = ldlt.solve(informationVector_);
+    }
+    else
+    {
+        // Pseudo-inverse of the symmetric information matrix: A^+ b = (A^T A)^+ A^T b
+        const Eigen::SelfAdjointEigenSolver<Eigen::Matrix4d> eigen(information_);
+        const Eigen::Vector4d& eigenvalues = eigen.eigenvalues();
+        const double threshold = rankTolerance * eigenvalues.cwiseAbs().maxCoeff();
+        Eigen::Vector4d projected = eigen.eigenvectors().transpose() * informationVector_;
+        for(Eigen::Index k = 0; k < 4; ++k)
+        {
+            projected(k) = (eigenvalues(k) > threshold) ? projected(k) / eigenvalues(k) : 0.0;
+        }
+        x = eigen.eigenvectors() * projected;
+    }
+
+    return centroid_ + x.head<3>();
+}
+
+bool IncrementalLinearLeastSquaresI::hasRange(size_t anchorIndex) const
+{
+    checkIndex(anchorIndex);
+    return held_[anchorIndex];
+}
+
+void IncrementalLinearLeastSquaresI::checkIndex(size_t anchorIndex) const
+{
+    if(anchorIndex >= anchors_.size())
+    {
+        throw std::out_of_range(std::format(
+            "Anchor index {} is out of range for an incremental estimator with {} anchors.",
+            anchorIndex,
+            anchors_.size()
+        ));
+    }
+}
+
+void IncrementalLinearLeastSquaresI::accumulate(size_t anchorIndex, double range, double sign)
+{
+    const AnchorRow& anchor = anchors_[anchorIndex];
+    const double b_i = range * range - anchor.squaredNorm;
+    information_.noalias() += sign * anchor.outerProduct;
+    informationVector_.noalias() += (sign * b_i) * anchor.row;
+}
+
+} // namespace TrueRangeMultilateration
+
+
+// END OF FILE //
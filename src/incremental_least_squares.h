@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <Eigen/Dense>
+
+namespace TrueRangeMultilateration
+{
+
+/**
+ * @brief Recursive linearLeastSquaresI_YueWang for ranges that arrive and expire one anchor at a time
+ *
+ * The LLS-I row of anchor i is a_i = [-2 * q_i^T, 1] with b_i = d_i^2 - |q_i|^2, where q_i is the anchor position
+ * relative to the centroid of the anchor set. The estimator keeps only the 4x4 information matrix sum a_i a_i^T and
+ * the vector sum a_i b_i of the ranges currently held, so setting, replacing or expiring a range is an O(1) rank-one
+ * update or downdate, and estimate() solves one 4x4 system without touching the other anchors.
+ *
+ * Centring keeps the entries of the information matrix at site scale; the solution is the same as without it.
+ * Because downdates subtract in floating point, the sums are recomputed from the held ranges after every
+ * rebuildInterval downdates, which is O(N) but rare.
+ */
+class IncrementalLinearLeastSquaresI {
+  public:
+    // Downdates between automatic rebuilds of the information sums from the held ranges
+    static constexpr size_t defaultRebuildInterval = 4096;
+
+    explicit IncrementalLinearLeastSquaresI(
+        const std::vector<Eigen::Vector3d>& anchorPositions,
+        size_t rebuildInterval = defaultRebuildInterval
+    );
+
+    /**
+     * @brief Sets the range to anchor @p anchorIndex, replacing (downdating) any range already held for it
+     */
+    void setRange(size_t anchorIndex, double range);
+
+    /**
+     * @brief Drops the range held for anchor @p anchorIndex; does nothing if none is held
+     */
+    void expireRange(size_t anchorIndex);
+
+    /**
+     * @brief Drops every held range
+     */
+    void clear();
+
+    /**
+     * @brief Recomputes the information sums from the held ranges, discarding accumulated downdate rounding
+     */
+    void rebuild();
+
+    /**
+     * @brief LLS-I position estimate from the ranges currently held
+     *
+     * Uses an LDLT of the 4x4 information matrix. When the held anchors are coplanar or otherwise rank deficient
+     * it falls back to the pseudo-inverse, giving the solution of minimum norm relative to the anchor centroid.
+     * @return Eigen::Vector3d Estimated position
+     * @throws std::logic_error if fewer than 4 ranges are held
+     */
+    [[nodiscard]] Eigen::Vector3d estimate() const;
+
+    [[nodiscard]] bool hasRange(size_t anchorIndex) const;
+    [[nodiscard]] size_t rangeCount() const { return rangeCount_; }
+    [[nodiscard]] size_t anchorCount() const { return anchors_.size(); }
+    [[nodiscard]] const Eigen::Vector3d& centroid() const { return centroid_; }
+    [[nodiscard]] const Eigen::Matrix4d& informationMatrix() const { return information_; }
+    [[nodiscard]] const Eigen::Vector4d& informationVector() const { return informationVector_; }
+
+  private:
+    void checkIndex(size_t anchorIndex) const;
+    void accumulate(size_t anchorIndex, double range, double sign);
+
+    // Per anchor: centred position q_i, the row a_i and its fixed outer product a_i a_i^T
+    struct AnchorRow {
+        Eigen::Vector3d centred;
+        Eigen::Vector4d row;
+        Eigen::Matrix4d outerProduct;
+        double squaredNorm = 0.0;
+    };
+
+    std::vector<AnchorRow> anchors_;
+    std::vector<double> ranges_;
+    std::vector<bool> held_;
+    Eigen::Vector3d centroid_ = Eigen::Vector3d::Zero();
+    Eigen::Matrix4d information_ = Eigen::Matrix4d::Zero();
+    Eigen::Vector4d informationVector_ = Eigen::Vector4d::Zero();
+    size_t rangeCount_ = 0;
+    size_t rebuildInterval_;
+    size_t downdatesSinceRebuild_ = 0;
+};
+
+} // namespace TrueRangeMultilateration
+
+
+// END OF FILE //
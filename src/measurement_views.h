@@ -0,0 +1,219 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <Eigen/Dense>
+
+namespace TrueRangeMultilateration
+{
+
+/**
+ * @brief Non-owning view of anchor positions stored as Scalar x, y, z triples in caller memory
+ *
+ * Anchor i occupies the three consecutive Scalars starting at data + i * stride, so packed arrays use stride 3 and
+ * interleaved records (e.g. x, y, z, quality) use the record size in Scalars. Elements are read as Eigen::Vector3d.
+ */
+template<typename Scalar>
+class StridedAnchorSpan
+{
+  public:
+    StridedAnchorSpan(const Scalar* data, size_t count, std::ptrdiff_t stride = 3)
+    : data_(data), count_(count), stride_(stride)
+    {
+        // empty
+    }
+
+    [[nodiscard]] size_t size() const { return count_; }
+    [[nodiscard]] bool empty() const { return count_ == 0; }
+
+    [[nodiscard]] Eigen::Vector3d operator[](size_t i) const
+    {
+        return Eigen::Map<const Eigen::Matrix<Scalar, 3, 1>>(data_ + static_cast<std::ptrdiff_t>(i) * stride_)
+            .template cast<double>();
+    }
+
+  private:
+    const Scalar* data_;
+    size_t count_;
+    std::ptrdiff_t stride_;
+};
+
+/**
+ * @brief Non-owning view of range measurements: element i is data[i * stride], read as double
+ */
+template<typename Scalar>
+class StridedRangeSpan
+{
+  public:
+    StridedRangeSpan(const Scalar* data, size_t count, std::ptrdiff_t stride = 1)
+    : data_(data), count_(count), stride_(stride)
+    {
+        // empty
+    }
+
+    [[nodiscard]] size_t size() const { return count_; }
+    [[nodiscard]] bool empty() const { return count_ == 0; }
+
+    [[nodiscard]] double operator[](size_t i) const
+    {
+        return static_cast<double>(data_[static_cast<std::ptrdiff_t>(i) * stride_]);
+    }
+
+  private:
+    const Scalar* data_;
+    size_t count_;
+    std::ptrdiff_t stride_;
+};
+
+/**
+ * @brief Zero-copy anchor input for the view overloads of the estimators: double or float, packed or strided
+ *
+ * The view does not own the memory, which must outlive the call it is passed to.
+ */
+class AnchorPositionsView
+{
+  public:
+    using Span = std::variant<StridedAnchorSpan<double>, StridedAnchorSpan<float>>;
+
+    AnchorPositionsView(const std::vector<Eigen::Vector3d>& anchorPositions)
+    : span_(StridedAnchorSpan<double>(anchorPositions.empty() ? nullptr : anchorPositions.front().data(), anchorPositions.size()))
+    {
+        // empty
+    }
+
+    AnchorPositionsView(std::span<const Eigen::Vector3d> anchorPositions)
+    : span_(StridedAnchorSpan<double>(anchorPositions.empty() ? nullptr : anchorPositions.front().data(), anchorPositions.size()))
+    {
+        // empty
+    }
+
+    AnchorPositionsView(std::span<const Eigen::Vector3f> anchorPositions)
+    : span_(StridedAnchorSpan<float>(anchorPositions.empty() ? nullptr : anchorPositions.front().data(), anchorPositions.size()))
+    {
+        // empty
+    }
+
+    // Columns of a 3 x N matrix, e.g. Eigen::Map<const Eigen::Matrix3Xd, 0, Eigen::OuterStride<>>(data, 3, N, stride)
+    AnchorPositionsView(const Eigen::Map<const Eigen::Matrix3Xd, 0, Eigen::OuterStride<>>& columns)
+    : span_(StridedAnchorSpan<double>(columns.data(), static_cast<size_t>(columns.cols()), columns.outerStride()))
+    {
+        // empty
+    }
+
+    AnchorPositionsView(const Eigen::Map<const Eigen::Matrix3Xf, 0, Eigen::OuterStride<>>& columns)
+    : span_(StridedAnchorSpan<float>(columns.data(), static_cast<size_t>(columns.cols()), columns.outerStride()))
+    {
+        // empty
+    }
+
+    template<typename Scalar>
+    AnchorPositionsView(const StridedAnchorSpan<Scalar>& anchorPositions)
+    : span_(anchorPositions)
+    {
+        // empty
+    }
+
+    AnchorPositionsView(const double* xyz, size_t count, std::ptrdiff_t stride = 3)
+    : span_(StridedAnchorSpan<double>(xyz, count, stride))
+    {
+        // empty
+    }
+
+    AnchorPositionsView(const float* xyz, size_t count, std::ptrdiff_t stride = 3)
+    : span_(StridedAnchorSpan<float>(xyz, count, stride))
+    {
+        // empty
+    }
+
+    [[nodiscard]] size_t size() const { return std::visit([](const auto& s) { return s.size(); }, span_); }
+    [[nodiscard]] const Span& span() const { return span_; }
+
+  private:
+    Span span_;
+};
+
+/**
+ * @brief Zero-copy range input for the view overloads of the estimators: double or float, packed or strided
+ *
+ * The view does not own the memory, which must outlive the call it is passed to.
+ */
+class RangesView
+{
+  public:
+    using Span = std::variant<StridedRangeSpan<double>, StridedRangeSpan<float>>;
+
+    RangesView(const std::vector<double>& ranges)
+    : span_(StridedRangeSpan<double>(ranges.data(), ranges.size()))
+    {
+        // empty
+    }
+
+    RangesView(std::span<const double> ranges)
+    : span_(StridedRangeSpan<double>(ranges.data(), ranges.size()))
+    {
+        // empty
+    }
+
+    RangesView(std::span<const float> ranges)
+    : span_(StridedRangeSpan<float>(ranges.data(), ranges.size()))
+    {
+        // empty
+    }
+
+    RangesView(const Eigen::Map<const Eigen::VectorXd, 0, Eigen::InnerStride<>>& ranges)
+    : span_(StridedRangeSpan<double>(ranges.data(), static_cast<size_t>(ranges.size()), ranges.innerStride()))
+    {
+        // empty
+    }
+
+    RangesView(const Eigen::Map<const Eigen::VectorXf, 0, Eigen::InnerStride<>>& ranges)
+    : span_(StridedRangeSpan<float>(ranges.data(), static_cast<size_t>(ranges.size()), ranges.innerStride()))
+    {
+        // empty
+    }
+
+    template<typename Scalar>
+    RangesView(const StridedRangeSpan<Scalar>& ranges)
+    : span_(ranges)
+    {
+        // empty
+    }
+
+    RangesView(const double* ranges, size_t count, std::ptrdiff_t stride = 1)
+    : span_(StridedRangeSpan<double>(ranges, count, stride))
+    {
+        // empty
+    }
+
+    RangesView(const float* ranges, size_t count, std::ptrdiff_t stride = 1)
+    : span_(StridedRangeSpan<float>(ranges, count, stride))
+    {
+        // empty
+    }
+
+    [[nodiscard]] size_t size() const { return std::visit([](const auto& s) { return s.size(); }, span_); }
+    [[nodiscard]] const Span& span() const { return span_; }
+
+  private:
+    Span span_;
+};
+
+/**
+ * @brief Calls visitor(anchorSpan, rangeSpan, ...) with the concrete StridedAnchorSpan / StridedRangeSpan types
+ *
+ * Resolves the element types once per call, so the visited code indexes typed memory with no per-element dispatch.
+ */
+template<typename Visitor, typename... Views>
+decltype(auto) visitMeasurements(Visitor&& visitor, const Views&... views)
+{
+    return std::visit(std::forward<Visitor>(visitor), views.span()...);
+}
+
+} // namespace TrueRangeMultilateration
+
+
+// END OF FILE //
@@ -0,0 +1,248 @@
+#include "mixed_precision.h"
+#include "core/stage_timer.h"
+
+#include <type_traits>
+#include <utility>
+
+namespace // anonymous namespace for helper functions
+{
+    using TrueRangeMultilateration::MixedPrecisionOptions;
+    using TrueRangeMultilateration::SolveResult;
+    using TrueRangeMultilateration::SolveStageTimings;
+    using TrueRangeMultilateration::StageTimer;
+
+    template<typename T>
+    T sq(const T& x)
+    {
+        return x * x;
+    }
+
+    template<typename Anchors>
+    Eigen::Vector3d anchorCentroid(const Anchors& anchorPositions)
+    {
+        Eigen::Vector3d centroid = Eigen::Vector3d::Zero();
+        for(size_t i = 0; i < anchorPositions.size(); ++i)
+        {
+            centroid += anchorPositions[i];
+        }
+        return centroid / static_cast<double>(anchorPositions.size());
+    }
+
+    // Least-squares solve of the rowCount x Cols system whose row k, computed in double by row(k), is (a_k, b_k).
+    // A and b are stored and factored in Scalar. For float, the double residual decides whether one refinement
+    // step x += A^+ (b - A x) is taken, reusing the float SVD and the double rows.
+    template<typename Scalar, int Cols, typename RowFn>
+    Eigen::Matrix<double, Cols, 1> solveLeastSquaresMixed(
+        size_t rowCount,
+        const RowFn& row,
+        const MixedPrecisionOptions& options,
+        SolveResult* diagnostics
+    )
+    {
+        using MatrixS = Eigen::Matrix<Scalar, Eigen::Dynamic, Cols>;
+        using VectorS = Eigen::Matrix<Scalar, Eigen::Dynamic, 1>;
+        using VectorC = Eigen::Matrix<double, Cols, 1>;
+
+        StageTimer timer(diagnostics);
+        const Eigen::Index N = static_cast<Eigen::Index>(rowCount);
+        MatrixS A(N, Cols);
+        VectorS b(N);
+        for(Eigen::Index k = 0; k < N; ++k)
+        {
+            const auto [a_k, b_k] = row(static_cast<size_t>(k));
+            A.row(k) = a_k.transpose().template cast<Scalar>();
+            b(k) = static_cast<Scalar>(b_k);
+        }
+        timer.lap(&SolveStageTimings::setupNs);
+
+        Eigen::BDCSVD<MatrixS, Eigen::ComputeThinU | Eigen::ComputeThinV> svd(A);
+        timer.lap(&SolveStageTimings::factorizationNs);
+        if(diagnostics != nullptr)
+        {
+            diagnostics->rank = static_cast<int>(svd.rank());
+        }
+
+        VectorC x = svd.solve(b).template cast<double>();
+        if constexpr (!std::is_same_v<Scalar, double>)
+        {
+            VectorS residual(N);
+            VectorC gradient = VectorC::Zero();
+            VectorC ATb = VectorC::Zero();
+            for(Eigen::Index k = 0; k < N; ++k)
+            {
+                const auto [a_k, b_k] = row(static_cast<size_t>(k));
+                const double r_k = b_k - a_k.dot(x);
+                residual(k) = static_cast<Scalar>(r_k);
+                gradient += r_k * a_k;
+                ATb += b_k * a_k;
+            }
+
+            if(gradient.norm() > options.refinementTolerance * ATb.norm())
+            {
+                x += svd.solve(residual).template cast<double>();
+                if(diagnostics != nullptr)
+                {
+                    ++diagnostics->iterations;
+                }
+            }
+        }
+        timer.lap(&SolveStageTimings::refinementNs);
+
+        return x;
+    }
+
+    template<typename Scalar, typename Anchors, typename Ranges>
+    Eigen::Vector3d ordinaryLeastSquaresWikipedia2MixedImpl(
+        const Anchors& anchorPositions,
+        const Ranges& ranges,
+        const MixedPrecisionOptions& options,
+        SolveResult* diagnostics
+    )
+    {
+        const size_t N = ranges.size();
+        const double N_inv = 1.0 / static_cast<double>(N);
+        const Eigen::Vector3d centroid = anchorCentroid(anchorPositions);
+
+        // Relative to the centroid, A.row(i) = -2 * q_i with q_i = p_i - centroid
+        double meanSquaredRange = 0.0;
+        double meanSquaredNormAnchorPos = 0.0;
+        for(size_t i = 0; i < N; ++i)
+        {
+            meanSquaredRange += sq(ranges[i]);
+            meanSquaredNormAnchorPos += (anchorPositions[i] - centroid).squaredNorm();
+        }
+        meanSquaredRange *= N_inv;
+        meanSquaredNormAnchorPos *= N_inv;
+
+        auto row = [&](size_t i) {
+            const Eigen::Vector3d q_i = anchorPositions[i] - centroid;
+            return std::pair<Eigen::Vector3d, double>(
+                -2.0 * q_i,
+                sq(ranges[i]) - meanSquaredRange - q_i.squaredNorm() + meanSquaredNormAnchorPos);
+        };
+
+        return centroid + solveLeastSquaresMixed<Scalar, 3>(N, row, options, diagnostics);
+    }
+
+    template<typename Scalar, typename Anchors, typename Ranges>
+    Eigen::Vector3d linearLeastSquaresI_YueWangMixedImpl(
+        const Anchors& anchorPositions,
+        const Ranges& ranges,
+        const MixedPrecisionOptions& options,
+        SolveResult* diagnostics
+    )
+    {
+        const Eigen::Vector3d centroid = anchorCentroid(anchorPositions);
+
+        auto row = [&](size_t i) {
+            const Eigen::Vector3d q_i = anchorPositions[i] - centroid;
+            Eigen::Vector4d a_i;
+            a_i << -2.0 * q_i, 1.0;
+            return std::pair<Eigen::Vector4d, double>(a_i, sq(ranges[i]) - q_i.squaredNorm());
+        };
+
+        const Eigen::Vector4d x = solveLeastSquaresMixed<Scalar, 4>(ranges.size(), row, options, diagnostics);
+        return centroid + x.head<3>();
+    }
+
+    template<typename Scalar, typename Anchors, typename Ranges>
+    Eigen::Vector3d linearLeastSquaresII_2_YueWangMixedImpl(
+        const Anchors& anchorPositions,
+        const Ranges& ranges,
+        const MixedPrecisionOptions& options,
+        SolveResult* diagnostics
+    )
+    {
+        const size_t N = ranges.size();
+        const Eigen::Vector3d centroid = anchorCentroid(anchorPositions);
+
+        // Select shortest range as reference
+        size_t refIndex = 0;
+        for(size_t i = 1; i < N; ++i)
+        {
+            if(ranges[i] < ranges[refIndex])
+            {
+                refIndex = i;
+            }
+        }
+        const Eigen::Vector3d q_r = anchorPositions[refIndex] - centroid;
+        const double d_r = ranges[refIndex];
+
+        auto row = [&](size_t k) {
+            const size_t i = (k < refIndex) ? k : k + 1;
+            const Eigen::Vector3d q_i = anchorPositions[i] - centroid;
+            return std::pair<Eigen::Vector3d, double>(
+                2.0 * (q_i - q_r),
+                sq(d_r) - sq(ranges[i]) - q_r.squaredNorm() + q_i.squaredNorm());
+        };
+
+        return centroid + solveLeastSquaresMixed<Scalar, 3>(N - 1, row, options, diagnostics);
+    }
+
+} // namespace anonymous
+
+namespace TrueRangeMultilateration
+{
+
+template<typename Scalar>
+Eigen::Vector3d ordinaryLeastSquaresWikipedia2Mixed(
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    const MixedPrecisionOptions& options,
+    SolveResult* diagnostics
+)
+{
+    return visitMeasurements(
+        [&](const auto& anchorSpan, const auto& rangeSpan) {
+            return ordinaryLeastSquaresWikipedia2MixedImpl<Scalar>(anchorSpan, rangeSpan, options, diagnostics);
+        },
+        anchorPositions, ranges);
+}
+
+template<typename Scalar>
+Eigen::Vector3d linearLeastSquaresI_YueWangMixed(
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    const MixedPrecisionOptions& options,
+    SolveResult* diagnostics
+)
+{
+    return visitMeasurements(
+        [&](const auto& anchorSpan, const auto& rangeSpan) {
+            return linearLeastSquaresI_YueWangMixedImpl<Scalar>(anchorSpan, rangeSpan, options, diagnostics);
+        },
+        anchorPositions, ranges);
+}
+
+template<typename Scalar>
+Eigen::Vector3d linearLeastSquaresII_2_YueWangMixed(
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    const MixedPrecisionOptions& options,
+    SolveResult* diagnostics
+)
+{
+    return visitMeasurements(
+        [&](const auto& anchorSpan, const auto& rangeSpan) {
+            return linearLeastSquaresII_2_YueWangMixedImpl<Scalar>(anchorSpan, rangeSpan, options, diagnostics);
+        },
+        anchorPositions, ranges);
+}
+
+template Eigen::Vector3d ordinaryLeastSquaresWikipedia2Mixed<float>(
+    const AnchorPositionsView&, const RangesView&, const MixedPrecisionOptions&, SolveResult*);
+template Eigen::Vector3d ordinaryLeastSquaresWikipedia2Mixed<double>(
+    const AnchorPositionsView&, const RangesView&, const MixedPrecisionOptions&, SolveResult*);
+template Eigen::Vector3d linearLeastSquaresI_YueWangMixed<float>(
+    const AnchorPositionsView&, const RangesView&, const MixedPrecisionOptions&, SolveResult*);
+template Eigen::Vector3d linearLeastSquaresI_YueWangMixed<double>(
+    const AnchorPositionsView&, const RangesView&, const MixedPrecisionOptions&, SolveResult*);
+template Eigen::Vector3d linearLeastSquaresII_2_YueWangMixed<float>(
+    const AnchorPositionsView&, const RangesView&, const MixedPrecisionOptions&, SolveResult*);
+template Eigen::Vector3d linearLeastSquaresII_2_YueWangMixed<double>(
+    const AnchorPositionsView&, const RangesView&, const MixedPrecisionOptions&, SolveResult*);
+
+} // namespace TrueRangeMultilateration
+
+
+// END OF FILE //
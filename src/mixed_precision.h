@@ -0,0 +1,75 @@
+#pragma once
+
+#include <Eigen/Dense>
+
+#include "core/simulation_types.h"
+#include "measurement_views.h"
+
+namespace TrueRangeMultilateration
+{
+
+/**
+ * @brief Settings of the reduced-precision linear solvers
+ */
+struct MixedPrecisionOptions {
+    // A float solve is refined in double when the double-precision normal-equation residual |A^T (b - A x)|
+    // exceeds this fraction of |A^T b|. 0 always refines; infinity never does.
+    double refinementTolerance = 1e-6;
+};
+
+/**
+ * @brief ordinaryLeastSquaresWikipedia2 with the design matrix built and factored in Scalar (float or double)
+ * The anchors are first centred on their centroid in double, which leaves the solution unchanged but keeps the
+ * squared-norm terms of b small enough for float. For Scalar = float the residual of the solution is then checked
+ * in double, and one iterative-refinement step with the float factorization is applied if it is too large.
+ * @param anchorPositions Position of anchors (Works even if anchors are coplanar)
+ * @param ranges
+ * @param options Refinement threshold
+ * @param diagnostics If not null, receives the SVD rank, stage timings and, as iterations, the refinement steps taken
+ * @return Eigen::Vector3d Estimated position
+ */
+template<typename Scalar>
+Eigen::Vector3d ordinaryLeastSquaresWikipedia2Mixed(
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    const MixedPrecisionOptions& options = MixedPrecisionOptions{},
+    SolveResult* diagnostics = nullptr
+);
+
+/**
+ * @brief linearLeastSquaresI_YueWang in Scalar (float or double), with centred anchors and double refinement
+ * Centring reparametrises the R = |x|^2 unknown affinely, so the least-squares solution is the same as without it.
+ * @param anchorPositions
+ * @param ranges
+ * @param options Refinement threshold
+ * @param diagnostics If not null, receives the SVD rank, stage timings and, as iterations, the refinement steps taken
+ * @return Eigen::Vector3d Estimated position
+ */
+template<typename Scalar>
+Eigen::Vector3d linearLeastSquaresI_YueWangMixed(
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    const MixedPrecisionOptions& options = MixedPrecisionOptions{},
+    SolveResult* diagnostics = nullptr
+);
+
+/**
+ * @brief linearLeastSquaresII_2_YueWang in Scalar (float or double), with centred anchors and double refinement
+ * @param anchorPositions
+ * @param ranges
+ * @param options Refinement threshold
+ * @param diagnostics If not null, receives the SVD rank, stage timings and, as iterations, the refinement steps taken
+ * @return Eigen::Vector3d Estimated position
+ */
+template<typename Scalar>
+Eigen::Vector3d linearLeastSquaresII_2_YueWangMixed(
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    const MixedPrecisionOptions& options = MixedPrecisionOptions{},
+    SolveResult* diagnostics = nullptr
+);
+
+} // namespace TrueRangeMultilateration
+
+
+// END OF FILE //
@@ -0,0 +1,306 @@
+#include "range_levenberg_marquardt.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace // anonymous namespace for helper functions
+{
+    struct NormalEquations {
+        double cost = 0.0;
+        Eigen::Matrix3d JTJ = Eigen::Matrix3d::Zero();
+        Eigen::Vector3d JTr = Eigen::Vector3d::Zero();
+    };
+
+    // One fused pass: cost, J^T J and J^T r of the whitened, weighted range residuals at x
+    template<typename Anchors, typename Ranges>
+    NormalEquations evaluate(
+        const Anchors& anchorPositions,
+        const Ranges& ranges,
+        const std::vector<double>& weights,
+        const double rangeStdDevInv,
+        const Eigen::Vector3d& x
+    )
+    {
+        NormalEquations eq;
+        const size_t N = ranges.size();
+        for(size_t i = 0; i < N; ++i)
+        {
+            const Eigen::Vector3d diff = x - anchorPositions[i];
+            const double modeledRange = diff.norm();
+            const double w_i = weights.empty() ? 1.0 : weights[i];
+            const double r_i = (modeledRange - ranges[i]) * rangeStdDevInv;
+
+            eq.cost += 0.5 * w_i * r_i * r_i;
+            if(modeledRange < 1e-12) continue; // Jacobian undefined at the anchor itself
+
+            const Eigen::Vector3d j_i = (rangeStdDevInv / modeledRange) * diff;
+            eq.JTJ.noalias() += w_i * j_i * j_i.transpose();
+            eq.JTr += (w_i * r_i) * j_i;
+        }
+        return eq;
+    }
+
+    // Cauchy weights from the residuals at x, fused with the normal equations under those new weights
+    template<typename Anchors, typename Ranges>
+    NormalEquations reweightAndEvaluate(
+        const Anchors& anchorPositions,
+        const Ranges& ranges,
+        const double rangeStdDevInv,
+        const double robustLossParam,
+        const Eigen::Vector3d& x,
+        std::vector<double>& weights
+    )
+    {
+        NormalEquations eq;
+        const size_t N = ranges.size();
+        for(size_t i = 0; i < N; ++i)
+        {
+            const Eigen::Vector3d diff = x - anchorPositions[i];
+            const double modeledRange = diff.norm();
+            const double r_i = (modeledRange - ranges[i]) * rangeStdDevInv;
+            const double u = r_i / robustLossParam;
+            const double w_i = weights[i] = std::max(1.0 / (1.0 + u * u), 1e-9); // Clamp weights to avoid numerical issues
+
+            eq.cost += 0.5 * w_i * r_i * r_i;
+            if(modeledRange < 1e-12) continue;
+
+            const Eigen::Vector3d j_i = (rangeStdDevInv / modeledRange) * diff;
+            eq.JTJ.noalias() += w_i * j_i * j_i.transpose();
+            eq.JTr += (w_i * r_i) * j_i;
+        }
+        return eq;
+    }
+
+    double initialDamping(const TrueRangeMultilateration::LevenbergMarquardtOptions& options, const NormalEquations& eq)
+    {
+        return options.initialDampingScale * std::max(eq.JTJ.diagonal().maxCoeff(), 1e-12);
+    }
+
+    // Damped iterations from the normal equations `current` at `position`; updates both, the damping and the summary.
+    // Damping update from H. B. Nielsen, "Damping parameter in Marquardt's method" (1999)
+    template<typename Evaluate>
+    void iterate(
+        const TrueRangeMultilateration::LevenbergMarquardtOptions& options,
+        const Evaluate& evaluateAt,
+        double& damping,
+        Eigen::Vector3d& position,
+        NormalEquations& current,
+        TrueRangeMultilateration::LevenbergMarquardtSummary& summary
+    )
+    {
+        double dampingGrowth = 2.0;
+        while(summary.iterations < options.maxIterations)
+        {
+            if(current.JTr.lpNorm<Eigen::Infinity>() <= options.gradientTolerance)
+            {
+                summary.converged = true;
+                break;
+            }
+
+            ++summary.iterations;
+
+            Eigen::Matrix3d dampedJTJ = current.JTJ;
+            dampedJTJ.diagonal().array() += damping;
+            const Eigen::Vector3d step = dampedJTJ.ldlt().solve(-current.JTr);
+
+            if(step.norm() <= options.stepTolerance * (position.norm() + options.stepTolerance))
+            {
+                summary.converged = true;
+                break;
+            }
+
+            const Eigen::Vector3d candidate = position + step;
+            const NormalEquations trial = evaluateAt(candidate);
+            ++summary.functionEvaluations;
+
+            // Reduction predicted by the damped quadratic model, 0.5 * dx^T (lambda * dx - J^T r)
+            const double predictedReduction = 0.5 * step.dot(damping * step - current.JTr);
+            const double actualReduction = current.cost - trial.cost;
+            const double gainRatio = (predictedReduction > 0.0) ? actualReduction / predictedReduction : -1.0;
+
+            if(gainRatio > 0.0)
+            {
+                const double previousCost = current.cost;
+                position = candidate;
+                current = trial;
+                damping *= std::max(1.0 / 3.0, 1.0 - std::pow(2.0 * gainRatio - 1.0, 3));
+                dampingGrowth = 2.0;
+
+                if(actualReduction <= options.costTolerance * previousCost)
+                {
+                    summary.converged = true;
+                    break;
+                }
+            }
+            else
+            {
+                damping *= dampingGrowth;
+                dampingGrowth *= 2.0;
+            }
+        }
+    }
+
+} // namespace anonymous
+
+namespace TrueRangeMultilateration
+{
+
+RangeLevenbergMarquardt::RangeLevenbergMarquardt(const LevenbergMarquardtOptions& options)
+: options_(options)
+{
+    // empty
+}
+
+LevenbergMarquardtSummary RangeLevenbergMarquardt::minimize(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const std::vector<double>& ranges,
+    const std::vector<double>& weights,
+    const double rangeStdDev,
+    Eigen::Vector3d& position
+)
+{
+    return minimizeImpl(anchorPositions, ranges, weights, rangeStdDev, position);
+}
+
+LevenbergMarquardtSummary RangeLevenbergMarquardt::minimize(
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    const std::vector<double>& weights,
+    const double rangeStdDev,
+    Eigen::Vector3d& position
+)
+{
+    return visitMeasurements(
+        [&](const auto& anchorSpan, const auto& rangeSpan) {
+            return minimizeImpl(anchorSpan, rangeSpan, weights, rangeStdDev, position);
+        },
+        anchorPositions, ranges);
+}
+
+template<typename Anchors, typename Ranges>
+LevenbergMarquardtSummary RangeLevenbergMarquardt::minimizeImpl(
+    const Anchors& anchorPositions,
+    const Ranges& ranges,
+    const std::vector<double>& weights,
+    const double rangeStdDev,
+    Eigen::Vector3d& position
+)
+{
+    LevenbergMarquardtSummary summary;
+    const double rangeStdDevInv = 1.0 / rangeStdDev;
+    const auto evaluateAt = [&](const Eigen::Vector3d& x) {
+        return evaluate(anchorPositions, ranges, weights, rangeStdDevInv, x);
+    };
+
+    NormalEquations current = evaluateAt(position);
+    ++summary.functionEvaluations;
+    summary.initialCost = current.cost;
+
+    if(damping_ <= 0.0)
+    {
+        damping_ = initialDamping(options_, current);
+    }
+
+    iterate(options_, evaluateAt, damping_, position, current, summary);
+
+    summary.finalCost = current.cost;
+    return summary;
+}
+
+RobustRangeLevenbergMarquardt::RobustRangeLevenbergMarquardt(const RobustLevenbergMarquardtOptions& options)
+: options_(options)
+{
+    // empty
+}
+
+const RobustLevenbergMarquardtResult& RobustRangeLevenbergMarquardt::minimize(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const std::vector<double>& ranges,
+    const double rangeStdDev,
+    const double robustLossParam,
+    const Eigen::Vector3d& initialPosition
+)
+{
+    return minimizeImpl(anchorPositions, ranges, rangeStdDev, robustLossParam, initialPosition);
+}
+
+const RobustLevenbergMarquardtResult& RobustRangeLevenbergMarquardt::minimize(
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    const double rangeStdDev,
+    const double robustLossParam,
+    const Eigen::Vector3d& initialPosition
+)
+{
+    return visitMeasurements(
+        [&](const auto& anchorSpan, const auto& rangeSpan) -> const RobustLevenbergMarquardtResult& {
+            return minimizeImpl(anchorSpan, rangeSpan, rangeStdDev, robustLossParam, initialPosition);
+        },
+        anchorPositions, ranges);
+}
+
+template<typename Anchors, typename Ranges>
+const RobustLevenbergMarquardtResult& RobustRangeLevenbergMarquardt::minimizeImpl(
+    const Anchors& anchorPositions,
+    const Ranges& ranges,
+    const double rangeStdDev,
+    const double robustLossParam,
+    const Eigen::Vector3d& initialPosition
+)
+{
+    const double rangeStdDevInv = 1.0 / rangeStdDev;
+    std::vector<double>& weights = result_.weights;
+    const auto evaluateAt = [&](const Eigen::Vector3d& x) {
+        return evaluate(anchorPositions, ranges, weights, rangeStdDevInv, x);
+    };
+
+    result_.position = initialPosition;
+    result_.outerIterations = 0;
+    result_.innerIterations = 0;
+    result_.functionEvaluations = 0;
+    result_.converged = false;
+    weights.assign(ranges.size(), 1.0);
+
+    NormalEquations current = evaluateAt(result_.position);
+    ++result_.functionEvaluations;
+
+    double prevFnorm = std::numeric_limits<double>::max();
+    while(result_.outerIterations < options_.maxOuterIterations)
+    {
+        if(!options_.warmStart || damping_ <= 0.0)
+        {
+            damping_ = initialDamping(options_.inner, current);
+        }
+
+        LevenbergMarquardtSummary pass;
+        iterate(options_.inner, evaluateAt, damping_, result_.position, current, pass);
+        ++result_.outerIterations;
+        result_.innerIterations += pass.iterations;
+        result_.functionEvaluations += pass.functionEvaluations;
+        result_.finalCost = current.cost;
+
+        current = reweightAndEvaluate(anchorPositions, ranges, rangeStdDevInv, robustLossParam, result_.position, weights);
+        ++result_.functionEvaluations;
+
+        const double fnorm = std::sqrt(2.0 * result_.finalCost);
+        if(std::abs(fnorm - prevFnorm) < 1e-6) // Absolute change in cost function
+        {
+            result_.converged = true;
+            break;
+        }
+        if(std::abs((fnorm - prevFnorm) / std::max(prevFnorm, 1e-9)) < 1e-6) // Relative change in cost function
+        {
+            result_.converged = true;
+            break;
+        }
+
+        prevFnorm = fnorm;
+    }
+
+    return result_;
+}
+
+} // namespace TrueRangeMultilateration
+
+// END OF FILE //
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include "measurement_views.h"
+
+namespace TrueRangeMultilateration
+{
+
+/**
+ * @brief Stopping tolerances and damping for RangeLevenbergMarquardt
+ */
+struct LevenbergMarquardtOptions {
+    // Upper bound on accepted plus rejected steps
+    size_t maxIterations = 100;
+    // Stop when the infinity norm of the gradient J^T r falls below this value
+    double gradientTolerance = 1e-10;
+    // Stop when |dx| <= stepTolerance * (|x| + stepTolerance)
+    double stepTolerance = 1e-10;
+    // Stop when an accepted step reduces the cost by less than this fraction
+    double costTolerance = 1e-12;
+    // Initial damping, relative to the largest diagonal entry of J^T J
+    double initialDampingScale = 1e-3;
+};
+
+/**
+ * @brief Outcome of one RangeLevenbergMarquardt::minimize call
+ */
+struct LevenbergMarquardtSummary {
+    size_t iterations = 0;
+    // Fused residual/Jacobian passes over the anchors
+    size_t functionEvaluations = 0;
+    // 0.5 * sum of squared (weighted, whitened) range residuals
+    double initialCost = 0.0;
+    double finalCost = 0.0;
+    bool converged = false;
+};
+
+/**
+ * @brief Settings of RobustRangeLevenbergMarquardt
+ */
+struct RobustLevenbergMarquardtOptions {
+    // Settings of the weighted least-squares solve in each reweighting pass. The tolerances default to the
+    // sqrt(machine epsilon) scale of Eigen's LevenbergMarquardt, well below what the outer stopping rule resolves.
+    LevenbergMarquardtOptions inner = {
+        .gradientTolerance = 1e-8,
+        .stepTolerance = 1e-8,
+        .costTolerance = 1e-10,
+    };
+    size_t maxOuterIterations = 10;
+    // Continue each pass from the previous pass's damping (false re-initialises it every pass)
+    bool warmStart = true;
+};
+
+/**
+ * @brief Estimate and diagnostics of the IRLS robust solver
+ */
+struct RobustLevenbergMarquardtResult {
+    Eigen::Vector3d position = Eigen::Vector3d::Zero();
+    // Reweighting passes performed
+    size_t outerIterations = 0;
+    // LM iterations summed over all passes
+    size_t innerIterations = 0;
+    // Residual sweeps over the anchors, including the fused reweighting sweeps
+    size_t functionEvaluations = 0;
+    // Cauchy weights computed from the residuals at the final position
+    std::vector<double> weights;
+    // Weighted cost of the last pass
+    double finalCost = 0.0;
+    // True when the cost change between passes fell below tolerance before maxOuterIterations
+    bool converged = false;
+};
+
+/**
+ * @brief Levenberg-Marquardt engine specialised for 3D true-range multilateration
+ *
+ * Minimises 0.5 * sum_i w_i * ((|x - p_i| - d_i) / sigma)^2 over the position x. The range Jacobian is analytic
+ * and the 3x3 normal equations are accumulated directly in one pass over the anchors, so no Jacobian matrix or
+ * other dynamic-size buffer is formed and an iteration performs exactly one residual sweep.
+ *
+ * The damping parameter is kept between minimize() calls unless resetDamping() is called, which lets
+ * successive related problems (e.g. IRLS reweighting passes) continue from the previous trust region.
+ */
+class RangeLevenbergMarquardt {
+  public:
+    explicit RangeLevenbergMarquardt(const LevenbergMarquardtOptions& options = LevenbergMarquardtOptions{});
+
+    /**
+     * @brief Refines @p position in place
+     * @param anchorPositions
+     * @param ranges
+     * @param weights Per-range weights w_i (NOTE: empty means unit weights, otherwise weights.size() == ranges.size())
+     * @param rangeStdDev Residual whitening scale sigma
+     * @param position Initial guess on input, estimate on output
+     * @return LevenbergMarquardtSummary Iteration, evaluation and cost diagnostics
+     */
+    LevenbergMarquardtSummary minimize(
+        const std::vector<Eigen::Vector3d>& anchorPositions,
+        const std::vector<double>& ranges,
+        const std::vector<double>& weights,
+        double rangeStdDev,
+        Eigen::Vector3d& position
+    );
+
+    /**
+     * @brief minimize() over caller-owned (possibly strided or float) anchor and range memory, without copying it
+     */
+    LevenbergMarquardtSummary minimize(
+        const AnchorPositionsView& anchorPositions,
+        const RangesView& ranges,
+        const std::vector<double>& weights,
+        double rangeStdDev,
+        Eigen::Vector3d& position
+    );
+
+    void resetDamping() { damping_ = 0.0; }
+    [[nodiscard]] double damping() const { return damping_; }
+    [[nodiscard]] const LevenbergMarquardtOptions& options() const { return options_; }
+
+  private:
+    template<typename Anchors, typename Ranges>
+    LevenbergMarquardtSummary minimizeImpl(
+        const Anchors& anchorPositions,
+        const Ranges& ranges,
+        const std::vector<double>& weights,
+        double rangeStdDev,
+        Eigen::Vector3d& position
+    );
+
+
+    LevenbergMarquardtOptions options_;
+    // Zero until the first minimize() call initialises it from J^T J
+    double damping_ = 0.0;
+};
+
+/**
+ * @brief Iteratively reweighted least squares with Cauchy weights w_i = 1 / (1 + (r_i / c)^2)
+ *
+ * Each pass runs the same damped iterations as RangeLevenbergMarquardt on the weighted problem. The sweep that
+ * computes new weights from the residuals at the pass's solution also accumulates the next pass's normal equations,
+ * so a reweighting costs one residual sweep in total. With warmStart the damping parameter carries over between
+ * passes (and between minimize() calls until resetDamping()); the weight buffer is reused across calls.
+ * Stops when the weighted residual norm changes by less than 1e-6 (absolute or relative) between passes,
+ * as robustNonLinearLeastSquaresEigenLevenbergMarquardt does.
+ */
+class RobustRangeLevenbergMarquardt {
+  public:
+    explicit RobustRangeLevenbergMarquardt(const RobustLevenbergMarquardtOptions& options = RobustLevenbergMarquardtOptions{});
+
+    /**
+     * @brief Runs the reweighting passes from @p initialPosition
+     * @param anchorPositions
+     * @param ranges
+     * @param rangeStdDev Residual whitening scale sigma
+     * @param robustLossParam Cauchy scale c, in units of sigma
+     * @param initialPosition
+     * @return const RobustLevenbergMarquardtResult& Valid until the next minimize() call
+     */
+    const RobustLevenbergMarquardtResult& minimize(
+        const std::vector<Eigen::Vector3d>& anchorPositions,
+        const std::vector<double>& ranges,
+        double rangeStdDev,
+        double robustLossParam,
+        const Eigen::Vector3d& initialPosition
+    );
+
+    /**
+     * @brief minimize() over caller-owned (possibly strided or float) anchor and range memory, without copying it
+     */
+    const RobustLevenbergMarquardtResult& minimize(
+        const AnchorPositionsView& anchorPositions,
+        const RangesView& ranges,
+        double rangeStdDev,
+        double robustLossParam,
+        const Eigen::Vector3d& initialPosition
+    );
+
+    void resetDamping() { damping_ = 0.0; }
+    [[nodiscard]] double damping() const { return damping_; }
+    [[nodiscard]] const RobustLevenbergMarquardtOptions& options() const { return options_; }
+
+  private:
+    template<typename Anchors, typename Ranges>
+    const RobustLevenbergMarquardtResult& minimizeImpl(
+        const Anchors& anchorPositions,
+        const Ranges& ranges,
+        double rangeStdDev,
+        double robustLossParam,
+        const Eigen::Vector3d& initialPosition
+    );
+
+
+    RobustLevenbergMarquardtOptions options_;
+    double damping_ = 0.0;
+    RobustLevenbergMarquardtResult result_;
+};
+
+} // namespace TrueRangeMultilateration
+
+
+// END OF FILE //
@@ -0,0 +1,264 @@
+#include "range_tracker.h"
+#include "true_range_multilateration_methods.h"
+
+#include <cmath>
+#include <format>
+#include <stdexcept>
+
+namespace // anonymous namespace for helper functions
+{
+    // Below this distance to an anchor the range direction is undefined and the range is skipped
+    constexpr double minimumAnchorDistance = 1e-9;
+
+    // Weak per-axis prior (m) added to a standalone fix's information, so a degenerate direction such as the
+    // normal of a coplanar anchor set gets a large but finite variance instead of an infinite one
+    constexpr double initialPositionPriorStdDev = 100.0;
+
+    // Fixes whose J^T J is this ill-conditioned are not fused; the ranges are applied one by one instead
+    constexpr double minimumFixReciprocalCondition = 1e-9;
+
+    // sum_i u_i u_i^T with u_i the unit vector from anchor i to position, i.e. J^T J of the range residuals
+    template<typename Anchors>
+    Eigen::Matrix3d rangeInformation(const Anchors& anchorPositions, const Eigen::Vector3d& position)
+    {
+        Eigen::Matrix3d information = Eigen::Matrix3d::Zero();
+        for(size_t i = 0; i < anchorPositions.size(); ++i)
+        {
+            const Eigen::Vector3d delta = position - anchorPositions[i];
+            const double distance = delta.norm();
+            if(distance > minimumAnchorDistance)
+            {
+                const Eigen::Vector3d u_i = delta / distance;
+                information.noalias() += u_i * u_i.transpose();
+            }
+        }
+        return information;
+    }
+
+} // namespace anonymous
+
+namespace TrueRangeMultilateration
+{
+
+RangeTracker::RangeTracker(const RangeTrackerOptions& options)
+: options_(options), levenbergMarquardt_(options.levenbergMarquardt)
+{
+    // empty
+}
+
+RangeTrackerUpdate RangeTracker::update(
+    double timestamp,
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges
+)
+{
+    if(anchorPositions.size() != ranges.size())
+    {
+        throw std::invalid_argument(std::format(
+            "{} ranges were supplied for {} anchors.",
+            ranges.size(),
+            anchorPositions.size()
+        ));
+    }
+
+    RangeTrackerUpdate result;
+    if(!initialised_)
+    {
+        initialise(timestamp, anchorPositions, ranges, result);
+        result.position = position();
+        return result;
+    }
+
+    predict(timestamp);
+    if(!options_.levenbergMarquardtRefinement || !fuseLevenbergMarquardtFix(anchorPositions, ranges, result))
+    {
+        visitMeasurements(
+            [&](const auto& anchorSpan, const auto& rangeSpan) {
+                applyRanges(anchorSpan, rangeSpan, result);
+            },
+            anchorPositions, ranges);
+    }
+
+    result.position = position();
+    return result;
+}
+
+void RangeTracker::predict(double timestamp)
+{
+    if(!initialised_)
+    {
+        throw std::logic_error("The range tracker cannot predict before its first update.");
+    }
+    const double dt = timestamp - timestamp_;
+    if(dt < 0.0)
+    {
+        throw std::invalid_argument(std::format(
+            "Timestamp {} precedes the tracker's current time {}.",
+            timestamp,
+            timestamp_
+        ));
+    }
+
+    // Constant velocity: x' = F x, P' = F P F^T + Q with F = [I, dt I; 0, I]
+    state_.head<3>() += dt * state_.tail<3>();
+
+    StateCovariance F = StateCovariance::Identity();
+    F.topRightCorner<3, 3>().diagonal().setConstant(dt);
+    covariance_ = F * covariance_ * F.transpose();
+
+    // Discretised white-acceleration noise of spectral density q, per axis
+    const double q = options_.accelerationNoiseDensity;
+    const double dt2 = dt * dt;
+    covariance_.topLeftCorner<3, 3>().diagonal().array() += q * dt2 * dt / 3.0;
+    covariance_.topRightCorner<3, 3>().diagonal().array() += q * dt2 / 2.0;
+    covariance_.bottomLeftCorner<3, 3>().diagonal().array() += q * dt2 / 2.0;
+    covariance_.bottomRightCorner<3, 3>().diagonal().array() += q * dt;
+
+    timestamp_ = timestamp;
+}
+
+bool RangeTracker::updateRange(const Eigen::Vector3d& anchorPosition, double range)
+{
+    if(!initialised_)
+    {
+        throw std::logic_error("The range tracker cannot apply a range before its first update.");
+    }
+
+    const Eigen::Vector3d delta = position() - anchorPosition;
+    const double predictedRange = delta.norm();
+    if(predictedRange <= minimumAnchorDistance)
+    {
+        return false;
+    }
+
+    // H = [u^T, 0] with u the unit vector from the anchor, so P H^T is the first three columns times u
+    const Eigen::Vector3d u = delta / predictedRange;
+    const StateVector PHt = covariance_.leftCols<3>() * u;
+    const double variance = options_.rangeStdDev * options_.rangeStdDev;
+    const double innovationVariance = u.dot(PHt.head<3>()) + variance;
+    const double innovation = range - predictedRange;
+    if(innovation * innovation > options_.innovationGate * options_.innovationGate * innovationVariance)
+    {
+        return false;
+    }
+
+    const StateVector K = PHt / innovationVariance;
+    state_ += K * innovation;
+
+    // Joseph form keeps P symmetric positive semi-definite through long runs of scalar updates
+    StateCovariance IKH = StateCovariance::Identity();
+    IKH.leftCols<3>().noalias() -= K * u.transpose();
+    covariance_ = IKH * covariance_ * IKH.transpose() + variance * K * K.transpose();
+    return true;
+}
+
+Eigen::Vector3d RangeTracker::predictedPosition(double timestamp) const
+{
+    return position() + (timestamp - timestamp_) * velocity();
+}
+
+void RangeTracker::initialise(
+    double timestamp,
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    RangeTrackerUpdate& result
+)
+{
+    if(ranges.size() < 4)
+    {
+        throw std::invalid_argument(std::format(
+            "The range tracker needs at least 4 ranges to initialise a track, but {} were supplied.",
+            ranges.size()
+        ));
+    }
+
+    SolveResult diagnostics;
+    const Eigen::Vector3d fix = nonLinearLeastSquaresAnalyticLevenbergMarquardt(
+        anchorPositions, ranges, options_.levenbergMarquardt, &diagnostics);
+
+    const Eigen::Matrix3d information = visitMeasurements(
+        [&](const auto& anchorSpan, const auto&) { return rangeInformation(anchorSpan, fix); },
+        anchorPositions, ranges);
+    const double variance = options_.rangeStdDev * options_.rangeStdDev;
+    const double priorVariance = initialPositionPriorStdDev * initialPositionPriorStdDev;
+    const Eigen::Matrix3d positionInformation =
+        information / variance + Eigen::Matrix3d::Identity() / priorVariance;
+
+    state_.head<3>() = fix;
+    state_.tail<3>().setZero();
+    covariance_.setZero();
+    covariance_.topLeftCorner<3, 3>() = positionInformation.ldlt().solve(Eigen::Matrix3d::Identity());
+    covariance_.bottomRightCorner<3, 3>().diagonal().setConstant(
+        options_.initialVelocityStdDev * options_.initialVelocityStdDev);
+    timestamp_ = timestamp;
+    initialised_ = true;
+
+    result.acceptedRanges = ranges.size();
+    result.iterations = diagnostics.iterations;
+    result.initialised = true;
+}
+
+bool RangeTracker::fuseLevenbergMarquardtFix(
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    RangeTrackerUpdate& result
+)
+{
+    if(ranges.size() < 4)
+    {
+        return false;
+    }
+
+    // Fresh damping each epoch: carried over from the previous epoch's converged solve it is tiny, which costs
+    // rejected steps once the start is already within the noise of the minimum
+    levenbergMarquardt_.resetDamping();
+    Eigen::Vector3d fix = position();
+    const LevenbergMarquardtSummary summary = levenbergMarquardt_.minimize(
+        anchorPositions, ranges, {}, options_.rangeStdDev, fix);
+    result.iterations = summary.iterations;
+
+    const Eigen::Matrix3d information = visitMeasurements(
+        [&](const auto& anchorSpan, const auto&) { return rangeInformation(anchorSpan, fix); },
+        anchorPositions, ranges);
+    const Eigen::LDLT<Eigen::Matrix3d> informationLdlt(information);
+    if(informationLdlt.info() != Eigen::Success || !informationLdlt.isPositive()
+        || informationLdlt.rcond() < minimumFixReciprocalCondition)
+    {
+        return false;
+    }
+
+    // Position measurement z = fix with R = sigma^2 (J^T J)^-1 and H = [I, 0]
+    const Eigen::Matrix3d R =
+        options_.rangeStdDev * options_.rangeStdDev * informationLdlt.solve(Eigen::Matrix3d::Identity());
+    const Eigen::Matrix3d S = covariance_.topLeftCorner<3, 3>() + R;
+    const Eigen::Matrix<double, 6, 3> K = covariance_.leftCols<3>() * S.ldlt().solve(Eigen::Matrix3d::Identity());
+    state_ += K * (fix - position());
+
+    StateCovariance IKH = StateCovariance::Identity();
+    IKH.leftCols<3>().noalias() -= K;
+    covariance_ = IKH * covariance_ * IKH.transpose() + K * R * K.transpose();
+
+    result.acceptedRanges = ranges.size();
+    return true;
+}
+
+template<typename Anchors, typename Ranges>
+void RangeTracker::applyRanges(const Anchors& anchorPositions, const Ranges& ranges, RangeTrackerUpdate& result)
+{
+    for(size_t i = 0; i < ranges.size(); ++i)
+    {
+        if(updateRange(anchorPositions[i], ranges[i]))
+        {
+            ++result.acceptedRanges;
+        }
+        else
+        {
+            ++result.rejectedRanges;
+        }
+    }
+}
+
+} // namespace TrueRangeMultilateration
+
+
+// END OF FILE //
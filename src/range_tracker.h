@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstddef>
+
+#include <Eigen/Dense>
+
+#include "measurement_views.h"
+#include "range_levenberg_marquardt.h"
+
+namespace TrueRangeMultilateration
+{
+
+/**
+ * @brief Motion and measurement model of RangeTracker
+ */
+struct RangeTrackerOptions {
+    // Standard deviation of each range measurement (m)
+    double rangeStdDev = 0.1;
+    // Spectral density of the white-acceleration process noise (m^2/s^3); larger values follow manoeuvres faster
+    double accelerationNoiseDensity = 0.5;
+    // Per-axis velocity standard deviation assumed when the track is initialised (m/s)
+    double initialVelocityStdDev = 1.0;
+    // A sequentially applied range whose innovation exceeds this many predicted standard deviations is
+    // rejected; infinity disables the gate
+    double innovationGate = 5.0;
+    // Solve each epoch with analytic LM seeded from the predicted position and fuse the fix, instead of
+    // applying the ranges one by one. The ranges are applied one by one if the fix's geometry is degenerate.
+    bool levenbergMarquardtRefinement = false;
+    LevenbergMarquardtOptions levenbergMarquardt;
+};
+
+/**
+ * @brief Outcome of one RangeTracker::update epoch
+ */
+struct RangeTrackerUpdate {
+    Eigen::Vector3d position = Eigen::Vector3d::Zero();
+    // Ranges applied to the filter, and ranges rejected by the innovation gate or taken at an anchor
+    size_t acceptedRanges = 0;
+    size_t rejectedRanges = 0;
+    // LM iterations spent this epoch (initialisation or refinement); 0 for sequential updates
+    size_t iterations = 0;
+    // True when this epoch (re)initialised the track from a standalone fix
+    bool initialised = false;
+};
+
+/**
+ * @brief Extended Kalman filter that tracks one tag across epochs of range measurements
+ *
+ * The state is position and velocity under a constant-velocity model driven by white acceleration. Ranges use
+ * the model of nonLinearLeastSquaresEigenLevenbergMarquardt, d_i = |x - p_i| + noise, and are applied as
+ * sequential scalar updates, each linearised at the latest estimate, so an epoch costs O(N) fixed-size work
+ * with no heap allocation.
+ *
+ * The first epoch, and the first after reset(), is solved with nonLinearLeastSquaresAnalyticLevenbergMarquardt
+ * and needs at least 4 ranges. Later epochs can have any number of ranges. With levenbergMarquardtRefinement,
+ * each epoch is instead solved by RangeLevenbergMarquardt starting from the predicted position, which skips
+ * the ordinaryLeastSquaresWikipedia2 initial guess, and the fix is fused with covariance sigma^2 (J^T J)^-1.
+ */
+class RangeTracker {
+  public:
+    using StateVector = Eigen::Matrix<double, 6, 1>;
+    using StateCovariance = Eigen::Matrix<double, 6, 6>;
+
+    explicit RangeTracker(const RangeTrackerOptions& options = RangeTrackerOptions{});
+
+    /**
+     * @brief Predicts to @p timestamp and applies one epoch of ranges
+     * @param timestamp Measurement time in seconds (NOTE: must not precede the previous epoch)
+     * @param anchorPositions
+     * @param ranges (NOTE: ranges.size() == anchorPositions.size())
+     * @return RangeTrackerUpdate Filtered position and per-epoch counts
+     * @throws std::invalid_argument on mismatched sizes, a timestamp in the past, or fewer than 4 ranges
+     *         when the track is not initialised
+     */
+    RangeTrackerUpdate update(double timestamp, const AnchorPositionsView& anchorPositions, const RangesView& ranges);
+
+    /**
+     * @brief Propagates the state and covariance to @p timestamp
+     */
+    void predict(double timestamp);
+
+    /**
+     * @brief Applies one range at the current time as a scalar EKF update
+     * @return false if the range was rejected by the innovation gate or the tag sits on the anchor
+     */
+    bool updateRange(const Eigen::Vector3d& anchorPosition, double range);
+
+    /**
+     * @brief Forgets the track; the next update() initialises it again
+     */
+    void reset() { initialised_ = false; }
+
+    /**
+     * @brief Position the constant-velocity model predicts at @p timestamp, without changing the state
+     */
+    [[nodiscard]] Eigen::Vector3d predictedPosition(double timestamp) const;
+
+    [[nodiscard]] bool initialised() const { return initialised_; }
+    [[nodiscard]] double timestamp() const { return timestamp_; }
+    [[nodiscard]] Eigen::Vector3d position() const { return state_.head<3>(); }
+    [[nodiscard]] Eigen::Vector3d velocity() const { return state_.tail<3>(); }
+    [[nodiscard]] const StateVector& state() const { return state_; }
+    [[nodiscard]] const StateCovariance& covariance() const { return covariance_; }
+    [[nodiscard]] const RangeTrackerOptions& options() const { return options_; }
+
+  private:
+    void initialise(double timestamp, const AnchorPositionsView& anchorPositions, const RangesView& ranges,
+        RangeTrackerUpdate& result);
+
+    // Solves the epoch from the predicted position and fuses the fix; false if its geometry is degenerate
+    bool fuseLevenbergMarquardtFix(const AnchorPositionsView& anchorPositions, const RangesView& ranges,
+        RangeTrackerUpdate& result);
+
+    template<typename Anchors, typename Ranges>
+    void applyRanges(const Anchors& anchorPositions, const Ranges& ranges, RangeTrackerUpdate& result);
+
+    RangeTrackerOptions options_;
+    RangeLevenbergMarquardt levenbergMarquardt_;
+    StateVector state_ = StateVector::Zero();
+    StateCovariance covariance_ = StateCovariance::Identity();
+    double timestamp_ = 0.0;
+    bool initialised_ = false;
+};
+
+} // namespace TrueRangeMultilateration
+
+
+// END OF FILE //
@@ -1,15 +1,86 @@
 #include "test_helpers.h"
 
+#include "core/error_statistics.h"
+
 #include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <numbers>
 #include <format>
 #include <random>
 
+namespace // anonymous namespace for helper functions
+{
+    // SplitMix64 finaliser (S. Vigna), a bijective 64-bit mixing function
+    uint64_t splitMix64(uint64_t x)
+    {
+        x += 0x9E3779B97F4A7C15ULL;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+
+    // Element n of the SplitMix64 sequence started at key; stateless, so any element can be drawn directly
+    uint64_t splitMix64At(uint64_t key, uint64_t n)
+    {
+        return splitMix64(key + n * 0x9E3779B97F4A7C15ULL);
+    }
+
+    // Top 53 bits as a double in [0, 1)
+    double toUnitInterval(uint64_t x)
+    {
+        return static_cast<double>(x >> 11) * 0x1.0p-53;
+    }
+
+    // Uniform draws consumed per range: two for the Box-Muller pair, one outlier test, one outlier magnitude
+    constexpr uint64_t drawsPerRange = 4;
+
+    void fillNoisyRangeRows(
+        const std::vector<double>& trueRanges,
+        double rangeNoiseStdDev,
+        double rangeOutlierRatio,
+        double rangeOutlierMagnitude,
+        uint64_t key,
+        uint64_t firstRun,
+        Eigen::Index rowBegin,
+        Eigen::Index rowEnd,
+        TrueRangeMultilateration::RangeMatrix& ranges
+    )
+    {
+        const uint64_t anchorCount = trueRanges.size();
+        for(Eigen::Index col = 0; col < ranges.cols(); ++col)
+        {
+            const double trueRange = trueRanges[static_cast<size_t>(col)];
+            double* column = ranges.col(col).data();
+            for(Eigen::Index row = rowBegin; row < rowEnd; ++row)
+            {
+                const uint64_t counter = ((firstRun + static_cast<uint64_t>(row)) * anchorCount + static_cast<uint64_t>(col)) * drawsPerRange;
+
+                // Box-Muller; u1 is shifted into (0, 1] so the logarithm stays finite
+                const double u1 = 1.0 - toUnitInterval(splitMix64At(key, counter));
+                const double u2 = toUnitInterval(splitMix64At(key, counter + 1));
+                const double gaussian = std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * std::numbers::pi * u2);
+
+                const double outlierTest = toUnitInterval(splitMix64At(key, counter + 2));
+                const double outlier = toUnitInterval(splitMix64At(key, counter + 3)) * rangeOutlierMagnitude;
+
+                column[row] = trueRange + rangeNoiseStdDev * gaussian + (outlierTest < rangeOutlierRatio ? outlier : 0.0);
+            }
+        }
+    }
+
+} // namespace anonymous
+
 std::mt19937_64 makeRandomEngine(std::optional<uint64_t> seed)
 {
     return std::mt19937_64(seed.value_or(std::random_device{}()));
 }
 
+std::mt19937_64 makeRunRandomEngine(uint64_t seed, uint64_t runIndex)
+{
+    return std::mt19937_64(splitMix64(splitMix64(seed) ^ runIndex));
+}
+
 
 double generateNoisyRange(
     const Eigen::Vector3d& truePosition,
@@ -106,6 +177,138 @@ std::vector<double> generateNoisyRanges(
 }
 
 
+void fillNoisyRangeBlock(
+    const Eigen::Vector3d& truePosition,
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    double rangeNoiseStdDev,
+    double rangeOutlierRatio,
+    double rangeOutlierMagnitude,
+    uint64_t seed,
+    uint64_t firstRun,
+    TrueRangeMultilateration::RangeMatrix& ranges,
+    TrueRangeMultilateration::ThreadPool* pool
+)
+{
+    ranges.resize(ranges.rows(), static_cast<Eigen::Index>(anchorPositions.size()));
+
+    std::vector<double> trueRanges;
+    trueRanges.reserve(anchorPositions.size());
+    for(const Eigen::Vector3d& anchorPos : anchorPositions)
+    {
+        trueRanges.push_back((truePosition - anchorPos).norm());
+    }
+
+    const uint64_t key = splitMix64(seed);
+    auto fillRows = [&](size_t rowBegin, size_t rowEnd) {
+        fillNoisyRangeRows(
+            trueRanges, rangeNoiseStdDev, rangeOutlierRatio, rangeOutlierMagnitude, key, firstRun,
+            static_cast<Eigen::Index>(rowBegin), static_cast<Eigen::Index>(rowEnd), ranges
+        );
+    };
+
+    if(pool != nullptr)
+    {
+        pool->parallelFor(0, static_cast<size_t>(ranges.rows()), fillRows);
+    }
+    else
+    {
+        fillRows(0, static_cast<size_t>(ranges.rows()));
+    }
+}
+
+
+TrueRangeMultilateration::RangeMatrix generateNoisyRangeBlock(
+    const TrueRangeMultilateration::TestParameters& params,
+    uint64_t seed,
+    uint64_t firstRun,
+    size_t runCount,
+    TrueRangeMultilateration::ThreadPool* pool
+)
+{
+    TrueRangeMultilateration::RangeMatrix ranges(static_cast<Eigen::Index>(runCount), static_cast<Eigen::Index>(params.anchorPositions.size()));
+    fillNoisyRangeBlock(
+        params.truePosition,
+        params.anchorPositions,
+        params.rangeNoiseStdDev,
+        params.rangeOutlierRatio,
+        params.rangeOutlierMagnitude,
+        seed,
+        firstRun,
+        ranges,
+        pool
+    );
+    return ranges;
+}
+
+
+std::vector<TrueRangeMultilateration::RangeMeasurement> generateTrackerRangeEpoch(
+    const std::vector<Eigen::Vector3d>& tagPositions,
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    double rangeNoiseStdDev,
+    double timestamp,
+    double timestampJitter,
+    std::mt19937_64& rng
+)
+{
+    std::vector<TrueRangeMultilateration::RangeMeasurement> measurements;
+    measurements.reserve(tagPositions.size() * anchorPositions.size());
+
+    std::uniform_real_distribution<double> jitter(0.0, timestampJitter);
+    for(size_t tag = 0; tag < tagPositions.size(); ++tag)
+    {
+        const std::vector<double> ranges = generateNoisyRanges(tagPositions[tag], anchorPositions, rangeNoiseStdDev, rng);
+        for(size_t anchor = 0; anchor < anchorPositions.size(); ++anchor)
+        {
+            measurements.push_back({
+                static_cast<uint32_t>(tag),
+                static_cast<uint32_t>(anchor),
+                timestamp + jitter(rng),
+                ranges[anchor]
+            });
+        }
+    }
+
+    // Gateways report independently, so neither tags nor anchors arrive in order
+    std::shuffle(measurements.begin(), measurements.end(), rng);
+    return measurements;
+}
+
+
+uint64_t writeSyntheticRangeLog(
+    TrueRangeMultilateration::RangeLogWriter& writer,
+    const std::vector<Eigen::Vector3d>& tagPositions,
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    double rangeNoiseStdDev,
+    size_t epochCount,
+    double epochInterval,
+    std::mt19937_64& rng
+)
+{
+    std::vector<TrueRangeMultilateration::RangeLogRecord> round(anchorPositions.size());
+    for(size_t epoch = 0; epoch < epochCount; ++epoch)
+    {
+        const double timestamp = static_cast<double>(epoch) * epochInterval;
+        for(size_t tag = 0; tag < tagPositions.size(); ++tag)
+        {
+            const std::vector<double> ranges = generateNoisyRanges(tagPositions[tag], anchorPositions, rangeNoiseStdDev, rng);
+            for(size_t anchor = 0; anchor < anchorPositions.size(); ++anchor)
+            {
+                round[anchor] = {
+                    timestamp,
+                    static_cast<uint32_t>(tag),
+                    static_cast<uint16_t>(anchor),
+                    TrueRangeMultilateration::rangeLogHasStdDev,
+                    static_cast<float>(ranges[anchor]),
+                    static_cast<float>(rangeNoiseStdDev)
+                };
+            }
+            writer.write(round);
+        }
+    }
+    return epochCount * tagPositions.size() * anchorPositions.size();
+}
+
+
 Eigen::Vector3d generateNoisyAnchorPosition(
     const Eigen::Vector3d& trueAnchorPosition,
     double anchorPosNoiseStdDev,
@@ -198,52 +401,13 @@ TrueRangeMultilateration::TestResults computeResults(
     const TrueRangeMultilateration::TestParameters& params
 )
 {
-    TrueRangeMultilateration::TestResults results;
-    if (estimatedPositions.empty())
-    {
-        return results;
-    }
-
-    Eigen::Vector3d meanSignedError = Eigen::Vector3d::Zero();
-    Eigen::Vector3d meanAbsError = Eigen::Vector3d::Zero();
-    Eigen::Vector3d maxError = Eigen::Vector3d::Zero();
-
+    TrueRangeMultilateration::ErrorStatisticsAccumulator accumulator(params.truePosition);
     for (const Eigen::Vector3d& estPos : estimatedPositions)
     {
-        const Eigen::Vector3d error = estPos - params.truePosition;
-        const Eigen::Vector3d absError = error.cwiseAbs();
-
-        meanSignedError += error;
-        meanAbsError += absError;
-        maxError = maxError.cwiseMax(absError);
+        accumulator.add(estPos);
     }
 
-    const double n = static_cast<double>(estimatedPositions.size());
-    meanSignedError /= n;
-    meanAbsError /= n;
-
-    Eigen::Matrix3d centeredCovariance = Eigen::Matrix3d::Zero();
-    Eigen::Matrix3d secondMoment = Eigen::Matrix3d::Zero();
-
-    for (const Eigen::Vector3d& estPos : estimatedPositions)
-    {
-        const Eigen::Vector3d error = estPos - params.truePosition;
-        const Eigen::Vector3d centeredError = error - meanSignedError;
-
-        centeredCovariance += centeredError * centeredError.transpose();
-        secondMoment += error * error.transpose();
-    }
-
-    centeredCovariance /= n;
-    secondMoment /= n;
-
-    results.meanAbsError = meanAbsError;
-    results.meanSignedError = meanSignedError;
-    results.maxError = maxError;
-    results.errorCovariance = centeredCovariance;
-    results.errorSecondMoment = secondMoment;
-
-    return results;
+    return accumulator.results();
 }
 
 
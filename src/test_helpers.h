@@ -8,9 +8,17 @@
 #include <Eigen/Dense>
 
 #include "tests.h"
+#include "batch_multilateration.h"
+#include "core/thread_pool.h"
+#include "core/range_log.h"
+#include "core/tracker_service.h"
 
 std::mt19937_64 makeRandomEngine(std::optional<uint64_t> seed);
 
+// Independent engine for one Monte Carlo run, keyed only by (seed, runIndex) so a
+// run draws the same numbers whichever thread executes it and in whatever order.
+std::mt19937_64 makeRunRandomEngine(uint64_t seed, uint64_t runIndex);
+
 double generateNoisyRange(
     const Eigen::Vector3d& truePosition,
     const Eigen::Vector3d& anchorPosition,
@@ -48,6 +56,56 @@ std::vector<double> generateNoisyRanges(
     std::mt19937_64& rng
 );
 
+// Fills a runs x anchors block of noisy ranges (one row per run, RangeMatrix layout) for runs
+// [firstRun, firstRun + ranges.rows()). Draws the same noise and outlier model as generateNoisyRanges,
+// but from a counter-based SplitMix64 stream keyed by (seed, run, anchor) instead of a sequential engine,
+// so the block is reproducible from the seed and independent of how it is split across calls or threads.
+// The inner loops run branch-free down each contiguous anchor column. pool, if given, splits the runs.
+void fillNoisyRangeBlock(
+    const Eigen::Vector3d& truePosition,
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    double rangeNoiseStdDev,
+    double rangeOutlierRatio,
+    double rangeOutlierMagnitude,
+    uint64_t seed,
+    uint64_t firstRun,
+    TrueRangeMultilateration::RangeMatrix& ranges,
+    TrueRangeMultilateration::ThreadPool* pool = nullptr
+);
+
+TrueRangeMultilateration::RangeMatrix generateNoisyRangeBlock(
+    const TrueRangeMultilateration::TestParameters& params,
+    uint64_t seed,
+    uint64_t firstRun,
+    size_t runCount,
+    TrueRangeMultilateration::ThreadPool* pool = nullptr
+);
+
+// One epoch of synthetic gateway traffic for TrackerService: every anchor ranges every tag (tag ID = index into
+// tagPositions) with generateNoisyRanges noise, each at timestamp plus a uniform jitter in [0, timestampJitter),
+// and the measurements are shuffled so they arrive out of order across tags and anchors.
+std::vector<TrueRangeMultilateration::RangeMeasurement> generateTrackerRangeEpoch(
+    const std::vector<Eigen::Vector3d>& tagPositions,
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    double rangeNoiseStdDev,
+    double timestamp,
+    double timestampJitter,
+    std::mt19937_64& rng
+);
+
+// Appends epochCount epochs, epochInterval seconds apart, to a range log. Each epoch writes one ranging round per
+// tag (tag ID = index into tagPositions) as a contiguous run of generateNoisyRanges ranges from every anchor, and
+// every record carries rangeNoiseStdDev. Returns the number of records written.
+uint64_t writeSyntheticRangeLog(
+    TrueRangeMultilateration::RangeLogWriter& writer,
+    const std::vector<Eigen::Vector3d>& tagPositions,
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    double rangeNoiseStdDev,
+    size_t epochCount,
+    double epochInterval,
+    std::mt19937_64& rng
+);
+
 Eigen::Vector3d generateNoisyAnchorPosition(
     const Eigen::Vector3d& trueAnchorPosition,
     double anchorPosNoiseStdDev,
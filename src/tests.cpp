@@ -1,14 +1,44 @@
 #include "tests.h"
 #include "test_helpers.h"
 #include "true_range_multilateration_methods.h"
+#include "anchor_geometry.h"
+#include "crlb_grid.h"
+#include "incremental_least_squares.h"
+#include "mixed_precision.h"
+#include "range_levenberg_marquardt.h"
+#include "range_tracker.h"
+#include "core/algorithm_dispatch.h"
+#include "core/allocation_tracker.h"
+#include "core/common_random_numbers.h"
+#include "core/error_statistics.h"
+#include "core/mpsc_queue.h"
+#include "core/parameter_sweep.h"
+#include "core/range_log.h"
+#include "core/result_sink.h"
 #include "core/simulation_runner.h"
+#include "core/tracker_service.h"
+#include "core/work_stealing_pool.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <cmath>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <format>
+#include <functional>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <utility>
 
 #include <Eigen/Dense>
 
@@ -65,6 +95,117 @@ void runComputeResultsValidationTests()
     std::cout << "computeResults validation tests passed.\n" << std::flush;
 }
 
+void runErrorStatisticsAccumulatorValidationTests()
+{
+    std::mt19937_64 rng = makeRandomEngine(777);
+    std::normal_distribution<double> noiseDist(0.0, 0.3);
+    const Eigen::Vector3d truePosition(1.0e3, -2.0e3, 5.0);
+    const Eigen::Vector3d bias(0.2, -0.1, 0.05);
+
+    std::vector<Eigen::Vector3d> estimatedPositions;
+    for (size_t i = 0; i < 1001; ++i) {
+        estimatedPositions.push_back(truePosition + bias + Eigen::Vector3d(noiseDist(rng), noiseDist(rng), noiseDist(rng)));
+    }
+
+    // Two-pass reference
+    Eigen::Vector3d mean = Eigen::Vector3d::Zero();
+    Eigen::Vector3d meanAbs = Eigen::Vector3d::Zero();
+    Eigen::Vector3d maxAbs = Eigen::Vector3d::Zero();
+    for (const Eigen::Vector3d& estimate : estimatedPositions) {
+        const Eigen::Vector3d error = estimate - truePosition;
+        mean += error;
+        meanAbs += error.cwiseAbs();
+        maxAbs = maxAbs.cwiseMax(error.cwiseAbs());
+    }
+    const double n = static_cast<double>(estimatedPositions.size());
+    mean /= n;
+    meanAbs /= n;
+    Eigen::Matrix3d covariance = Eigen::Matrix3d::Zero();
+    Eigen::Matrix3d secondMoment = Eigen::Matrix3d::Zero();
+    for (const Eigen::Vector3d& estimate : estimatedPositions) {
+        const Eigen::Vector3d error = estimate - truePosition;
+        covariance += (error - mean) * (error - mean).transpose();
+        secondMoment += error * error.transpose();
+    }
+    covariance /= n;
+    secondMoment /= n;
+
+    auto assertMatchesReference = [&](const TestResults& results) {
+        assert((results.meanSignedError - mean).norm() < 1e-12);
+        assert((results.meanAbsError - meanAbs).norm() < 1e-12);
+        assert(results.maxError == maxAbs);
+        assert((results.errorCovariance - covariance).norm() < 1e-12);
+        assert((results.errorSecondMoment - secondMoment).norm() < 1e-12);
+        assert((results.errorCovariance - results.errorCovariance.transpose()).norm() < 1e-15);
+    };
+
+    ErrorStatisticsAccumulator singlePass(truePosition);
+    for (const Eigen::Vector3d& estimate : estimatedPositions) {
+        singlePass.add(estimate);
+    }
+    assert(singlePass.count() == estimatedPositions.size());
+    assertMatchesReference(singlePass.results());
+
+    // Uneven partial accumulators, as produced by different threads, merge to the same statistics
+    const size_t splits[] = {0, 1, 400, 1001};
+    ErrorStatisticsAccumulator merged(truePosition);
+    merged.merge(ErrorStatisticsAccumulator(truePosition));
+    for (size_t part = 0; part + 1 < std::size(splits); ++part) {
+        ErrorStatisticsAccumulator partial(truePosition);
+        for (size_t i = splits[part]; i < splits[part + 1]; ++i) {
+            partial.add(estimatedPositions[i]);
+        }
+        merged.merge(partial);
+    }
+    assert(merged.count() == estimatedPositions.size());
+    assertMatchesReference(merged.results());
+
+    merged.reset();
+    assert(merged.count() == 0);
+    assert(merged.results().errorSecondMoment.isZero());
+
+    // Dropping per-run storage leaves the runner's results unchanged
+    TestParameters params;
+    params.truePosition = Eigen::Vector3d(0.25, -0.4, 0.75);
+    params.anchorPositions = {
+        Eigen::Vector3d(-2.0, -2.0, -1.0),
+        Eigen::Vector3d( 2.0, -2.0,  0.5),
+        Eigen::Vector3d(-2.0,  2.0,  1.0),
+        Eigen::Vector3d( 2.0,  2.0,  2.0),
+    };
+    params.rangeNoiseStdDev = 0.05;
+    params.randomSeed = 4321;
+    params.numRuns = 300;
+    params.algorithm = AlgorithmId::LinearLeastSquaresIYueWang;
+    for (const ExecutionMode mode : {ExecutionMode::Serial, ExecutionMode::Parallel}) {
+        params.executionMode = mode;
+        params.numThreads = 3;
+
+        auto runToCompletion = [](const TestParameters& runParams) {
+            SimulationRunner runner;
+            runner.begin(runParams);
+            while (runner.status() == SimulationRunner::Status::Running) {
+                runner.step(64);
+            }
+            assert(runner.status() == SimulationRunner::Status::Completed);
+            return std::make_pair(runner.results(), runner.estimatedPositions().size());
+        };
+
+        params.keepEstimates = true;
+        const auto [keptResults, keptCount] = runToCompletion(params);
+        params.keepEstimates = false;
+        const auto [streamedResults, streamedCount] = runToCompletion(params);
+
+        assert(keptCount == params.numRuns);
+        assert(streamedCount == 0);
+        assert(streamedResults.meanSignedError == keptResults.meanSignedError);
+        assert(streamedResults.errorCovariance == keptResults.errorCovariance);
+        assert(streamedResults.maxError == keptResults.maxError);
+    }
+
+    std::cout << "Error statistics accumulator validation tests passed.\n" << std::flush;
+}
+
 void runCrlbValidationTests()
 {
     const std::vector<Eigen::Vector3d> defaultAnchors = {
@@ -315,6 +456,225 @@ void runCrlbValidationTests()
     std::cout << "CRLB validation tests passed.\n" << std::flush;
 }
 
+void runCrlbIndependentAnchorValidationTests()
+{
+    const std::vector<Eigen::Vector3d> anchors = {
+        Eigen::Vector3d(-6.0, -4.0, 0.5),
+        Eigen::Vector3d( 7.0, -5.0, 3.0),
+        Eigen::Vector3d(-5.0,  6.0, 2.5),
+        Eigen::Vector3d( 4.0,  5.0, 0.0),
+        Eigen::Vector3d( 0.5, -1.0, 4.0),
+        Eigen::Vector3d( 9.0,  1.0, 1.0),
+    };
+    const Eigen::Vector3d evaluationPosition(0.7, 0.4, 1.3);
+    constexpr double rangeStdDev = 0.2;
+    const size_t anchorCount = anchors.size();
+    const Eigen::Index covarianceDimension = 3 * static_cast<Eigen::Index>(anchorCount);
+
+    std::vector<Eigen::Matrix3d> blocks(anchorCount);
+    Eigen::MatrixXd stackedCovariance = Eigen::MatrixXd::Zero(covarianceDimension, covarianceDimension);
+    for (size_t i = 0; i < anchorCount; ++i) {
+        Eigen::Matrix3d root;
+        root << 0.1 + 0.02 * i, 0.03, 0.0,
+                -0.02, 0.2, 0.01 * i,
+                0.05, 0.0, 0.15;
+        blocks[i] = root * root.transpose();
+        stackedCovariance.block<3, 3>(3 * i, 3 * i) = blocks[i];
+    }
+
+    // Dense reference S = sigma_r^2 I + B C_a B^T, J = U^T S^-1 U, as the general overload used to compute it
+    auto denseReferenceInformation = [&](const Eigen::MatrixXd& covariance) {
+        Eigen::MatrixXd U(anchorCount, 3);
+        Eigen::MatrixXd B = Eigen::MatrixXd::Zero(anchorCount, covarianceDimension);
+        for (Eigen::Index i = 0; i < static_cast<Eigen::Index>(anchorCount); ++i) {
+            const Eigen::Vector3d u = (evaluationPosition - anchors[static_cast<size_t>(i)]).normalized();
+            U.row(i) = u.transpose();
+            B.block<1, 3>(i, 3 * i) = -u.transpose();
+        }
+        const Eigen::MatrixXd S = rangeStdDev * rangeStdDev
+            * Eigen::MatrixXd::Identity(anchorCount, anchorCount)
+            + B * covariance * B.transpose();
+        const Eigen::Matrix3d J = U.transpose() * S.llt().solve(U);
+        return Eigen::Matrix3d(0.5 * (J + J.transpose()));
+    };
+    auto assertMatchesReference = [&](const CrlbResult& result, const Eigen::MatrixXd& covariance) {
+        const Eigen::Matrix3d expectedInformation = denseReferenceInformation(covariance);
+        assert(result.valid);
+        assert(result.rank == 3);
+        assert(!result.usedPseudoInverse);
+        assert(result.warning.empty());
+        assert((result.fisherInformation - expectedInformation).norm() <= 1e-12 * expectedInformation.norm());
+        const Eigen::Matrix3d expectedCrlb = expectedInformation.inverse();
+        assert((result.crlb - expectedCrlb).norm() <= 1e-12 * expectedCrlb.norm());
+    };
+
+    // Per-anchor blocks, the same blocks stacked into a 3N x 3N matrix, and the isotropic scalar
+    const CrlbResult blockResult = calculateRangePositionCrlb(anchors, evaluationPosition, rangeStdDev, blocks);
+    const CrlbResult stackedResult = calculateRangePositionCrlb(anchors, evaluationPosition, rangeStdDev, stackedCovariance);
+    assertMatchesReference(blockResult, stackedCovariance);
+    assertMatchesReference(stackedResult, stackedCovariance);
+    assert((blockResult.crlb - stackedResult.crlb).norm() <= 1e-12 * blockResult.crlb.norm());
+
+    constexpr double anchorPositionStdDev = 0.3;
+    const CrlbResult isotropicResult = calculateRangePositionCrlb(anchors, evaluationPosition, rangeStdDev, anchorPositionStdDev);
+    assertMatchesReference(
+        isotropicResult,
+        anchorPositionStdDev * anchorPositionStdDev * Eigen::MatrixXd::Identity(covarianceDimension, covarianceDimension)
+    );
+
+    // Rank deficiency and skipped anchors are reported as by the general overload
+    std::vector<Eigen::Vector3d> coincidentAnchors(anchors.begin(), anchors.begin() + 3);
+    coincidentAnchors.push_back(evaluationPosition);
+    std::vector<Eigen::Matrix3d> coincidentBlocks(blocks.begin(), blocks.begin() + 4);
+    Eigen::MatrixXd coincidentCovariance = Eigen::MatrixXd::Zero(12, 12);
+    for (size_t i = 0; i < 4; ++i) {
+        coincidentCovariance.block<3, 3>(3 * i, 3 * i) = coincidentBlocks[i];
+    }
+    const CrlbResult coincidentBlockResult = calculateRangePositionCrlb(coincidentAnchors, evaluationPosition, rangeStdDev, coincidentBlocks);
+    const CrlbResult coincidentStackedResult = calculateRangePositionCrlb(coincidentAnchors, evaluationPosition, rangeStdDev, coincidentCovariance);
+    assert(coincidentBlockResult.valid && coincidentBlockResult.usedPseudoInverse);
+    assert(coincidentBlockResult.rank == coincidentStackedResult.rank);
+    assert(coincidentBlockResult.warning == coincidentStackedResult.warning);
+    assert((coincidentBlockResult.crlb - coincidentStackedResult.crlb).norm() <= 1e-12 * coincidentStackedResult.crlb.norm());
+
+    // Block validation mirrors the stacked covariance
+    auto assertInvalidBlocks = [&](const std::vector<Eigen::Matrix3d>& invalidBlocks) {
+        const CrlbResult invalidResult = calculateRangePositionCrlb(anchors, evaluationPosition, rangeStdDev, invalidBlocks);
+        assert(!invalidResult.valid);
+        assert(!invalidResult.warning.empty());
+    };
+    assertInvalidBlocks(std::vector<Eigen::Matrix3d>(blocks.begin(), blocks.end() - 1));
+    std::vector<Eigen::Matrix3d> nanBlocks = blocks;
+    nanBlocks[2](1, 1) = std::numeric_limits<double>::quiet_NaN();
+    assertInvalidBlocks(nanBlocks);
+    std::vector<Eigen::Matrix3d> nonsymmetricBlocks = blocks;
+    nonsymmetricBlocks[1](0, 2) += 1.0;
+    assertInvalidBlocks(nonsymmetricBlocks);
+    std::vector<Eigen::Matrix3d> indefiniteBlocks = blocks;
+    indefiniteBlocks[3] = -Eigen::Matrix3d::Identity();
+    assertInvalidBlocks(indefiniteBlocks);
+    std::vector<Eigen::Matrix3d> roundoffBlocks(anchorCount, Eigen::Matrix3d::Zero());
+    roundoffBlocks[0](0, 0) = -1e-12;
+    assert(calculateRangePositionCrlb(anchors, evaluationPosition, rangeStdDev, roundoffBlocks).valid);
+    assert(!calculateRangePositionCrlb(anchors, evaluationPosition, -1.0, blocks).valid);
+
+    std::cout << "CRLB independent-anchor fast path validation tests passed.\n" << std::flush;
+}
+
+void runCrlbGridValidationTests()
+{
+    const std::vector<Eigen::Vector3d> anchors = {
+        Eigen::Vector3d(-5.0, -5.0, 0.0),
+        Eigen::Vector3d( 5.0, -5.0, 3.0),
+        Eigen::Vector3d(-5.0,  5.0, 3.0),
+        Eigen::Vector3d( 5.0,  5.0, 0.0),
+        Eigen::Vector3d( 0.0,  0.0, 4.0),
+    };
+    constexpr double rangeStdDev = 0.1;
+
+    // Includes a cell on anchor 0, which is skipped for that cell
+    CrlbGridSpec grid;
+    grid.origin = Eigen::Vector3d(-5.0, -5.0, 0.0);
+    grid.spacing = Eigen::Vector3d(2.5, 2.0, 1.5);
+    grid.countX = 5;
+    grid.countY = 6;
+    grid.countZ = 3;
+
+    const size_t anchorCount = anchors.size();
+    Eigen::MatrixXd blockDiagonalCovariance = Eigen::MatrixXd::Zero(3 * anchorCount, 3 * anchorCount);
+    for (size_t i = 0; i < anchorCount; ++i) {
+        Eigen::Matrix3d block;
+        block << 0.02 + 0.01 * i, 0.004, -0.002,
+                 0.004, 0.03, 0.001,
+                 -0.002, 0.001, 0.05;
+        blockDiagonalCovariance.block<3, 3>(3 * i, 3 * i) = block * 0.1;
+    }
+    Eigen::MatrixXd correlatedCovariance = blockDiagonalCovariance;
+    correlatedCovariance.block<3, 3>(0, 3) = 0.001 * Eigen::Matrix3d::Identity();
+    correlatedCovariance.block<3, 3>(3, 0) = 0.001 * Eigen::Matrix3d::Identity();
+
+    auto checkAgainstPointwise = [&](
+        const CrlbGridEvaluator& evaluator,
+        const std::function<CrlbResult(const Eigen::Vector3d&)>& pointwise
+    ) {
+        assert(evaluator.valid());
+        ThreadPool pool(3);
+        const CrlbGridResult result = evaluator.evaluate(grid);
+        const CrlbGridResult threadedResult = evaluator.evaluate(grid, &pool);
+        assert(result.crlb == threadedResult.crlb);
+        assert(static_cast<size_t>(result.crlb.rows()) == grid.cellCount());
+
+        for (size_t cell = 0; cell < grid.cellCount(); ++cell) {
+            const CrlbResult expected = pointwise(grid.cellPosition(cell));
+            const auto row = result.crlb.row(static_cast<Eigen::Index>(cell));
+            Eigen::Matrix3d crlb;
+            crlb << row(0), row(3), row(4),
+                    row(3), row(1), row(5),
+                    row(4), row(5), row(2);
+            assert(result.rank[cell] == expected.rank);
+            assert((crlb - expected.crlb).norm() <= 1e-9 * std::max(1.0, expected.crlb.norm()));
+            assert(std::abs(result.positionErrorBound(static_cast<Eigen::Index>(cell)) - std::sqrt(expected.crlb.trace())) <= 1e-9);
+        }
+    };
+
+    const CrlbGridEvaluator exactEvaluator(anchors, rangeStdDev);
+    assert(exactEvaluator.blockDiagonal());
+    checkAgainstPointwise(exactEvaluator, [&](const Eigen::Vector3d& x) {
+        return calculateRangePositionCrlb(anchors, x, rangeStdDev);
+    });
+
+    const CrlbGridEvaluator isotropicEvaluator(anchors, rangeStdDev, 0.05);
+    checkAgainstPointwise(isotropicEvaluator, [&](const Eigen::Vector3d& x) {
+        return calculateRangePositionCrlb(anchors, x, rangeStdDev, 0.05);
+    });
+
+    const CrlbGridEvaluator blockEvaluator(anchors, rangeStdDev, blockDiagonalCovariance);
+    assert(blockEvaluator.blockDiagonal());
+    checkAgainstPointwise(blockEvaluator, [&](const Eigen::Vector3d& x) {
+        return calculateRangePositionCrlb(anchors, x, rangeStdDev, blockDiagonalCovariance);
+    });
+
+    const CrlbGridEvaluator correlatedEvaluator(anchors, rangeStdDev, correlatedCovariance);
+    assert(!correlatedEvaluator.blockDiagonal());
+    checkAgainstPointwise(correlatedEvaluator, [&](const Eigen::Vector3d& x) {
+        return calculateRangePositionCrlb(anchors, x, rangeStdDev, correlatedCovariance);
+    });
+
+    // Coplanar anchors and an in-plane grid: every cell is rank deficient and uses the pseudo-inverse
+    const std::vector<Eigen::Vector3d> coplanarAnchors = {
+        Eigen::Vector3d(-5.0, -5.0, 2.0),
+        Eigen::Vector3d( 5.0, -5.0, 2.0),
+        Eigen::Vector3d(-5.0,  5.0, 2.0),
+        Eigen::Vector3d( 5.0,  5.0, 2.0),
+    };
+    CrlbGridSpec planarGrid;
+    planarGrid.origin = Eigen::Vector3d(-3.0, -3.0, 2.0);
+    planarGrid.countX = 4;
+    planarGrid.countY = 4;
+    const CrlbGridResult planarResult = CrlbGridEvaluator(coplanarAnchors, rangeStdDev).evaluate(planarGrid);
+    assert(planarResult.rankDeficientCellCount == planarGrid.cellCount());
+    for (size_t cell = 0; cell < planarGrid.cellCount(); ++cell) {
+        const CrlbResult expected = calculateRangePositionCrlb(coplanarAnchors, planarGrid.cellPosition(cell), rangeStdDev);
+        assert(planarResult.rank[cell] == expected.rank);
+        assert(std::abs(planarResult.crlb(static_cast<Eigen::Index>(cell), 0) - expected.crlb(0, 0)) <= 1e-9);
+    }
+
+    // Invalid inputs are reported rather than evaluated
+    const CrlbGridEvaluator invalidEvaluator(anchors, -1.0);
+    assert(!invalidEvaluator.valid());
+    assert(!invalidEvaluator.warning().empty());
+    bool threw = false;
+    try {
+        (void)invalidEvaluator.evaluate(grid);
+    } catch (const std::logic_error&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(!CrlbGridEvaluator(anchors, rangeStdDev, Eigen::MatrixXd::Identity(3, 3)).valid());
+
+    std::cout << "CRLB grid validation tests passed.\n" << std::flush;
+}
+
 void runSimulationAnchorNoiseRegressionTest()
 {
     TestParameters params;
@@ -369,144 +729,2557 @@ void runSimulationAnchorNoiseRegressionTest()
     std::cout << "Simulation anchor-noise regression test passed.\n" << std::flush;
 }
 
-} // namespace
+void runParallelSimulationDeterminismTest()
+{
+    TestParameters params;
+    params.truePosition = Eigen::Vector3d(0.25, -0.4, 0.75);
+    params.anchorPositions = {
+        Eigen::Vector3d(-2.0, -2.0, -1.0),
+        Eigen::Vector3d( 2.0, -2.0,  0.5),
+        Eigen::Vector3d(-2.0,  2.0,  1.0),
+        Eigen::Vector3d( 2.0,  2.0,  2.0),
+        Eigen::Vector3d( 0.0,  0.0, -2.0),
+    };
+    params.rangeNoiseStdDev = 0.05;
+    params.rangeOutlierRatio = 0.1;
+    params.rangeOutlierMagnitude = 1.0;
+    params.anchorPosNoiseStdDev = 0.02;
+    params.randomSeed = 98765;
+    params.numRuns = 257;
+    params.algorithm = AlgorithmId::LinearLeastSquaresIYueWang;
+    params.executionMode = ExecutionMode::Parallel;
+
+    auto runToCompletion = [&params](const size_t numThreads, const size_t runsPerStep) {
+        TestParameters threadParams = params;
+        threadParams.numThreads = numThreads;
+        SimulationRunner runner;
+        runner.begin(threadParams);
+        while (runner.status() == SimulationRunner::Status::Running) {
+            runner.step(runsPerStep);
+        }
+        assert(runner.status() == SimulationRunner::Status::Completed);
+        return runner.estimatedPositions();
+    };
+
+    const std::vector<Eigen::Vector3d> singleThreaded = runToCompletion(1, params.numRuns);
+    assert(singleThreaded.size() == params.numRuns);
+
+    // Run i uses only the stream keyed by (seed, i), in run order
+    for (const size_t run : {size_t{0}, size_t{100}, params.numRuns - 1}) {
+        std::mt19937_64 runRng = makeRunRandomEngine(params.randomSeed.value(), run);
+        const std::vector<double> ranges = generateNoisyRanges(
+            params.truePosition, params.anchorPositions, params.rangeNoiseStdDev,
+            params.rangeOutlierRatio, params.rangeOutlierMagnitude, runRng);
+        const std::vector<Eigen::Vector3d> estimatorAnchors =
+            generateNoisyAnchorPositions(params.anchorPositions, params.anchorPosNoiseStdDev, runRng);
+        assert(singleThreaded[run] == linearLeastSquaresI_YueWang(estimatorAnchors, ranges));
+    }
 
+    // Bit-identical for any thread count and frame size
+    assert(runToCompletion(2, 64) == singleThreaded);
+    assert(runToCompletion(4, 37) == singleThreaded);
+    assert(runToCompletion(7, 1) == singleThreaded);
 
-void runTests(const TestParameters& params)
+    std::cout << "Parallel simulation determinism test passed.\n" << std::flush;
+}
+
+void runWorkStealingPoolValidationTests()
 {
-    std::cout << "Running Tests...\n";
-    runCrlbValidationTests();
-    runSimulationAnchorNoiseRegressionTest();
-    runComputeResultsValidationTests();
+    // Lock-free ingest queue: concurrent producers, one concurrent consumer, every value exactly once
+    {
+        constexpr uint32_t producerCount = 4;
+        constexpr uint32_t valuesPerProducer = 20000;
+        BoundedMpscQueue<uint32_t> queue(1000);
+        assert(queue.capacity() == 1024);
+
+        std::vector<std::thread> producers;
+        for (uint32_t producer = 0; producer < producerCount; ++producer) {
+            producers.emplace_back([&queue, producer] {
+                for (uint32_t i = 0; i < valuesPerProducer; ++i) {
+                    while (!queue.tryPush(producer * valuesPerProducer + i)) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
 
-    TestParameters testParams = params;
-    printTestParams(testParams);
+        std::vector<uint32_t> received(producerCount * valuesPerProducer, 0);
+        // Per producer, values must come out in the order they went in
+        std::vector<int64_t> lastFromProducer(producerCount, -1);
+        for (size_t popped = 0; popped < received.size();) {
+            uint32_t value = 0;
+            if (!queue.tryPop(value)) {
+                std::this_thread::yield();
+                continue;
+            }
+            ++received[value];
+            const uint32_t producer = value / valuesPerProducer;
+            assert(static_cast<int64_t>(value % valuesPerProducer) > lastFromProducer[producer]);
+            lastFromProducer[producer] = value % valuesPerProducer;
+            ++popped;
+        }
+        for (std::thread& producer : producers) {
+            producer.join();
+        }
+        assert(std::all_of(received.begin(), received.end(), [](uint32_t count) { return count == 1; }));
+        uint32_t value = 0;
+        assert(!queue.tryPop(value));
 
-    // No ouliers
-    std::cout << std::format("\nTest Set 1 -- Std Dev: {:.2f}m, No Outliers\n", testParams.rangeNoiseStdDev);
-    std::cout << "\nTest 1.1 (Ordinary Least Squares - Wikipedia Method):\n";
-    runTest(testParams, ordinaryLeastSquaresWikipedia);
+        BoundedMpscQueue<uint32_t> small(2);
+        assert(small.tryPush(1) && small.tryPush(2) && !small.tryPush(3));
+        assert(small.tryPop(value) && value == 1 && small.tryPush(3));
+    }
+
+    // Tasks that fan out into further tasks all run before wait() returns, for any thread count
+    for (const size_t threadCount : {size_t{1}, size_t{2}, size_t{4}}) {
+        WorkStealingPool pool(threadCount);
+        assert(pool.threadCount() == threadCount);
+        std::atomic<size_t> leaves{0};
+        std::function<void(size_t)> spawn = [&](const size_t depth) {
+            if (depth == 0) {
+                leaves.fetch_add(1);
+                return;
+            }
+            for (size_t child = 0; child < 4; ++child) {
+                pool.submit([&spawn, depth] { spawn(depth - 1); });
+            }
+        };
+        for (size_t round = 0; round < 3; ++round) {
+            leaves.store(0);
+            pool.submit([&spawn] { spawn(5); });
+            pool.wait();
+            assert(leaves.load() == 1024);
+        }
 
-    std::cout << "\nTest 1.2 (Ordinary Least Squares - Wikipedia Method with BDCSVD):\n";
-    runTest(testParams, ordinaryLeastSquaresWikipedia2);
+        // The first exception reaches wait() once the other tasks have finished, and the pool stays usable
+        std::atomic<size_t> completed{0};
+        for (size_t i = 0; i < 16; ++i) {
+            pool.submit([&completed, i] {
+                if (i == 5) {
+                    throw std::runtime_error("task failed");
+                }
+                completed.fetch_add(1);
+            });
+        }
+        bool rethrown = false;
+        try {
+            pool.wait();
+        } catch (const std::runtime_error&) {
+            rethrown = true;
+        }
+        assert(rethrown && completed.load() == 15);
+        pool.submit([&completed] { completed.fetch_add(1); });
+        pool.wait();
+        assert(completed.load() == 16);
+    }
 
-    std::cout << "\nTest 1.3 (Non-Linear Least Squares - Eigen Levenberg-Marquardt):\n";
-    runTest(testParams, nonLinearLeastSquaresEigenLevenbergMarquardt);
+    std::cout << "Work-stealing pool validation tests passed.\n" << std::flush;
+}
 
-    std::cout << "\nTest 1.4 (Robust Non-Linear Least Squares - Eigen Levenberg-Marquardt):\n";
-    auto robustNllsEigenLM = std::bind(robustNonLinearLeastSquaresEigenLevenbergMarquardt,
-            std::placeholders::_1, std::placeholders::_2, testParams.rangeNoiseStdDev, 5.0
+// Deterministic non-coplanar anchor layouts of the requested size, offset from the origin.
+std::vector<Eigen::Vector3d> makeBenchmarkAnchors(size_t anchorCount, const Eigen::Vector3d& offset, std::mt19937_64& rng)
+{
+    std::uniform_real_distribution<double> coordinateDist(-10.0, 10.0);
+    std::vector<Eigen::Vector3d> anchors;
+    anchors.reserve(anchorCount);
+    for (size_t i = 0; i < anchorCount; ++i) {
+        anchors.emplace_back(
+            offset + Eigen::Vector3d(coordinateDist(rng), coordinateDist(rng), coordinateDist(rng))
         );
-    runTest(testParams, robustNllsEigenLM);
+    }
+    return anchors;
+}
 
-    std::cout << "\nTest 1.5 (Linear Least Squares - LLS-I from Y. Wang. 2015):\n";
-    runTest(testParams, linearLeastSquaresI_YueWang);
+// Two-sample Kolmogorov-Smirnov statistic, sup |F_a(x) - F_b(x)|
+double kolmogorovSmirnovStatistic(std::vector<double> a, std::vector<double> b)
+{
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+    double maxDistance = 0.0;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < a.size() && j < b.size()) {
+        const double x = std::min(a[i], b[j]);
+        while (i < a.size() && a[i] <= x) ++i;
+        while (j < b.size() && b[j] <= x) ++j;
+        const double distance = std::abs(static_cast<double>(i) / static_cast<double>(a.size())
+            - static_cast<double>(j) / static_cast<double>(b.size()));
+        maxDistance = std::max(maxDistance, distance);
+    }
+    return maxDistance;
+}
 
-    std::cout << "\nTest 1.6 (Linear Least Squares - LLS-II-2 from Y. Wang. 2015):\n";
-    runTest(testParams, linearLeastSquaresII_2_YueWang);
+void runNoisyRangeBlockValidationTests()
+{
+    std::mt19937_64 rng = makeRandomEngine(99);
+    TestParameters params;
+    params.truePosition = Eigen::Vector3d(1.0, -2.0, 0.5);
+    params.anchorPositions = makeBenchmarkAnchors(6, Eigen::Vector3d::Zero(), rng);
+    params.rangeNoiseStdDev = 0.3;
+    params.rangeOutlierRatio = 0.2;
+    params.rangeOutlierMagnitude = 4.0;
+
+    // Reproducible from the seed, and independent of how the runs are split into calls or threads
+    constexpr size_t runCount = 1000;
+    const RangeMatrix block = generateNoisyRangeBlock(params, 42, 0, runCount);
+    assert(block.rows() == static_cast<Eigen::Index>(runCount));
+    assert(block.cols() == static_cast<Eigen::Index>(params.anchorPositions.size()));
+    assert(block == generateNoisyRangeBlock(params, 42, 0, runCount));
+    assert(block != generateNoisyRangeBlock(params, 43, 0, runCount));
+
+    const RangeMatrix head = generateNoisyRangeBlock(params, 42, 0, 300);
+    const RangeMatrix tail = generateNoisyRangeBlock(params, 42, 300, runCount - 300);
+    assert(block.topRows(300) == head);
+    assert(block.bottomRows(runCount - 300) == tail);
+
+    for (const size_t threadCount : {2u, 3u}) {
+        ThreadPool pool(threadCount);
+        assert(block == generateNoisyRangeBlock(params, 42, 0, runCount, &pool));
+    }
 
-    std::cout << "\nTest 1.7 (Two-Step Weighted Linear Least Squares - LLS-I from Y. Wang. 2015):\n";
-    auto tsWeightedLLSMethod = std::bind(twoStepWeightedLinearLeastSquaresI_YueWang,
-            std::placeholders::_1, std::placeholders::_2, std::vector<double>(testParams.anchorPositions.size(), testParams.rangeNoiseStdDev)
-        );
-    runTest(testParams, tsWeightedLLSMethod);
+    // Same distribution as generateNoisyRanges, with and without outliers. The critical value
+    // 1.95 * sqrt(2 / n) is the 0.1% level of the two-sample Kolmogorov-Smirnov test.
+    constexpr size_t sampleCount = 20000;
+    for (const double outlierRatio : {0.0, 0.2}) {
+        params.rangeOutlierRatio = outlierRatio;
+        const RangeMatrix bulk = generateNoisyRangeBlock(params, 7, 0, sampleCount);
+
+        std::mt19937_64 referenceRng = makeRandomEngine(7);
+        for (size_t anchor = 0; anchor < params.anchorPositions.size(); ++anchor) {
+            const double trueRange = (params.truePosition - params.anchorPositions[anchor]).norm();
+            std::vector<double> bulkErrors(sampleCount);
+            std::vector<double> referenceErrors(sampleCount);
+            for (size_t run = 0; run < sampleCount; ++run) {
+                bulkErrors[run] = bulk(static_cast<Eigen::Index>(run), static_cast<Eigen::Index>(anchor)) - trueRange;
+                referenceErrors[run] = generateNoisyRange(params.truePosition, params.anchorPositions[anchor],
+                    params.rangeNoiseStdDev, params.rangeOutlierRatio, params.rangeOutlierMagnitude, referenceRng) - trueRange;
+            }
+
+            const double criticalDistance = 1.95 * std::sqrt(2.0 / static_cast<double>(sampleCount));
+            assert(kolmogorovSmirnovStatistic(bulkErrors, referenceErrors) < criticalDistance);
+
+            // Mean of N(0, sigma^2) + Bernoulli(p) * U(0, m) is p * m / 2; allow four standard errors
+            double mean = 0.0;
+            for (const double error : bulkErrors) {
+                mean += error;
+            }
+            mean /= static_cast<double>(sampleCount);
+            const double expectedMean = 0.5 * outlierRatio * params.rangeOutlierMagnitude;
+            const double variance = params.rangeNoiseStdDev * params.rangeNoiseStdDev
+                + outlierRatio * params.rangeOutlierMagnitude * params.rangeOutlierMagnitude / 3.0 - expectedMean * expectedMean;
+            assert(std::abs(mean - expectedMean) < 4.0 * std::sqrt(variance / static_cast<double>(sampleCount)));
+        }
+    }
 
-    // Test Set 2: No ranging outliers, but anchor position noise
-    testParams.rangeOutlierRatio = 0.0;
-    testParams.anchorPosNoiseStdDev = 0.25;
-    std::cout << std::format("\n\nTest Set 2 -- Range Std Dev: {:.2f}m, Anchor Position Std Dev: {:.2f}m, No Outliers\n", 
-        testParams.rangeNoiseStdDev, 
-        testParams.anchorPosNoiseStdDev
-    );
+    std::cout << "Noisy range block validation tests passed.\n" << std::flush;
+}
+
+void runOrdinaryLeastSquaresFastPathValidationTests()
+{
+    std::mt19937_64 rng = makeRandomEngine(2024);
+    const std::vector<Eigen::Vector3d> offsets = {
+        Eigen::Vector3d::Zero(),
+        Eigen::Vector3d(1000.0, -2000.0, 50.0),
+    };
+
+    for (const Eigen::Vector3d& offset : offsets) {
+        for (size_t anchorCount = 4; anchorCount <= 64; anchorCount *= 2) {
+            const std::vector<Eigen::Vector3d> anchors = makeBenchmarkAnchors(anchorCount, offset, rng);
+            const Eigen::Vector3d truePosition = offset + Eigen::Vector3d(1.0, -2.0, 3.0);
+            const std::vector<double> ranges = generateNoisyRanges(truePosition, anchors, 0.1, rng);
+
+            const Eigen::Vector3d expected = ordinaryLeastSquaresWikipedia(anchors, ranges);
+            const Eigen::Vector3d actual = ordinaryLeastSquaresWikipediaFast(anchors, ranges);
+            assert((actual - expected).norm() <= 1e-9 * std::max(1.0, expected.norm()));
+        }
+    }
+
+    std::cout << "Ordinary least squares fast-path validation tests passed.\n" << std::flush;
+}
+
+void runTwoStepWeightedFastPathValidationTests()
+{
+    std::mt19937_64 rng = makeRandomEngine(2025);
+    std::uniform_real_distribution<double> stdDevDist(0.05, 0.5);
+    const std::vector<Eigen::Vector3d> offsets = {
+        Eigen::Vector3d::Zero(),
+        Eigen::Vector3d(100.0, -200.0, 5.0),
+    };
 
-    std::cout << "\nTest 2.1 (Ordinary Least Squares - Wikipedia Method):\n";
-    runTest(testParams, ordinaryLeastSquaresWikipedia);
+    for (const Eigen::Vector3d& offset : offsets) {
+        for (size_t anchorCount = 4; anchorCount <= 64; anchorCount *= 2) {
+            const std::vector<Eigen::Vector3d> anchors = makeBenchmarkAnchors(anchorCount, offset, rng);
+            const Eigen::Vector3d truePosition = offset + Eigen::Vector3d(1.0, -2.0, 3.0);
+            const std::vector<double> ranges = generateNoisyRanges(truePosition, anchors, 0.1, rng);
+            std::vector<double> rangeStdDevs(anchorCount);
+            for (double& stdDev : rangeStdDevs) {
+                stdDev = stdDevDist(rng);
+            }
+
+            // Away from the origin the reference loses digits in its explicit 4x4 inverses, so the two are
+            // only compared near the origin; both offsets check recovery from noiseless ranges instead.
+            if (offset.isZero()) {
+                const Eigen::Vector3d expected = twoStepWeightedLinearLeastSquaresI_YueWang(anchors, ranges, rangeStdDevs);
+                const Eigen::Vector3d actual = twoStepWeightedLinearLeastSquaresI_YueWangFast(anchors, ranges, rangeStdDevs);
+                assert((actual - expected).norm() <= 1e-9 * std::max(1.0, expected.norm()));
+            }
+
+            const std::vector<double> exactRanges = generateNoisyRanges(truePosition, anchors, 0.0, rng);
+            const Eigen::Vector3d exact = twoStepWeightedLinearLeastSquaresI_YueWangFast(anchors, exactRanges, rangeStdDevs);
+            assert((exact - truePosition).norm() <= 1e-6 * std::max(1.0, truePosition.norm()));
+        }
+    }
 
-    std::cout << "\nTest 2.2 (Ordinary Least Squares - Wikipedia Method with BDCSVD):\n";
-    runTest(testParams, ordinaryLeastSquaresWikipedia2);
+    std::cout << "Two-step weighted least squares fast-path validation tests passed.\n" << std::flush;
+}
 
-    std::cout << "\nTest 2.3 (Non-Linear Least Squares - Eigen Levenberg-Marquardt):\n";
-    runTest(testParams, nonLinearLeastSquaresEigenLevenbergMarquardt);
+void runBatchMultilaterationValidationTests()
+{
+    std::mt19937_64 rng = makeRandomEngine(99);
+    const std::vector<Eigen::Vector3d> anchors = makeBenchmarkAnchors(9, Eigen::Vector3d(20.0, -5.0, 3.0), rng);
+    std::vector<Eigen::Vector3d> coplanarAnchors = anchors;
+    for (Eigen::Vector3d& anchor : coplanarAnchors) {
+        anchor.z() = 3.0;
+    }
 
-    std::cout << "\nTest 2.4 (Robust Non-Linear Least Squares - Eigen Levenberg-Marquardt):\n";
-    runTest(testParams, robustNllsEigenLM);
+    constexpr Eigen::Index tagCount = 40;
+    std::uniform_real_distribution<double> tagDist(-8.0, 8.0);
+
+    for (const bool coplanar : {false, true}) {
+        const std::vector<Eigen::Vector3d>& layout = coplanar ? coplanarAnchors : anchors;
+        RangeMatrix ranges(tagCount, static_cast<Eigen::Index>(layout.size()));
+        std::vector<std::vector<double>> tagRanges;
+        for (Eigen::Index t = 0; t < tagCount; ++t) {
+            const Eigen::Vector3d tagPosition =
+                Eigen::Vector3d(20.0, -5.0, 3.0) + Eigen::Vector3d(tagDist(rng), tagDist(rng), tagDist(rng));
+            tagRanges.push_back(generateNoisyRanges(tagPosition, layout, 0.05, rng));
+            ranges.row(t) = Eigen::Map<const Eigen::RowVectorXd>(
+                tagRanges.back().data(), static_cast<Eigen::Index>(tagRanges.back().size()));
+        }
 
-    std::cout << "\nTest 2.5 (Linear Least Squares - LLS-I from Y. Wang. 2015):\n";
-    runTest(testParams, linearLeastSquaresI_YueWang);
+        for (const AlgorithmId algorithm : {
+                 AlgorithmId::OrdinaryLeastSquaresWikipedia,
+                 AlgorithmId::OrdinaryLeastSquaresWikipediaBdcsvd,
+                 AlgorithmId::NonLinearLeastSquaresEigenLm,
+                 AlgorithmId::LinearLeastSquaresIYueWang,
+                 AlgorithmId::LinearLeastSquaresII2YueWang,
+             }) {
+            // The normal-equations method is documented to fail for coplanar anchors
+            if (coplanar && algorithm == AlgorithmId::OrdinaryLeastSquaresWikipedia) continue;
+
+            const PositionMatrix batchEstimates = runAlgorithmBatch(algorithm, layout, ranges, 0.05);
+            assert(batchEstimates.rows() == tagCount);
+            for (Eigen::Index t = 0; t < tagCount; ++t) {
+                const Eigen::Vector3d expected =
+                    runAlgorithm(algorithm, layout, tagRanges[static_cast<size_t>(t)], 0.05);
+                const Eigen::Vector3d actual = batchEstimates.row(t).transpose();
+                assert((actual - expected).norm() <= 1e-8 * std::max(1.0, expected.norm()));
+            }
+        }
+    }
 
-    std::cout << "\nTest 2.6 (Linear Least Squares - LLS-II-2 from Y. Wang. 2015):\n";
-    runTest(testParams, linearLeastSquaresII_2_YueWang);
+    bool rejectedMismatch = false;
+    try {
+        ordinaryLeastSquaresWikipedia2Batch(anchors, RangeMatrix::Zero(2, 3));
+    } catch (const std::invalid_argument&) {
+        rejectedMismatch = true;
+    }
+    assert(rejectedMismatch);
 
-    std::cout << "\nTest 2.7 (Two-Step Weighted Linear Least Squares - LLS-I from Y. Wang. 2015):\n";
-    runTest(testParams, tsWeightedLLSMethod);
+    std::cout << "Batch multilateration validation tests passed.\n" << std::flush;
+}
 
-    // Test Set 3: With ranging outliers
-    testParams.rangeOutlierRatio = 0.1;
-    testParams.anchorPosNoiseStdDev = 0.0;
-    std::cout << std::format("\n\nTest Set 3 -- Std Dev: {:.2f}m, Outliers: {:.1f}%\n", 
-        testParams.rangeNoiseStdDev, 
-        testParams.rangeOutlierRatio * 100.0
-    );
+void runAnchorGeometryValidationTests()
+{
+    std::mt19937_64 rng = makeRandomEngine(314);
+    const Eigen::Vector3d offset(-40.0, 15.0, 2.0);
+    std::vector<Eigen::Vector3d> anchors = makeBenchmarkAnchors(7, offset, rng);
+
+    AnchorGeometry geometry(anchors);
+    assert(geometry.matches(anchors));
+    assert(!geometry.update(anchors));
+
+    std::uniform_real_distribution<double> tagDist(-8.0, 8.0);
+    auto checkAgainstReference = [&]() {
+        for (size_t trial = 0; trial < 32; ++trial) {
+            const Eigen::Vector3d tagPosition = offset + Eigen::Vector3d(tagDist(rng), tagDist(rng), tagDist(rng));
+            const std::vector<double> ranges = generateNoisyRanges(tagPosition, anchors, 0.05, rng);
+
+            const Eigen::Vector3d ols2 = ordinaryLeastSquaresWikipedia2(anchors, ranges);
+            const Eigen::Vector3d llsI = linearLeastSquaresI_YueWang(anchors, ranges);
+            const Eigen::Vector3d llsII = linearLeastSquaresII_2_YueWang(anchors, ranges);
+            assert((ordinaryLeastSquaresWikipedia2(geometry, ranges) - ols2).norm() <= 1e-8 * std::max(1.0, ols2.norm()));
+            assert((linearLeastSquaresI_YueWang(geometry, ranges) - llsI).norm() <= 1e-8 * std::max(1.0, llsI.norm()));
+            assert((linearLeastSquaresII_2_YueWang(geometry, ranges) - llsII).norm() <= 1e-8 * std::max(1.0, llsII.norm()));
+        }
+    };
+    checkAgainstReference();
+
+    // Eager precomputation builds the same per-reference pseudo-inverses as the lazy path
+    const AnchorGeometry precomputed(anchors);
+    precomputed.precomputeLinearLeastSquaresII();
+    for (size_t refIndex = 0; refIndex < anchors.size(); ++refIndex) {
+        assert(precomputed.linearLeastSquaresIIPseudoInverse(refIndex).isApprox(geometry.linearLeastSquaresIIPseudoInverse(refIndex)));
+    }
 
-    // With 10% outliers
-    std::cout << "\nTest 3.1 (Ordinary Least Squares - Wikipedia Method):\n";
-    runTest(testParams, ordinaryLeastSquaresWikipedia);
+    // Moving one anchor invalidates and rebuilds every cached factorization, including
+    // coplanar layouts where only the pseudo-inverse solution is meaningful.
+    for (Eigen::Vector3d& anchor : anchors) {
+        anchor.z() = offset.z();
+    }
+    assert(!geometry.matches(anchors));
+    assert(geometry.update(anchors));
+    assert(geometry.matches(anchors));
+    checkAgainstReference();
+
+    bool rejectedMismatch = false;
+    try {
+        ordinaryLeastSquaresWikipedia2(geometry, std::vector<double>(anchors.size() + 1, 1.0));
+    } catch (const std::invalid_argument&) {
+        rejectedMismatch = true;
+    }
+    assert(rejectedMismatch);
+
+    std::cout << "Anchor geometry validation tests passed.\n" << std::flush;
+}
+
+void runIncrementalLinearLeastSquaresValidationTests()
+{
+    std::mt19937_64 rng = makeRandomEngine(1919);
+    const Eigen::Vector3d offset(200.0, -150.0, 6.0);
+    constexpr size_t anchorCount = 12;
+    const std::vector<Eigen::Vector3d> anchors = makeBenchmarkAnchors(anchorCount, offset, rng);
+    std::uniform_real_distribution<double> tagDist(-8.0, 8.0);
+    std::uniform_int_distribution<size_t> anchorDist(0, anchorCount - 1);
+    std::bernoulli_distribution expireDist(0.3);
+
+    // A short rebuild interval so the stream below crosses several automatic rebuilds
+    IncrementalLinearLeastSquaresI estimator(anchors, 64);
+    std::vector<double> ranges(anchorCount, 0.0);
+
+    // Batch LLS-I over the anchors currently held, in index order
+    auto batchEstimate = [&]() {
+        std::vector<Eigen::Vector3d> heldAnchors;
+        std::vector<double> heldRanges;
+        for (size_t i = 0; i < anchorCount; ++i) {
+            if (estimator.hasRange(i)) {
+                heldAnchors.push_back(anchors[i]);
+                heldRanges.push_back(ranges[i]);
+            }
+        }
+        return linearLeastSquaresI_YueWang(heldAnchors, heldRanges);
+    };
 
-    std::cout << "\nTest 3.2 (Ordinary Least Squares - Wikipedia Method with BDCSVD):\n";
-    runTest(testParams, ordinaryLeastSquaresWikipedia2);
+    // Ranges arrive and expire one anchor at a time while the tag moves
+    size_t checkedFixes = 0;
+    for (size_t step = 0; step < 5000; ++step) {
+        const Eigen::Vector3d tagPosition = offset + Eigen::Vector3d(tagDist(rng), tagDist(rng), tagDist(rng));
+        const size_t i = anchorDist(rng);
+        if (expireDist(rng)) {
+            estimator.expireRange(i);
+        } else {
+            ranges[i] = generateNoisyRange(tagPosition, anchors[i], 0.05, rng);
+            estimator.setRange(i, ranges[i]);
+        }
 
-    std::cout << "\nTest 3.3 (Non-Linear Least Squares - Eigen Levenberg-Marquardt):\n";
-    runTest(testParams, nonLinearLeastSquaresEigenLevenbergMarquardt);
+        if (estimator.rangeCount() >= 5 && step % 7 == 0) {
+            const Eigen::Vector3d expected = batchEstimate();
+            assert((estimator.estimate() - expected).norm() <= 1e-8 * std::max(1.0, expected.norm()));
+            ++checkedFixes;
+        }
+    }
+    assert(checkedFixes > 100);
 
-    std::cout << "\nTest 3.4 (Robust Non-Linear Least Squares - Eigen Levenberg-Marquardt):\n";
-    runTest(testParams, robustNllsEigenLM);
+    // A manual rebuild only removes rounding
+    if (estimator.rangeCount() >= 4) {
+        const Eigen::Vector3d beforeRebuild = estimator.estimate();
+        estimator.rebuild();
+        assert((estimator.estimate() - beforeRebuild).norm() <= 1e-8 * std::max(1.0, beforeRebuild.norm()));
+    }
 
-    std::cout << "\nTest 3.5 (Linear Least Squares - LLS-I from Y. Wang. 2015):\n";
-    runTest(testParams, linearLeastSquaresI_YueWang);
+    // Noiseless ranges from coplanar anchors recover a tag in their plane through the pseudo-inverse
+    std::vector<Eigen::Vector3d> coplanarAnchors = anchors;
+    for (Eigen::Vector3d& anchor : coplanarAnchors) {
+        anchor.z() = offset.z();
+    }
+    IncrementalLinearLeastSquaresI coplanar(coplanarAnchors);
+    const Eigen::Vector3d planarTag = offset + Eigen::Vector3d(1.5, -2.5, 0.0);
+    for (size_t i = 0; i < anchorCount; ++i) {
+        coplanar.setRange(i, (coplanarAnchors[i] - planarTag).norm());
+    }
+    assert((coplanar.estimate() - planarTag).norm() <= 1e-6 * planarTag.norm());
+
+    estimator.clear();
+    assert(estimator.rangeCount() == 0);
+    bool rejectedUnderdetermined = false;
+    try {
+        (void)estimator.estimate();
+    } catch (const std::logic_error&) {
+        rejectedUnderdetermined = true;
+    }
+    assert(rejectedUnderdetermined);
 
-    std::cout << "\nTest 3.6 (Linear Least Squares - LLS-II-2 from Y. Wang. 2015):\n";
-    runTest(testParams, linearLeastSquaresII_2_YueWang);
+    bool rejectedIndex = false;
+    try {
+        estimator.setRange(anchorCount, 1.0);
+    } catch (const std::out_of_range&) {
+        rejectedIndex = true;
+    }
+    assert(rejectedIndex);
 
-    std::cout << "\nTest 3.7 (Two-Step Weighted Linear Least Squares - LLS-I from Y. Wang. 2015):\n";
-    runTest(testParams, tsWeightedLLSMethod);
+    std::cout << "Incremental LLS-I validation tests passed.\n" << std::flush;
+}
 
-    std::cout << "\nAll tests completed.\n";
+// Tag position at time t on a slow horizontal circle with a gentle vertical oscillation around offset
+Eigen::Vector3d trackedTagPosition(const Eigen::Vector3d& offset, double t)
+{
+    return offset + Eigen::Vector3d(3.0 * std::cos(0.2 * t), 3.0 * std::sin(0.2 * t), 0.5 * std::sin(0.1 * t));
 }
 
-void runTest(
-    const TestParameters& params, 
-    MultilaterationMethod multilaterationMethod
-)
+void runRangeTrackerValidationTests()
 {
-    std::mt19937_64 rng = makeRandomEngine(params.randomSeed);
+    std::mt19937_64 rng = makeRandomEngine(2020);
+    const Eigen::Vector3d offset(40.0, -25.0, 2.0);
+    const std::vector<Eigen::Vector3d> anchors = makeBenchmarkAnchors(8, offset, rng);
+    constexpr double rangeStdDev = 0.1;
+    constexpr double epochInterval = 0.02;
+    constexpr size_t epochCount = 1500;
+    constexpr size_t settlingEpochs = 100;
+
+    for (const bool levenbergMarquardtRefinement : {false, true}) {
+        RangeTrackerOptions options;
+        options.rangeStdDev = rangeStdDev;
+        options.levenbergMarquardtRefinement = levenbergMarquardtRefinement;
+        RangeTracker tracker(options);
+
+        double trackedSquaredError = 0.0;
+        double standaloneSquaredError = 0.0;
+        for (size_t k = 0; k < epochCount; ++k) {
+            const double t = static_cast<double>(k) * epochInterval;
+            const Eigen::Vector3d tagPosition = trackedTagPosition(offset, t);
+            const std::vector<double> ranges = generateNoisyRanges(tagPosition, anchors, rangeStdDev, rng);
+
+            const RangeTrackerUpdate update = tracker.update(t, anchors, ranges);
+            assert(update.initialised == (k == 0));
+            assert(update.acceptedRanges + update.rejectedRanges == anchors.size());
+            assert(update.iterations < options.levenbergMarquardt.maxIterations);
+            if (levenbergMarquardtRefinement && k > 0) {
+                assert(update.iterations > 0);
+            }
+
+            if (k >= settlingEpochs) {
+                trackedSquaredError += (update.position - tagPosition).squaredNorm();
+                standaloneSquaredError += (nonLinearLeastSquaresAnalyticLevenbergMarquardt(anchors, ranges) - tagPosition).squaredNorm();
+            }
+        }
 
-    std::vector<Eigen::Vector3d> estimatedPositions;
-    estimatedPositions.reserve(params.numRuns);
+        // Filtering across epochs must beat independent per-epoch fixes on the same ranges
+        assert(trackedSquaredError < 0.64 * standaloneSquaredError);
+        assert((tracker.velocity() - Eigen::Vector3d(-0.6 * std::sin(0.2 * tracker.timestamp()),
+            0.6 * std::cos(0.2 * tracker.timestamp()), 0.05 * std::cos(0.1 * tracker.timestamp()))).norm() < 0.2);
+    }
 
-    auto t0 = std::chrono::high_resolution_clock::now();
-    for (size_t i = 0; i < params.numRuns; i++)
+    // A gross outlier is gated out and leaves the track in place
+    RangeTrackerOptions options;
+    options.rangeStdDev = rangeStdDev;
+    RangeTracker tracker(options);
+    for (size_t k = 0; k < 200; ++k) {
+        const double t = static_cast<double>(k) * epochInterval;
+        std::vector<double> ranges = generateNoisyRanges(trackedTagPosition(offset, t), anchors, rangeStdDev, rng);
+        if (k == 150) {
+            ranges[3] += 5.0;
+            const RangeTrackerUpdate update = tracker.update(t, anchors, ranges);
+            assert(update.rejectedRanges == 1);
+            assert((update.position - trackedTagPosition(offset, t)).norm() < 0.3);
+        } else {
+            tracker.update(t, anchors, ranges);
+        }
+    }
+    const Eigen::Vector3d predicted = tracker.predictedPosition(tracker.timestamp() + 0.1);
+    assert((predicted - trackedTagPosition(offset, tracker.timestamp() + 0.1)).norm() < 0.3);
+
+    bool rejectedPastTimestamp = false;
+    try {
+        tracker.update(0.0, anchors, generateNoisyRanges(offset, anchors, rangeStdDev, rng));
+    } catch (const std::invalid_argument&) {
+        rejectedPastTimestamp = true;
+    }
+    assert(rejectedPastTimestamp);
+
+    bool rejectedShortInitialisation = false;
+    tracker.reset();
+    try {
+        const std::vector<Eigen::Vector3d> threeAnchors(anchors.begin(), anchors.begin() + 3);
+        tracker.update(10.0, threeAnchors, generateNoisyRanges(offset, threeAnchors, rangeStdDev, rng));
+    } catch (const std::invalid_argument&) {
+        rejectedShortInitialisation = true;
+    }
+    assert(rejectedShortInitialisation);
+    assert(!tracker.initialised());
+
+    std::cout << "Range tracker validation tests passed.\n" << std::flush;
+}
+
+void runTrackerServiceValidationTests()
+{
+    std::mt19937_64 rng = makeRandomEngine(2021);
+    const std::vector<Eigen::Vector3d> anchors = makeBenchmarkAnchors(6, Eigen::Vector3d::Zero(), rng);
+    std::uniform_real_distribution<double> coordinate(-5.0, 5.0);
+    std::vector<Eigen::Vector3d> tagPositions(500);
+    for (Eigen::Vector3d& tagPosition : tagPositions) {
+        tagPosition = Eigen::Vector3d(coordinate(rng), coordinate(rng), coordinate(rng));
+    }
+
+    TrackerServiceOptions options;
+    options.anchorPositions = anchors;
+    options.algorithm = AlgorithmId::LinearLeastSquaresIYueWang;
+    options.shardCount = 7;
+    options.tagsPerSolveTask = 8;
+
+    // Noise-free out-of-order epochs: every tag is fixed once per process() call, at its true position,
+    // and the fixes do not depend on the thread count
+    std::vector<std::vector<RangeMeasurement>> epochs;
+    for (size_t epoch = 0; epoch < 3; ++epoch) {
+        epochs.push_back(generateTrackerRangeEpoch(tagPositions, anchors, 0.0, static_cast<double>(epoch), 0.05, rng));
+    }
+    std::vector<TagFix> singleThreadFixes;
+    for (const size_t threadCount : {size_t{1}, size_t{3}}) {
+        options.threadCount = threadCount;
+        TrackerService service(options);
+        assert(service.threadCount() == threadCount);
+        for (const std::vector<RangeMeasurement>& epoch : epochs) {
+            for (const RangeMeasurement& measurement : epoch) {
+                assert(service.ingest(measurement));
+            }
+            assert(service.process() == tagPositions.size());
+        }
+        assert(service.process() == 0);
+        assert(service.tagCount() == tagPositions.size());
+
+        const TrackerServiceStats stats = service.stats();
+        assert(stats.ingested == 3 * tagPositions.size() * anchors.size());
+        assert(stats.fixes == 3 * tagPositions.size());
+        assert(stats.droppedStale == 0 && stats.droppedQueueFull == 0 && stats.failedSolves == 0);
+
+        for (uint32_t tagId = 0; tagId < tagPositions.size(); ++tagId) {
+            const std::optional<TagFix> fix = service.latestFix(tagId);
+            assert(fix.has_value() && fix->tagId == tagId && fix->rangeCount == anchors.size());
+            assert(fix->timestamp >= 2.0 && fix->timestamp < 2.05);
+            assert((fix->position - tagPositions[tagId]).norm() < 1e-6);
+            if (threadCount == 1) {
+                singleThreadFixes.push_back(*fix);
+            } else {
+                assert(fix->position == singleThreadFixes[tagId].position);
+            }
+        }
+        assert(!service.latestFix(static_cast<uint32_t>(tagPositions.size())).has_value());
+    }
+
+    // Late, windowed and invalid ranges
+    options.threadCount = 2;
+    options.rangeWindow = 0.5;
+    TrackerService service(options);
+    const Eigen::Vector3d tagPosition = tagPositions[0];
+    auto rangeTo = [&](uint32_t anchor) { return (tagPosition - anchors[anchor]).norm(); };
+    for (uint32_t anchor = 0; anchor < 4; ++anchor) {
+        service.ingest({42, anchor, 10.0, rangeTo(anchor)});
+    }
+    service.ingest({42, 0, 9.0, 100.0});           // older than the range held from anchor 0
+    service.ingest({42, 99, 10.0, 1.0});           // no such anchor
+    assert(service.process() == 1);
+    TrackerServiceStats stats = service.stats();
+    assert(stats.droppedStale == 1 && stats.droppedInvalidAnchor == 1);
+    assert((service.latestFix(42)->position - tagPosition).norm() < 1e-6);
+
+    // Three fresh ranges push the four old ones out of the window: too few to solve, so the fix stays
+    for (uint32_t anchor = 0; anchor < 3; ++anchor) {
+        service.ingest({42, anchor, 11.0, rangeTo(anchor) + 1.0});
+    }
+    assert(service.process() == 0);
+    assert(service.latestFix(42)->timestamp == 10.0);
+
+    // Backpressure: a full shard queue rejects ranges until process() drains it
+    options.shardCount = 1;
+    options.queueCapacity = 4;
+    TrackerService small(options);
+    for (uint32_t anchor = 0; anchor < 4; ++anchor) {
+        assert(small.ingest({1, anchor, 0.0, rangeTo(anchor)}));
+    }
+    assert(!small.ingest({1, 4, 0.0, rangeTo(4)}));
+    assert(small.stats().droppedQueueFull == 1 && small.stats().ingested == 4);
+    assert(small.process() == 1);
+    assert(small.ingest({1, 4, 0.0, rangeTo(4)}));
+
+    std::cout << "Tracker service validation tests passed.\n" << std::flush;
+}
+
+void runRangeLogValidationTests()
+{
+    std::mt19937_64 rng = makeRandomEngine(2022);
+    const std::vector<Eigen::Vector3d> anchors = makeBenchmarkAnchors(6, Eigen::Vector3d::Zero(), rng);
+    std::uniform_real_distribution<double> coordinate(-5.0, 5.0);
+    std::vector<Eigen::Vector3d> tagPositions(50);
+    for (Eigen::Vector3d& tagPosition : tagPositions) {
+        tagPosition = Eigen::Vector3d(coordinate(rng), coordinate(rng), coordinate(rng));
+    }
+    const std::string path = (std::filesystem::temp_directory_path() / "multilat_range_log_test.bin").string();
+
+    // Noise-free rounds, then a round with an unknown anchor and one too short to solve
     {
-        // Ranges use the physical anchors; only the coordinates supplied to the
-        // estimator receive independent survey/coordinate noise.
-        std::vector<Eigen::Vector3d> anchorPositions = params.anchorPositions;
-        if (params.anchorPosNoiseStdDev > 0.0)
-        {
-            anchorPositions = generateNoisyAnchorPositions(params.anchorPositions, params.anchorPosNoiseStdDev, rng);
+        RangeLogWriter writer(path, anchors);
+        assert(writeSyntheticRangeLog(writer, tagPositions, anchors, 0.0, 4, 1.0, rng) == 4 * 50 * 6);
+        writer.write({10.0, 7, 2, 0, 1.0f, 0.0f});
+        writer.write({10.0, 7, 99, 0, 1.0f, 0.0f});
+        writer.write({10.0, 8, 0, 0, 1.0f, 0.0f});
+        assert(writer.recordCount() == 4 * 50 * 6 + 3);
+    }
+
+    const RangeLogReader reader(path);
+    assert(reader.anchorPositions() == anchors);
+    assert(reader.records().size() == 4 * 50 * 6 + 3);
+    assert(reader.fileSize() == sizeof(RangeLogHeader) + 6 * 3 * sizeof(double) + reader.records().size() * sizeof(RangeLogRecord));
+    const RangeLogRecord& first = reader.records().front();
+    assert(first.tagId == 0 && first.anchorIndex == 0 && first.timestamp == 0.0 && (first.flags & rangeLogHasStdDev));
+    assert(first.range == static_cast<float>((tagPositions[0] - anchors[0]).norm()));
+
+    // A tag's round ends at a tag change or when it outlasts the epoch duration
+    assert(findRangeLogEpochEnd(reader.records(), 0, 0.05) == 6);
+    assert(findRangeLogEpochEnd(reader.records(), 4, 0.05) == 6);
+    const std::vector<RangeLogRecord> sameTag = {{0.0, 1, 0}, {0.02, 1, 1}, {0.08, 1, 2}, {0.09, 1, 3}};
+    assert(findRangeLogEpochEnd(sameTag, 0, 0.05) == 2 && findRangeLogEpochEnd(sameTag, 2, 0.05) == 4);
+
+    // Fixes recover the tags up to float range rounding, and do not depend on the thread count
+    RangeLogReplayOptions options;
+    options.algorithm = AlgorithmId::LinearLeastSquaresIYueWang;
+    std::vector<TagFix> singleThreadFixes;
+    for (const size_t threadCount : {size_t{1}, size_t{3}}) {
+        options.threadCount = threadCount;
+        std::mutex fixesMutex;
+        std::vector<TagFix> fixes;
+        const RangeLogReplayStats stats = replayRangeLog(reader, options, [&](const TagFix& fix) {
+            std::lock_guard<std::mutex> lock(fixesMutex);
+            fixes.push_back(fix);
+        });
+        assert(stats.records == reader.records().size());
+        assert(stats.epochs == 4 * 50 + 2 && stats.fixes == 4 * 50);
+        assert(stats.skippedEpochs == 2 && stats.invalidAnchorRecords == 1 && stats.failedSolves == 0);
+
+        std::sort(fixes.begin(), fixes.end(), [](const TagFix& a, const TagFix& b) {
+            return std::tie(a.timestamp, a.tagId) < std::tie(b.timestamp, b.tagId);
+        });
+        for (size_t i = 0; i < fixes.size(); ++i) {
+            assert(fixes[i].tagId == i % 50 && fixes[i].timestamp == static_cast<double>(i / 50));
+            assert(fixes[i].rangeCount == anchors.size());
+            assert((fixes[i].position - tagPositions[i % 50]).norm() < 1e-4);
+            if (threadCount == 1) {
+                singleThreadFixes.push_back(fixes[i]);
+            } else {
+                assert(fixes[i].position == singleThreadFixes[i].position);
+            }
         }
+    }
 
-        std::vector<double> noisyRanges = generateNoisyRanges(params, rng);
+    // Corrupt files are rejected
+    auto rejects = [](const std::string& corruptPath) {
+        try {
+            RangeLogReader corrupt(corruptPath);
+        } catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    };
+    const std::string corruptPath = path + ".corrupt";
+    std::filesystem::copy_file(path, corruptPath, std::filesystem::copy_options::overwrite_existing);
+    std::filesystem::resize_file(corruptPath, reader.fileSize() - 1);
+    assert(rejects(corruptPath));
+    {
+        std::ofstream corrupt(corruptPath, std::ios::binary | std::ios::in | std::ios::out);
+        corrupt.write("NOTALOG!", 8);
+    }
+    std::filesystem::resize_file(corruptPath, reader.fileSize());
+    assert(rejects(corruptPath));
+    assert(rejects(path + ".missing"));
+    std::filesystem::remove(corruptPath);
+    std::error_code ignored;
+    std::filesystem::remove(path, ignored);
+
+    std::cout << "Range log validation tests passed.\n" << std::flush;
+}
 
-        estimatedPositions.emplace_back(
-            multilaterationMethod(anchorPositions, noisyRanges)
-        );
+void runResultSinkValidationTests()
+{
+    std::mt19937_64 rng = makeRandomEngine(2023);
+    TestParameters params;
+    params.truePosition = Eigen::Vector3d(0.5, -0.25, 4.0);
+    params.anchorPositions = makeBenchmarkAnchors(6, Eigen::Vector3d::Zero(), rng);
+    params.rangeNoiseStdDev = 0.1;
+    params.rangeOutlierRatio = 0.1;
+    params.rangeOutlierMagnitude = 5.0;
+    params.randomSeed = 2023;
+    params.numRuns = 300;
+    params.algorithm = AlgorithmId::RobustNonLinearLeastSquaresAnalyticLm;
+    params.keepEstimates = true;
+
+    // SimulationRunner streams every run in run order, with diagnostics when they are collected
+    for (const ExecutionMode mode : {ExecutionMode::Serial, ExecutionMode::Parallel}) {
+        for (const bool diagnostics : {false, true}) {
+            TestParameters runParams = params;
+            runParams.executionMode = mode;
+            runParams.numThreads = 3;
+            runParams.collectSolveDiagnostics = diagnostics;
+
+            std::stringstream binary;
+            std::ostringstream csv;
+            // A tiny buffer forces a flush on almost every record
+            const std::unique_ptr<ResultSink> binarySink = makeResultSink(ResultFormat::Binary, binary, 64);
+            const std::unique_ptr<ResultSink> csvSink = makeResultSink(ResultFormat::Csv, csv);
+            SimulationRunner runner;
+            runner.begin(runParams);
+            runner.setResultSink(binarySink.get(), 7);
+            runner.step(100);
+            runner.setResultSink(csvSink.get(), 7);
+            while (runner.status() == SimulationRunner::Status::Running) {
+                runner.step(100);
+            }
+            assert(runner.status() == SimulationRunner::Status::Completed);
+            assert(binarySink->recordCount() == 100 && csvSink->recordCount() == 200);
+            assert(binarySink->bytesWritten() == binary.str().size() && csvSink->bytesWritten() == csv.str().size());
+
+            BinaryResultReader reader(binary);
+            RunRecord record;
+            for (size_t run = 0; run < 100; ++run) {
+                assert(reader.next(record));
+                assert(record.scenarioIndex == 7 && record.algorithm == params.algorithm && record.runIndex == run);
+                assert(record.result.position == runner.estimatedPositions()[run]);
+                assert(record.error == runner.estimatedPositions()[run] - params.truePosition);
+                assert(record.hasDiagnostics == diagnostics);
+                if (diagnostics) {
+                    assert(record.result.iterations > 0 && record.result.outerIterations > 0 && record.result.finalCost > 0.0);
+                }
+            }
+            assert(!reader.next(record));
+
+            // Header plus one line per run, the first starting at run 100
+            std::istringstream lines(csv.str());
+            std::string line;
+            size_t lineCount = 0;
+            std::getline(lines, line);
+            assert(line.starts_with("scenario,algorithm,run,x,y,z,error_x"));
+            while (std::getline(lines, line)) {
+                if (lineCount == 0) {
+                    assert(line.starts_with(std::format("7,{},100,", static_cast<int>(params.algorithm))));
+                }
+                assert(std::count(line.begin(), line.end(), ',') == 18);
+                assert(line.ends_with(",,,,,,,,,") != diagnostics);
+                ++lineCount;
+            }
+            assert(lineCount == 200);
+        }
     }
-    auto t1 = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> elapsed = t1 - t0;
 
-    computeAndPrintResults(estimatedPositions, params);
+    // Doubles round-trip exactly through text and through the binary XOR coding
+    RunRecord extreme;
+    extreme.runIndex = 5;
+    extreme.result.position = Eigen::Vector3d(0.1, -1e-300, 123456.789);
+    extreme.error = Eigen::Vector3d(std::numeric_limits<double>::max(), -0.0, 1.0 / 3.0);
+    extreme.result.finalCost = 2.5;
+    extreme.result.rank = -1;
+    extreme.result.converged = false;
+    extreme.result.timings.refinementNs = 12345;
+    extreme.hasDiagnostics = true;
+    std::stringstream binary;
+    std::ostringstream jsonLines;
+    {
+        const std::unique_ptr<ResultSink> binarySink = makeResultSink(ResultFormat::Binary, binary);
+        const std::unique_ptr<ResultSink> jsonSink = makeResultSink(ResultFormat::JsonLines, jsonLines);
+        for (const uint64_t run : {uint64_t{5}, uint64_t{3}, uint64_t{5}}) {
+            extreme.runIndex = run;
+            binarySink->write(extreme);
+            jsonSink->write(extreme);
+        }
+    }
+    BinaryResultReader reader(binary);
+    for (const uint64_t run : {uint64_t{5}, uint64_t{3}, uint64_t{5}}) {
+        RunRecord record;
+        assert(reader.next(record) && record.runIndex == run);
+        assert(record.result.position == extreme.result.position && record.error == extreme.error);
+        assert(std::signbit(record.error.y()) && record.result.rank == -1 && !record.result.converged);
+        assert(record.result.finalCost == 2.5 && record.result.timings.refinementNs == 12345);
+    }
+    assert(jsonLines.str().starts_with(
+        "{\"scenario\":0,\"algorithm\":0,\"run\":5,\"position\":[0.1,-1e-300,123456.789],"
+        "\"error\":[1.7976931348623157e+308,-0,0.3333333333333333],"));
+    assert(jsonLines.str().find("\"rank\":-1,\"converged\":false,") != std::string::npos);
+
+    std::istringstream notBinary("scenario,algorithm");
+    bool rejected = false;
+    try {
+        BinaryResultReader invalid(notBinary);
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    assert(rejected);
+    assert(resultFormatFromPath("out/runs.csv") == ResultFormat::Csv);
+    assert(resultFormatFromPath("runs.jsonl") == ResultFormat::JsonLines);
+    assert(resultFormatFromPath("runs.bin") == ResultFormat::Binary);
 
-    std::cout << std::format("  Total Time for {} runs: {:.3f} ms\n", params.numRuns, elapsed.count());
-    std::cout << std::format("  Average Time per run: {:.4f} ms\n", (elapsed.count() * 1000.0) / static_cast<double>(params.numRuns));
+    std::cout << "Result sink validation tests passed.\n" << std::flush;
+}
+
+void runParameterSweepValidationTests()
+{
+    std::istringstream text(
+        "# two noise levels, two anchor counts, two layouts\n"
+        "range_noise_std_dev = 0.05, 0.2\n"
+        "anchor_count = 5, 8   # per scenario\n"
+        "anchor_layout = ring, random\n"
+        "anchor_position_noise = 0.02\n"
+        "algorithms = 4, 7\n"
+        "true_position = 0.5, -0.5, 4\n"
+        "runs = 60\n"
+        "seed = 11\n");
+    const SweepConfig config = parseSweepConfig(text);
+    assert(config.rangeNoiseStdDevs == std::vector<double>({0.05, 0.2}));
+    assert(config.anchorCounts == std::vector<size_t>({5, 8}));
+    assert(config.anchorLayouts.size() == 2 && config.anchorLayouts[1] == AnchorLayout::Random);
+    assert(config.algorithms.size() == 2 && config.algorithms[1] == AlgorithmId::NonLinearLeastSquaresAnalyticLm);
+    assert(config.truePosition == Eigen::Vector3d(0.5, -0.5, 4.0));
+    assert(config.numRuns == 60 && config.randomSeed == 11 && config.rangeOutlierRatios == std::vector<double>({0.0}));
+
+    for (const char* invalid : {"runs = 10\nnoise = 0.1\n", "anchor_count = 8, x\n", "anchor_layout = dome\n",
+                                "algorithms = 99\n", "true_position = 1, 2\n", "anchor_count = 3\n"}) {
+        std::istringstream invalidText(invalid);
+        bool rejected = false;
+        try {
+            static_cast<void>(parseSweepConfig(invalidText));
+        } catch (const std::invalid_argument& e) {
+            rejected = true;
+            assert(std::string_view(e.what()).starts_with("Sweep config"));
+        }
+        assert(rejected);
+    }
+
+    // Ring alternates heights, ceiling anchors share one plane, random layouts follow the seed
+    const std::vector<Eigen::Vector3d> ring = makeAnchorLayout(AnchorLayout::Ring, 6, 10.0, 1);
+    const std::vector<Eigen::Vector3d> ceiling = makeAnchorLayout(AnchorLayout::Ceiling, 7, 10.0, 1);
+    assert(ring.size() == 6 && ring[0].z() == 0.0 && ring[1].z() == 10.0);
+    assert(std::abs(ring[3].head<2>().norm() - 5.0) < 1e-12);
+    assert(ceiling.size() == 7);
+    for (const Eigen::Vector3d& anchor : ceiling) {
+        assert(anchor.z() == 10.0 && anchor.head<2>().cwiseAbs().maxCoeff() < 5.0);
+    }
+    assert(makeAnchorLayout(AnchorLayout::Random, 6, 10.0, 3) == makeAnchorLayout(AnchorLayout::Random, 6, 10.0, 3));
+    assert(makeAnchorLayout(AnchorLayout::Random, 6, 10.0, 3) != makeAnchorLayout(AnchorLayout::Random, 6, 10.0, 4));
+
+    // Row-major grid, anchor layout varying fastest here
+    const std::vector<SweepScenario> scenarios = expandSweepGrid(config);
+    assert(scenarios.size() == 8);
+    for (size_t i = 0; i < scenarios.size(); ++i) {
+        assert(scenarios[i].index == i);
+        assert(scenarios[i].params.rangeNoiseStdDev == config.rangeNoiseStdDevs[i / 4]);
+        assert(scenarios[i].params.anchorPositions.size() == config.anchorCounts[(i / 2) % 2]);
+        assert(scenarios[i].anchorLayout == config.anchorLayouts[i % 2]);
+        assert(scenarios[i].params.anchorPosNoiseStdDev == 0.02 && scenarios[i].params.numRuns == 60);
+    }
+
+    std::stringstream binary;
+    const std::unique_ptr<ResultSink> runSink = makeResultSink(ResultFormat::Binary, binary);
+    SweepOptions options;
+    options.threadCount = 1;
+    const std::vector<SweepResult> serial = runSweep(config, scenarios, options);
+    options.threadCount = 3;
+    options.runSink = runSink.get();
+    const std::vector<SweepResult> parallel = runSweep(config, scenarios, options);
+    runSink->flush();
+    assert(serial.size() == 16 && parallel.size() == 16);
+    for (size_t i = 0; i < serial.size(); ++i) {
+        assert(serial[i].scenarioIndex == i / 2 && serial[i].algorithm == config.algorithms[i % 2]);
+        assert(parallel[i].scenarioIndex == serial[i].scenarioIndex && parallel[i].algorithm == serial[i].algorithm);
+        assert(parallel[i].results.meanSignedError == serial[i].results.meanSignedError);
+        assert(parallel[i].results.errorSecondMoment == serial[i].results.errorSecondMoment);
+        assert(serial[i].runs == 60 && serial[i].failedRuns == 0);
+        assert(std::isfinite(serial[i].crlbRmsError) && serial[i].crlbRmsError > 0.0);
+    }
+
+    // Every algorithm of a scenario sees the draws a direct per-run solve would
+    const SweepScenario& scenario = scenarios[5];
+    for (size_t a = 0; a < config.algorithms.size(); ++a) {
+        ErrorStatisticsAccumulator expected(scenario.params.truePosition);
+        for (size_t run = 0; run < config.numRuns; ++run) {
+            std::mt19937_64 rng = makeRunRandomEngine(config.randomSeed, run);
+            const std::vector<double> ranges = generateNoisyRanges(
+                scenario.params.truePosition, scenario.params.anchorPositions, scenario.params.rangeNoiseStdDev,
+                scenario.params.rangeOutlierRatio, scenario.params.rangeOutlierMagnitude, rng);
+            const std::vector<Eigen::Vector3d> anchors =
+                generateNoisyAnchorPositions(scenario.params.anchorPositions, scenario.params.anchorPosNoiseStdDev, rng);
+            expected.add(runAlgorithm(config.algorithms[a], anchors, ranges, scenario.params.rangeNoiseStdDev));
+        }
+        assert(expected.results().meanSignedError == serial[5 * 2 + a].results.meanSignedError);
+        assert(expected.results().maxError == serial[5 * 2 + a].results.maxError);
+    }
+
+    // The sink holds every run, each job contiguous and in run order
+    BinaryResultReader reader(binary);
+    RunRecord record;
+    size_t recordCount = 0;
+    while (reader.next(record)) {
+        assert(record.runIndex == recordCount % config.numRuns);
+        ++recordCount;
+    }
+    assert(recordCount == 16 * config.numRuns);
+
+    std::ostringstream csv;
+    writeSweepResultsCsv(csv, scenarios, serial);
+    std::istringstream lines(csv.str());
+    std::string line;
+    size_t lineCount = 0;
+    std::getline(lines, line);
+    assert(line.starts_with("scenario,range_noise_std_dev,range_outlier_ratio,anchor_count,anchor_layout,"));
+    while (std::getline(lines, line)) {
+        assert(std::count(line.begin(), line.end(), ',') == 21);
+        ++lineCount;
+    }
+    assert(lineCount == serial.size());
+
+    std::cout << "Parameter sweep validation tests passed.\n" << std::flush;
+}
+
+void runCommonRandomNumbersValidationTests()
+{
+    std::mt19937_64 rng = makeRandomEngine(2025);
+    TestParameters params;
+    params.truePosition = Eigen::Vector3d(0.5, -0.25, 4.0);
+    params.anchorPositions = makeBenchmarkAnchors(7, Eigen::Vector3d::Zero(), rng);
+    params.rangeNoiseStdDev = 0.1;
+    params.rangeOutlierRatio = 0.1;
+    params.rangeOutlierMagnitude = 5.0;
+    params.anchorPosNoiseStdDev = 0.05;
+    params.randomSeed = 2025;
+    params.numRuns = 300;
+    const std::vector<AlgorithmId> algorithms = {
+        AlgorithmId::NonLinearLeastSquaresAnalyticLm,
+        AlgorithmId::OrdinaryLeastSquaresWikipedia,
+        AlgorithmId::LinearLeastSquaresIYueWang,
+        AlgorithmId::RobustNonLinearLeastSquaresAnalyticLm,
+    };
+
+    std::stringstream binary;
+    const std::unique_ptr<ResultSink> sink = makeResultSink(ResultFormat::Binary, binary);
+    const std::vector<CommonRandomNumbersResult> results = runCommonRandomNumbers(params, algorithms, sink.get());
+    sink->flush();
+    assert(results.size() == algorithms.size());
+
+    // Each algorithm sees exactly the draws of its own runTest-ordered pass
+    for (size_t a = 0; a < algorithms.size(); ++a) {
+        std::mt19937_64 engine = makeRandomEngine(params.randomSeed);
+        ErrorStatisticsAccumulator expected(params.truePosition);
+        for (size_t run = 0; run < params.numRuns; ++run) {
+            const std::vector<Eigen::Vector3d> anchors = generateNoisyAnchorPositions(params, engine);
+            const std::vector<double> ranges = generateNoisyRanges(params, engine);
+            expected.add(runAlgorithm(algorithms[a], anchors, ranges, params.rangeNoiseStdDev));
+        }
+        const TestResults& actual = results[a].results;
+        assert(results[a].algorithm == algorithms[a]);
+        assert(actual.meanSignedError == expected.results().meanSignedError);
+        assert(actual.maxError == expected.results().maxError);
+        assert(actual.errorSecondMoment == expected.results().errorSecondMoment);
+        assert(results[a].meanSolveNs > 0.0);
+    }
+
+    // The reference has no difference to itself; OLS errors track the LM errors closely,
+    // so pairing shrinks the standard error of their difference
+    assert(results[0].pairedRuns == 0 && results[0].meanErrorNormDifference == 0.0 && results[0].pairedStdError == 0.0);
+    for (size_t a = 1; a < algorithms.size(); ++a) {
+        assert(results[a].pairedRuns == params.numRuns && results[a].pairedStdError > 0.0);
+    }
+    assert(results[1].meanErrorNormDifference > 0.0);
+    assert(results[1].pairedStdError < 0.5 * results[1].unpairedStdError);
+
+    // Records arrive run by run, every algorithm of a run together
+    BinaryResultReader reader(binary);
+    RunRecord record;
+    size_t recordCount = 0;
+    while (reader.next(record)) {
+        assert(record.runIndex == recordCount / algorithms.size());
+        assert(record.algorithm == algorithms[recordCount % algorithms.size()]);
+        ++recordCount;
+    }
+    assert(recordCount == params.numRuns * algorithms.size());
+
+    std::cout << "Common random numbers validation tests passed.\n" << std::flush;
+}
+
+void runAnalyticLevenbergMarquardtValidationTests()
+{
+    std::mt19937_64 rng = makeRandomEngine(4242);
+    std::uniform_real_distribution<double> tagDist(-8.0, 8.0);
+
+    for (size_t anchorCount = 4; anchorCount <= 32; anchorCount *= 2) {
+        const std::vector<Eigen::Vector3d> anchors = makeBenchmarkAnchors(anchorCount, Eigen::Vector3d(5.0, 5.0, 5.0), rng);
+        const Eigen::Vector3d truePosition = Eigen::Vector3d(5.0, 5.0, 5.0)
+            + Eigen::Vector3d(tagDist(rng), tagDist(rng), tagDist(rng));
+
+        // Noiseless ranges are fitted exactly
+        std::vector<double> exactRanges;
+        for (const Eigen::Vector3d& anchor : anchors) {
+            exactRanges.push_back((truePosition - anchor).norm());
+        }
+        assert((nonLinearLeastSquaresAnalyticLevenbergMarquardt(anchors, exactRanges) - truePosition).norm() < 1e-8);
+
+        // Noisy ranges reach the same minimum as Eigen's numerically differentiated LM
+        const std::vector<double> ranges = generateNoisyRanges(truePosition, anchors, 0.2, rng);
+        const Eigen::Vector3d eigenEstimate = nonLinearLeastSquaresEigenLevenbergMarquardt(anchors, ranges);
+        const Eigen::Vector3d analyticEstimate = nonLinearLeastSquaresAnalyticLevenbergMarquardt(anchors, ranges);
+        // (Eigen's forward-difference Jacobian limits it to roughly 1e-6 m, so the analytic
+        // solution must be at least as good a minimiser rather than identical)
+        auto sumSquaredResiduals = [&](const Eigen::Vector3d& x) {
+            double sum = 0.0;
+            for (size_t i = 0; i < anchors.size(); ++i) {
+                const double r = (x - anchors[i]).norm() - ranges[i];
+                sum += r * r;
+            }
+            return sum;
+        };
+        assert((analyticEstimate - eigenEstimate).norm() < 1e-4);
+        assert(sumSquaredResiduals(analyticEstimate) <= sumSquaredResiduals(eigenEstimate) + 1e-12);
+
+        Eigen::Vector3d position = ordinaryLeastSquaresWikipedia2(anchors, ranges);
+        RangeLevenbergMarquardt lmSolver;
+        const LevenbergMarquardtSummary summary = lmSolver.minimize(anchors, ranges, {}, 1.0, position);
+        assert(summary.converged);
+        assert(summary.finalCost <= summary.initialCost);
+        assert(summary.functionEvaluations == summary.iterations + 1);
+    }
+
+    // The iteration limit is honoured
+    const std::vector<Eigen::Vector3d> anchors = makeBenchmarkAnchors(8, Eigen::Vector3d::Zero(), rng);
+    const std::vector<double> ranges = generateNoisyRanges(Eigen::Vector3d(1.0, 2.0, 3.0), anchors, 0.2, rng);
+    LevenbergMarquardtOptions options;
+    options.maxIterations = 1;
+    Eigen::Vector3d position = Eigen::Vector3d::Zero();
+    RangeLevenbergMarquardt limitedSolver(options);
+    assert(limitedSolver.minimize(anchors, ranges, {}, 1.0, position).iterations <= 1);
+
+    std::cout << "Analytic Levenberg-Marquardt validation tests passed.\n" << std::flush;
+}
+
+// Ranges with noise sigma and, with probability outlierProbability, an added positive outlier of up to outlierMax
+std::vector<double> generateOutlierContaminatedRanges(
+    const Eigen::Vector3d& truePosition,
+    const std::vector<Eigen::Vector3d>& anchors,
+    const double sigma,
+    const double outlierProbability,
+    const double outlierMax,
+    std::mt19937_64& rng
+)
+{
+    std::vector<double> ranges = generateNoisyRanges(truePosition, anchors, sigma, rng);
+    std::uniform_real_distribution<double> unitDist(0.0, 1.0);
+    for (double& range : ranges) {
+        if (unitDist(rng) < outlierProbability) {
+            range += outlierMax * unitDist(rng);
+        }
+    }
+    return ranges;
+}
+
+void runRobustAnalyticLevenbergMarquardtValidationTests()
+{
+    std::mt19937_64 rng = makeRandomEngine(5151);
+    const Eigen::Vector3d truePosition(0.5, -0.25, 1.0);
+    constexpr double sigma = 0.1;
+    constexpr double robustLossParam = 5.0;
+
+    RobustLevenbergMarquardtOptions coldOptions;
+    coldOptions.warmStart = false;
+
+    size_t warmEvaluations = 0;
+    size_t coldEvaluations = 0;
+    for (size_t anchorCount = 4; anchorCount <= 32; anchorCount *= 2) {
+        for (size_t trial = 0; trial < 50; ++trial) {
+            const std::vector<Eigen::Vector3d> anchors = makeBenchmarkAnchors(anchorCount, Eigen::Vector3d::Zero(), rng);
+            const std::vector<double> ranges = generateOutlierContaminatedRanges(truePosition, anchors, sigma, 0.2, 3.0, rng);
+
+            const RobustLevenbergMarquardtResult warm =
+                robustNonLinearLeastSquaresAnalyticLevenbergMarquardt(anchors, ranges, sigma, robustLossParam);
+            const RobustLevenbergMarquardtResult cold =
+                robustNonLinearLeastSquaresAnalyticLevenbergMarquardt(anchors, ranges, sigma, robustLossParam, coldOptions);
+            assert(warm.weights.size() == anchorCount);
+            assert(warm.outerIterations >= 1 && warm.outerIterations <= 10);
+            assert(warm.functionEvaluations > warm.innerIterations);
+
+            // Both IRLS loops stop on a 1e-6 change in the weighted residual norm, so agreement is to that scale
+            const Eigen::Vector3d eigenEstimate =
+                robustNonLinearLeastSquaresEigenLevenbergMarquardt(anchors, ranges, sigma, robustLossParam);
+            assert((warm.position - eigenEstimate).norm() < 5e-3);
+            assert((warm.position - cold.position).norm() < 5e-3);
+
+            warmEvaluations += warm.functionEvaluations;
+            coldEvaluations += cold.functionEvaluations;
+        }
+    }
+    assert(warmEvaluations <= coldEvaluations);
+
+    // A gross outlier is down-weighted
+    const std::vector<Eigen::Vector3d> anchors = makeBenchmarkAnchors(8, Eigen::Vector3d::Zero(), rng);
+    std::vector<double> ranges = generateNoisyRanges(truePosition, anchors, 0.05, rng);
+    ranges[3] += 5.0;
+    RobustRangeLevenbergMarquardt irlsSolver;
+    const RobustLevenbergMarquardtResult& result =
+        irlsSolver.minimize(anchors, ranges, 0.05, robustLossParam, ordinaryLeastSquaresWikipedia2(anchors, ranges));
+    assert(result.converged);
+    assert(result.weights[3] < 0.01);
+    assert((result.position - truePosition).norm() < 0.2);
+
+    std::cout << "Robust analytic Levenberg-Marquardt validation tests passed.\n" << std::flush;
+}
+
+void runMeasurementViewValidationTests()
+{
+    std::mt19937_64 rng = makeRandomEngine(1212);
+    const Eigen::Vector3d offset(25.0, -10.0, 3.0);
+    const std::vector<Eigen::Vector3d> anchors = makeBenchmarkAnchors(8, offset, rng);
+    const Eigen::Vector3d truePosition = offset + Eigen::Vector3d(1.5, -2.0, 0.5);
+    constexpr double rangeStdDev = 0.05;
+    const std::vector<double> ranges = generateNoisyRanges(truePosition, anchors, rangeStdDev, rng);
+    const size_t N = anchors.size();
+
+    auto assertSamePosition = [](const Eigen::Vector3d& actual, const Eigen::Vector3d& expected) {
+        assert((actual - expected).norm() <= 1e-9 * std::max(1.0, expected.norm()));
+    };
+
+    // Interleaved caller records: anchors and ranges are both strided views into the same array
+    struct MeasurementRecord {
+        double x, y, z;
+        double range;
+    };
+    std::vector<MeasurementRecord> records(N);
+    for (size_t i = 0; i < N; ++i) {
+        records[i] = {anchors[i].x(), anchors[i].y(), anchors[i].z(), ranges[i]};
+    }
+    constexpr std::ptrdiff_t recordStride = sizeof(MeasurementRecord) / sizeof(double);
+    const AnchorPositionsView recordAnchors(&records[0].x, N, recordStride);
+    const RangesView recordRanges(&records[0].range, N, recordStride);
+
+    // The same records seen through Eigen::Map
+    const Eigen::Map<const Eigen::Matrix3Xd, 0, Eigen::OuterStride<>> anchorColumns(
+        &records[0].x, 3, static_cast<Eigen::Index>(N), Eigen::OuterStride<>(recordStride));
+    const Eigen::Map<const Eigen::VectorXd, 0, Eigen::InnerStride<>> rangeMap(
+        &records[0].range, static_cast<Eigen::Index>(N), Eigen::InnerStride<>(recordStride));
+
+    // float32 sources are widened on read, so they must match a double solve of the rounded values
+    std::vector<Eigen::Vector3f> anchorsFloat(N);
+    std::vector<float> rangesFloat(N);
+    std::vector<Eigen::Vector3d> roundedAnchors(N);
+    std::vector<double> roundedRanges(N);
+    for (size_t i = 0; i < N; ++i) {
+        anchorsFloat[i] = anchors[i].cast<float>();
+        rangesFloat[i] = static_cast<float>(ranges[i]);
+        roundedAnchors[i] = anchorsFloat[i].cast<double>();
+        roundedRanges[i] = static_cast<double>(rangesFloat[i]);
+    }
+    const AnchorPositionsView floatAnchors{std::span<const Eigen::Vector3f>(anchorsFloat)};
+    const RangesView floatRanges{std::span<const float>(rangesFloat)};
+
+    for (size_t id = 0; id < algorithmCount; ++id) {
+        const AlgorithmId algorithm = static_cast<AlgorithmId>(id);
+        const Eigen::Vector3d expected = runAlgorithm(algorithm, anchors, ranges, rangeStdDev);
+        assertSamePosition(runAlgorithm(algorithm, recordAnchors, recordRanges, rangeStdDev), expected);
+        assertSamePosition(runAlgorithm(algorithm, anchorColumns, rangeMap, rangeStdDev), expected);
+
+        const Eigen::Vector3d expectedRounded = runAlgorithm(algorithm, roundedAnchors, roundedRanges, rangeStdDev);
+        assertSamePosition(runAlgorithm(algorithm, floatAnchors, floatRanges, rangeStdDev), expectedRounded);
+        assert((expectedRounded - expected).norm() < 1e-2);
+    }
+
+    // Direct estimator overloads that runAlgorithm does not reach
+    assertSamePosition(
+        ordinaryLeastSquaresWikipediaFast(recordAnchors, recordRanges),
+        ordinaryLeastSquaresWikipediaFast(anchors, ranges));
+    const std::vector<double> rangeStdDevs(N, rangeStdDev);
+    assertSamePosition(
+        twoStepWeightedLinearLeastSquaresI_YueWang(recordAnchors, recordRanges, RangesView(rangeStdDevs)),
+        twoStepWeightedLinearLeastSquaresI_YueWang(anchors, ranges, rangeStdDevs));
+
+    const RobustLevenbergMarquardtResult robustExpected =
+        robustNonLinearLeastSquaresAnalyticLevenbergMarquardt(anchors, ranges, rangeStdDev, 5.0);
+    const RobustLevenbergMarquardtResult robustView =
+        robustNonLinearLeastSquaresAnalyticLevenbergMarquardt(recordAnchors, recordRanges, rangeStdDev, 5.0);
+    assertSamePosition(robustView.position, robustExpected.position);
+    assert(robustView.outerIterations == robustExpected.outerIterations);
+    assert(robustView.weights.size() == N);
+
+    const AnchorGeometry geometry(anchors);
+    assertSamePosition(ordinaryLeastSquaresWikipedia2(geometry, recordRanges), ordinaryLeastSquaresWikipedia2(geometry, ranges));
+    assertSamePosition(linearLeastSquaresI_YueWang(geometry, rangeMap), linearLeastSquaresI_YueWang(geometry, ranges));
+    assertSamePosition(linearLeastSquaresII_2_YueWang(geometry, recordRanges), linearLeastSquaresII_2_YueWang(geometry, ranges));
+
+    // A span over part of a caller buffer solves only that part
+    const std::span<const Eigen::Vector3d> leadingAnchors(anchors.data(), 6);
+    const std::span<const double> leadingRanges(ranges.data(), 6);
+    const std::vector<Eigen::Vector3d> leadingAnchorsCopy(anchors.begin(), anchors.begin() + 6);
+    const std::vector<double> leadingRangesCopy(ranges.begin(), ranges.begin() + 6);
+    assertSamePosition(
+        linearLeastSquaresI_YueWang(leadingAnchors, leadingRanges),
+        linearLeastSquaresI_YueWang(leadingAnchorsCopy, leadingRangesCopy));
+
+    bool rejectedMismatch = false;
+    try {
+        ordinaryLeastSquaresWikipedia2(geometry, RangesView(ranges.data(), N - 1));
+    } catch (const std::invalid_argument&) {
+        rejectedMismatch = true;
+    }
+    assert(rejectedMismatch);
+
+    std::cout << "Measurement view validation tests passed.\n" << std::flush;
+}
+
+void runFixedSizeAnchorCountValidationTests()
+{
+    std::mt19937_64 rng = makeRandomEngine(1313);
+    const Eigen::Vector3d offset(-30.0, 12.0, 4.0);
+
+    auto assertClose = [](const Eigen::Vector3d& actual, const Eigen::Vector3d& expected, double tolerance) {
+        assert((actual - expected).norm() <= tolerance * std::max(1.0, expected.norm()));
+    };
+
+    // 4, 6 and 8 anchors take the fixed-size path; 5 and 12 exercise the dynamic fallback next to them.
+    // The references are the dynamic, separately factored AnchorGeometry and single-pass OLS solvers.
+    for (const size_t anchorCount : {4u, 5u, 6u, 8u, 12u}) {
+        for (const bool coplanar : {false, true}) {
+            std::vector<Eigen::Vector3d> anchors = makeBenchmarkAnchors(anchorCount, offset, rng);
+            if (coplanar) {
+                for (Eigen::Vector3d& anchor : anchors) {
+                    anchor.z() = offset.z();
+                }
+            }
+            const AnchorGeometry geometry(anchors);
+
+            std::uniform_real_distribution<double> tagDist(-8.0, 8.0);
+            for (size_t trial = 0; trial < 16; ++trial) {
+                const Eigen::Vector3d tagPosition = offset + Eigen::Vector3d(tagDist(rng), tagDist(rng), tagDist(rng));
+                const std::vector<double> ranges = generateNoisyRanges(tagPosition, anchors, 0.05, rng);
+
+                assertClose(ordinaryLeastSquaresWikipedia2(anchors, ranges), ordinaryLeastSquaresWikipedia2(geometry, ranges), 1e-8);
+                assertClose(linearLeastSquaresI_YueWang(anchors, ranges), linearLeastSquaresI_YueWang(geometry, ranges), 1e-8);
+                assertClose(linearLeastSquaresII_2_YueWang(anchors, ranges), linearLeastSquaresII_2_YueWang(geometry, ranges), 1e-8);
+                if (!coplanar) {
+                    assertClose(ordinaryLeastSquaresWikipedia(anchors, ranges), ordinaryLeastSquaresWikipediaFast(anchors, ranges), 1e-8);
+                }
+            }
+
+            if (!coplanar) {
+                const Eigen::Vector3d tagPosition = offset + Eigen::Vector3d(2.0, -3.0, 1.5);
+                const std::vector<double> exactRanges = generateNoisyRanges(tagPosition, anchors, 0.0, rng);
+                const std::vector<double> rangeStdDevs(anchorCount, 0.05);
+                assertClose(twoStepWeightedLinearLeastSquaresI_YueWang(anchors, exactRanges, rangeStdDevs), tagPosition, 1e-6);
+                assertClose(nonLinearLeastSquaresEigenLevenbergMarquardt(anchors, exactRanges), tagPosition, 1e-6);
+            }
+        }
+    }
+
+    std::cout << "Fixed-size anchor count validation tests passed.\n" << std::flush;
+}
+
+void runMixedPrecisionValidationTests()
+{
+    std::mt19937_64 rng = makeRandomEngine(1818);
+    // A 20 m site placed far from the origin, where uncentred squared norms would exhaust float's mantissa
+    const Eigen::Vector3d offset(500.0, -300.0, 10.0);
+    std::uniform_real_distribution<double> tagDist(-8.0, 8.0);
+
+    using LinearFunction = Eigen::Vector3d (*)(const std::vector<Eigen::Vector3d>&, const std::vector<double>&);
+    using MixedFunction = Eigen::Vector3d (*)(
+        const AnchorPositionsView&, const RangesView&, const MixedPrecisionOptions&, SolveResult*);
+    struct MixedCase {
+        LinearFunction reference;
+        MixedFunction centredDouble;
+        MixedFunction centredFloat;
+        int rank;
+    };
+    const MixedCase cases[] = {
+        {ordinaryLeastSquaresWikipedia2, ordinaryLeastSquaresWikipedia2Mixed<double>, ordinaryLeastSquaresWikipedia2Mixed<float>, 3},
+        {linearLeastSquaresI_YueWang, linearLeastSquaresI_YueWangMixed<double>, linearLeastSquaresI_YueWangMixed<float>, 4},
+        {linearLeastSquaresII_2_YueWang, linearLeastSquaresII_2_YueWangMixed<double>, linearLeastSquaresII_2_YueWangMixed<float>, 3},
+    };
+
+    MixedPrecisionOptions alwaysRefine;
+    alwaysRefine.refinementTolerance = 0.0;
+    MixedPrecisionOptions neverRefine;
+    neverRefine.refinementTolerance = std::numeric_limits<double>::infinity();
+
+    for (const size_t anchorCount : {8u, 16u, 64u}) {
+        const std::vector<Eigen::Vector3d> anchors = makeBenchmarkAnchors(anchorCount, offset, rng);
+        for (size_t trial = 0; trial < 8; ++trial) {
+            const Eigen::Vector3d tagPosition = offset + Eigen::Vector3d(tagDist(rng), tagDist(rng), tagDist(rng));
+            const std::vector<double> ranges = generateNoisyRanges(tagPosition, anchors, 0.05, rng);
+            const std::vector<double> exactRanges = generateNoisyRanges(tagPosition, anchors, 0.0, rng);
+
+            for (const MixedCase& c : cases) {
+                // Centring does not change the least-squares solution
+                const Eigen::Vector3d expected = c.reference(anchors, ranges);
+                SolveResult doubleDiagnostics;
+                const Eigen::Vector3d centred = c.centredDouble(anchors, ranges, MixedPrecisionOptions{}, &doubleDiagnostics);
+                assert((centred - expected).norm() <= 1e-8 * std::max(1.0, expected.norm()));
+                assert(doubleDiagnostics.iterations == 0);
+                assert(doubleDiagnostics.rank == c.rank);
+
+                // float agrees with double to well below the range noise, with or without refinement
+                const Eigen::Vector3d single = c.centredFloat(anchors, ranges, MixedPrecisionOptions{}, nullptr);
+                assert((single - expected).norm() <= 1e-3);
+
+                SolveResult refinedDiagnostics;
+                const Eigen::Vector3d refined = c.centredFloat(anchors, ranges, alwaysRefine, &refinedDiagnostics);
+                assert(refinedDiagnostics.iterations == 1);
+                assert((refined - expected).norm() <= 1e-3);
+
+                SolveResult unrefinedDiagnostics;
+                const Eigen::Vector3d unrefined = c.centredFloat(anchors, ranges, neverRefine, &unrefinedDiagnostics);
+                assert(unrefinedDiagnostics.iterations == 0);
+                assert((unrefined - expected).norm() <= 1e-3);
+
+                assert((c.centredFloat(anchors, exactRanges, MixedPrecisionOptions{}, nullptr) - tagPosition).norm() <= 1e-3);
+            }
+        }
+    }
+
+    std::cout << "Mixed-precision linear solver validation tests passed.\n" << std::flush;
+}
+
+void runSolveDiagnosticsValidationTests()
+{
+    std::mt19937_64 rng = makeRandomEngine(1717);
+    const Eigen::Vector3d tagPosition(1.0, -0.5, 2.0);
+
+    for (const bool coplanar : {false, true}) {
+        std::vector<Eigen::Vector3d> anchors = makeBenchmarkAnchors(7, Eigen::Vector3d::Zero(), rng);
+        if (coplanar) {
+            for (Eigen::Vector3d& anchor : anchors) {
+                anchor.z() = 0.0;
+            }
+        }
+        const std::vector<double> ranges = generateNoisyRanges(tagPosition, anchors, 0.3, 0.2, 3.0, rng);
+
+        for (size_t index = 0; index < algorithmCount; ++index) {
+            const AlgorithmId algorithm = static_cast<AlgorithmId>(index);
+            // Both need non-coplanar anchors (the TS-WLLS-I second step divides by each coordinate)
+            if (coplanar && (algorithm == AlgorithmId::OrdinaryLeastSquaresWikipedia
+                || algorithm == AlgorithmId::TwoStepWeightedLinearLeastSquaresIYueWang)) {
+                continue;
+            }
+            const SolveResult result = runAlgorithmWithDiagnostics(algorithm, anchors, ranges, 0.3);
+
+            // Same estimate as runAlgorithm, with the unweighted cost at that estimate
+            assert(result.position == runAlgorithm(algorithm, anchors, ranges, 0.3));
+            assert(result.finalCost == rangeResidualCost(anchors, ranges, result.position));
+            assert(result.timings.setupNs >= 0 && result.timings.factorizationNs >= 0 && result.timings.refinementNs >= 0);
+            assert(result.timings.setupNs + result.timings.factorizationNs + result.timings.refinementNs > 0);
+
+            const bool nonlinear = algorithm == AlgorithmId::NonLinearLeastSquaresEigenLm
+                || algorithm == AlgorithmId::RobustNonLinearLeastSquaresEigenLm
+                || algorithm == AlgorithmId::NonLinearLeastSquaresAnalyticLm
+                || algorithm == AlgorithmId::RobustNonLinearLeastSquaresAnalyticLm;
+            const bool robust = algorithm == AlgorithmId::RobustNonLinearLeastSquaresEigenLm
+                || algorithm == AlgorithmId::RobustNonLinearLeastSquaresAnalyticLm;
+            assert((result.iterations > 0) == nonlinear);
+            assert((result.functionEvaluations > 0) == nonlinear);
+            assert((result.outerIterations > 0) == robust);
+
+            // The nonlinear solvers report the rank of their BDCSVD initial guess; LLS-I has the extra R^2 column
+            if (algorithm == AlgorithmId::OrdinaryLeastSquaresWikipedia) {
+                assert(result.rank == -1);
+            } else if (algorithm == AlgorithmId::LinearLeastSquaresIYueWang
+                || algorithm == AlgorithmId::TwoStepWeightedLinearLeastSquaresIYueWang) {
+                assert(result.rank == (coplanar ? 3 : 4));
+            } else {
+                assert(result.rank == (coplanar ? 2 : 3));
+            }
+        }
+
+        if (!coplanar) {
+            // The LM solvers minimise this cost, so they end below the linear estimate they start from
+            const double linearCost = runAlgorithmWithDiagnostics(AlgorithmId::OrdinaryLeastSquaresWikipediaBdcsvd, anchors, ranges, 0.3).finalCost;
+            for (const AlgorithmId algorithm : {AlgorithmId::NonLinearLeastSquaresEigenLm, AlgorithmId::NonLinearLeastSquaresAnalyticLm}) {
+                const SolveResult result = runAlgorithmWithDiagnostics(algorithm, anchors, ranges, 0.3);
+                assert(result.converged);
+                assert(result.finalCost <= linearCost);
+            }
+
+            const RobustLevenbergMarquardtResult robust = robustNonLinearLeastSquaresAnalyticLevenbergMarquardt(anchors, ranges, 0.3, 5.0);
+            const SolveResult robustDiagnostics = runAlgorithmWithDiagnostics(AlgorithmId::RobustNonLinearLeastSquaresAnalyticLm, anchors, ranges, 0.3);
+            assert(robustDiagnostics.iterations == robust.innerIterations);
+            assert(robustDiagnostics.outerIterations == robust.outerIterations);
+            assert(robustDiagnostics.functionEvaluations == robust.functionEvaluations);
+            assert(robustDiagnostics.converged == robust.converged);
+
+            // A one-iteration limit is reported as not converged
+            LevenbergMarquardtOptions options;
+            options.maxIterations = 1;
+            SolveResult limited;
+            nonLinearLeastSquaresAnalyticLevenbergMarquardt(anchors, ranges, options, &limited);
+            assert(limited.iterations == 1);
+            assert(!limited.converged);
+        }
+    }
+
+    // SimulationRunner aggregates one SolveResult per run without changing the estimates, and
+    // the summary is independent of the thread count
+    TestParameters params;
+    params.truePosition = tagPosition;
+    params.anchorPositions = makeBenchmarkAnchors(6, Eigen::Vector3d::Zero(), rng);
+    params.rangeNoiseStdDev = 0.1;
+    params.rangeOutlierRatio = 0.1;
+    params.rangeOutlierMagnitude = 2.0;
+    params.randomSeed = 4242;
+    params.numRuns = 97;
+    params.algorithm = AlgorithmId::RobustNonLinearLeastSquaresAnalyticLm;
+
+    auto runToCompletion = [&params](const ExecutionMode mode, const size_t numThreads, const bool collect) {
+        TestParameters runParams = params;
+        runParams.executionMode = mode;
+        runParams.numThreads = numThreads;
+        runParams.collectSolveDiagnostics = collect;
+        auto runner = std::make_unique<SimulationRunner>();
+        runner->begin(runParams);
+        while (runner->status() == SimulationRunner::Status::Running) {
+            runner->step(20);
+        }
+        assert(runner->status() == SimulationRunner::Status::Completed);
+        return runner;
+    };
+
+    for (const ExecutionMode mode : {ExecutionMode::Serial, ExecutionMode::Parallel}) {
+        const auto plain = runToCompletion(mode, 1, false);
+        const auto diagnosed = runToCompletion(mode, 1, true);
+        assert(plain->solveDiagnostics().count() == 0);
+        assert(diagnosed->estimatedPositions() == plain->estimatedPositions());
+
+        const SolveDiagnosticsSummary summary = diagnosed->solveDiagnostics().summary();
+        assert(summary.count == params.numRuns);
+        assert(summary.meanOuterIterations >= 1.0);
+        assert(summary.meanIterations > 0.0 && static_cast<double>(summary.maxIterations) >= summary.meanIterations);
+        assert(summary.minRank == 3);
+        assert(summary.meanFinalCost > 0.0);
+
+        if (mode == ExecutionMode::Parallel) {
+            const SolveDiagnosticsSummary threaded = runToCompletion(mode, 3, true)->solveDiagnostics().summary();
+            assert(threaded.meanFinalCost == summary.meanFinalCost);
+            assert(threaded.meanIterations == summary.meanIterations);
+            assert(threaded.meanFunctionEvaluations == summary.meanFunctionEvaluations);
+            assert(threaded.nonConvergedCount == summary.nonConvergedCount);
+        }
+    }
+
+    std::cout << "Solve diagnostics validation tests passed.\n" << std::flush;
+}
+
+void runOrdinaryLeastSquaresFastPathBenchmark()
+{
+    constexpr size_t inputSetCount = 256;
+    constexpr size_t fixesPerAnchorCount = 50000;
+
+    std::cout << "\n\nBenchmark -- Ordinary Least Squares (Wikipedia) vs allocation-free fast path\n";
+
+    std::mt19937_64 rng = makeRandomEngine(7);
+    const Eigen::Vector3d truePosition(0.5, -0.25, 1.0);
+
+    for (size_t anchorCount = 4; anchorCount <= 64; anchorCount *= 2) {
+        std::vector<std::vector<Eigen::Vector3d>> anchorSets;
+        std::vector<std::vector<double>> rangeSets;
+        anchorSets.reserve(inputSetCount);
+        rangeSets.reserve(inputSetCount);
+        for (size_t i = 0; i < inputSetCount; ++i) {
+            anchorSets.push_back(makeBenchmarkAnchors(anchorCount, Eigen::Vector3d::Zero(), rng));
+            rangeSets.push_back(generateNoisyRanges(truePosition, anchorSets.back(), 0.1, rng));
+        }
+
+        auto timeMethod = [&](const auto& method) {
+            Eigen::Vector3d checksum = Eigen::Vector3d::Zero();
+            const auto t0 = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < fixesPerAnchorCount; ++i) {
+                const size_t set = i % inputSetCount;
+                checksum += method(anchorSets[set], rangeSets[set]);
+            }
+            const auto t1 = std::chrono::steady_clock::now();
+            // Keep the results observable so the loop cannot be optimised away.
+            volatile double sink = checksum.sum();
+            (void)sink;
+            return std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(fixesPerAnchorCount);
+        };
+
+        const double referenceNs = timeMethod(static_cast<MultilaterationFunction>(ordinaryLeastSquaresWikipedia));
+        const double fastNs = timeMethod(static_cast<MultilaterationFunction>(ordinaryLeastSquaresWikipediaFast));
+
+        std::cout << std::format("  N = {:>2}: reference {:>9.1f} ns/fix, fast path {:>8.1f} ns/fix, speedup {:.2f}x\n",
+            anchorCount, referenceNs, fastNs, referenceNs / fastNs);
+    }
+}
+
+void runTwoStepWeightedFastPathBenchmark()
+{
+    constexpr size_t inputSetCount = 256;
+    constexpr size_t fixesPerAnchorCount = 50000;
+
+    std::cout << "\n\nBenchmark -- Two-Step Weighted LLS-I (Yue Wang) vs allocation-free fast path\n";
+
+    std::mt19937_64 rng = makeRandomEngine(17);
+    const Eigen::Vector3d truePosition(0.5, -0.25, 1.0);
+
+    for (size_t anchorCount = 4; anchorCount <= 64; anchorCount *= 2) {
+        std::vector<std::vector<Eigen::Vector3d>> anchorSets;
+        std::vector<std::vector<double>> rangeSets;
+        anchorSets.reserve(inputSetCount);
+        rangeSets.reserve(inputSetCount);
+        for (size_t i = 0; i < inputSetCount; ++i) {
+            anchorSets.push_back(makeBenchmarkAnchors(anchorCount, Eigen::Vector3d::Zero(), rng));
+            rangeSets.push_back(generateNoisyRanges(truePosition, anchorSets.back(), 0.1, rng));
+        }
+        const std::vector<double> rangeStdDevs(anchorCount, 0.1);
+
+        auto timeMethod = [&](const auto& method) {
+            Eigen::Vector3d checksum = Eigen::Vector3d::Zero();
+            const auto t0 = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < fixesPerAnchorCount; ++i) {
+                const size_t set = i % inputSetCount;
+                checksum += method(anchorSets[set], rangeSets[set], rangeStdDevs);
+            }
+            const auto t1 = std::chrono::steady_clock::now();
+            // Keep the results observable so the loop cannot be optimised away.
+            volatile double sink = checksum.sum();
+            (void)sink;
+            return std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(fixesPerAnchorCount);
+        };
+
+        using TwoStepFunction = Eigen::Vector3d (*)(
+            const std::vector<Eigen::Vector3d>&, const std::vector<double>&, const std::vector<double>&);
+        const double referenceNs = timeMethod(static_cast<TwoStepFunction>(twoStepWeightedLinearLeastSquaresI_YueWang));
+        const double fastNs = timeMethod(static_cast<TwoStepFunction>(twoStepWeightedLinearLeastSquaresI_YueWangFast));
+
+        std::cout << std::format("  N = {:>2}: reference {:>9.1f} ns/fix, fast path {:>8.1f} ns/fix, speedup {:.2f}x\n",
+            anchorCount, referenceNs, fastNs, referenceNs / fastNs);
+    }
+}
+
+void runLinearLeastSquaresIICacheBenchmark()
+{
+    constexpr size_t inputSetCount = 256;
+    constexpr size_t fixesPerAnchorCount = 50000;
+
+    std::cout << "\n\nBenchmark -- LLS-II-2: per-fix SVD vs cached per-reference pseudo-inverse (static anchors)\n";
+
+    std::mt19937_64 rng = makeRandomEngine(13);
+    std::uniform_real_distribution<double> tagDist(-8.0, 8.0);
+
+    for (size_t anchorCount = 4; anchorCount <= 64; anchorCount *= 2) {
+        // One static anchor set; the tags move so the shortest-range reference changes between fixes
+        const std::vector<Eigen::Vector3d> anchors = makeBenchmarkAnchors(anchorCount, Eigen::Vector3d::Zero(), rng);
+        std::vector<std::vector<double>> rangeSets;
+        rangeSets.reserve(inputSetCount);
+        for (size_t i = 0; i < inputSetCount; ++i) {
+            const Eigen::Vector3d tagPosition(tagDist(rng), tagDist(rng), tagDist(rng));
+            rangeSets.push_back(generateNoisyRanges(tagPosition, anchors, 0.1, rng));
+        }
+
+        const auto buildStart = std::chrono::steady_clock::now();
+        const AnchorGeometry geometry(anchors);
+        geometry.precomputeLinearLeastSquaresII();
+        const auto buildEnd = std::chrono::steady_clock::now();
+
+        auto timeMethod = [&](const auto& method) {
+            Eigen::Vector3d checksum = Eigen::Vector3d::Zero();
+            const auto t0 = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < fixesPerAnchorCount; ++i) {
+                checksum += method(rangeSets[i % inputSetCount]);
+            }
+            const auto t1 = std::chrono::steady_clock::now();
+            // Keep the results observable so the loop cannot be optimised away.
+            volatile double sink = checksum.sum();
+            (void)sink;
+            return std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(fixesPerAnchorCount);
+        };
+
+        const double directNs = timeMethod([&](const std::vector<double>& ranges) {
+            return linearLeastSquaresII_2_YueWang(anchors, ranges);
+        });
+        const double cachedNs = timeMethod([&](const std::vector<double>& ranges) {
+            return linearLeastSquaresII_2_YueWang(geometry, ranges);
+        });
+        const double buildUs = std::chrono::duration<double, std::micro>(buildEnd - buildStart).count();
+
+        std::cout << std::format("  N = {:>2}: per-fix SVD {:>9.1f} ns/fix, cached {:>8.1f} ns/fix, speedup {:.2f}x, precompute {:.1f} us\n",
+            anchorCount, directNs, cachedNs, directNs / cachedNs, buildUs);
+    }
+}
+
+void runIncrementalLinearLeastSquaresBenchmark()
+{
+    constexpr size_t arrivalsPerAnchorCount = 200000;
+
+    std::cout << "\n\nBenchmark -- LLS-I: full re-solve vs incremental update per arriving range\n";
+
+    std::mt19937_64 rng = makeRandomEngine(19);
+    std::uniform_real_distribution<double> stepDist(-0.02, 0.02);
+
+    for (size_t anchorCount = 4; anchorCount <= 64; anchorCount *= 2) {
+        const std::vector<Eigen::Vector3d> anchors = makeBenchmarkAnchors(anchorCount, Eigen::Vector3d::Zero(), rng);
+
+        // A slowly moving tag ranged by one anchor per arrival, round robin
+        std::vector<double> arrivals(arrivalsPerAnchorCount);
+        Eigen::Vector3d tagPosition(0.5, -0.25, 1.0);
+        for (size_t k = 0; k < arrivalsPerAnchorCount; ++k) {
+            tagPosition += Eigen::Vector3d(stepDist(rng), stepDist(rng), stepDist(rng));
+            arrivals[k] = generateNoisyRange(tagPosition, anchors[k % anchorCount], 0.1, rng);
+        }
+        std::vector<double> initialRanges(anchorCount);
+        for (size_t i = 0; i < anchorCount; ++i) {
+            initialRanges[i] = (anchors[i] - tagPosition).norm();
+        }
+
+        auto timeArrivals = [&](const auto& onArrival) {
+            Eigen::Vector3d checksum = Eigen::Vector3d::Zero();
+            const auto t0 = std::chrono::steady_clock::now();
+            for (size_t k = 0; k < arrivalsPerAnchorCount; ++k) {
+                checksum += onArrival(k % anchorCount, arrivals[k]);
+            }
+            const auto t1 = std::chrono::steady_clock::now();
+            // Keep the results observable so the loop cannot be optimised away.
+            volatile double sink = checksum.sum();
+            (void)sink;
+            return std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(arrivalsPerAnchorCount);
+        };
+
+        std::vector<double> ranges = initialRanges;
+        const double resolveNs = timeArrivals([&](size_t anchorIndex, double range) {
+            ranges[anchorIndex] = range;
+            return linearLeastSquaresI_YueWang(anchors, ranges);
+        });
+
+        IncrementalLinearLeastSquaresI estimator(anchors);
+        for (size_t i = 0; i < anchorCount; ++i) {
+            estimator.setRange(i, initialRanges[i]);
+        }
+        const double incrementalNs = timeArrivals([&](size_t anchorIndex, double range) {
+            estimator.setRange(anchorIndex, range);
+            return estimator.estimate();
+        });
+
+        std::cout << std::format("  N = {:>2}: re-solve {:>9.1f} ns/fix, incremental {:>8.1f} ns/fix, speedup {:.2f}x\n",
+            anchorCount, resolveNs, incrementalNs, resolveNs / incrementalNs);
+    }
+}
+
+void runRangeTrackerBenchmark()
+{
+    constexpr size_t anchorCount = 16;
+    constexpr size_t epochCount = 20000;
+    constexpr double epochInterval = 0.02;
+    constexpr double rangeStdDev = 0.1;
+
+    std::cout << "\n\nBenchmark -- Tracking at 50 Hz, 16 anchors: standalone analytic LM vs RangeTracker\n";
+
+    std::mt19937_64 rng = makeRandomEngine(20);
+    const Eigen::Vector3d offset = Eigen::Vector3d::Zero();
+    const std::vector<Eigen::Vector3d> anchors = makeBenchmarkAnchors(anchorCount, offset, rng);
+    std::vector<Eigen::Vector3d> tagPositions(epochCount);
+    std::vector<std::vector<double>> rangeSets(epochCount);
+    for (size_t k = 0; k < epochCount; ++k) {
+        tagPositions[k] = trackedTagPosition(offset, static_cast<double>(k) * epochInterval);
+        rangeSets[k] = generateNoisyRanges(tagPositions[k], anchors, rangeStdDev, rng);
+    }
+
+    // Each method returns the estimate and the LM iterations it spent on one epoch
+    auto timeEpochs = [&](const std::string& label, const auto& method) {
+        double squaredError = 0.0;
+        size_t iterations = 0;
+        const auto t0 = std::chrono::steady_clock::now();
+        for (size_t k = 0; k < epochCount; ++k) {
+            const auto [position, epochIterations] = method(k);
+            squaredError += (position - tagPositions[k]).squaredNorm();
+            iterations += epochIterations;
+        }
+        const auto t1 = std::chrono::steady_clock::now();
+        const double epochs = static_cast<double>(epochCount);
+        std::cout << std::format("  {:<28} {:>8.1f} ns/epoch, {:>5.2f} LM iterations/epoch, RMS error {:.4f} m\n",
+            label, std::chrono::duration<double, std::nano>(t1 - t0).count() / epochs,
+            static_cast<double>(iterations) / epochs, std::sqrt(squaredError / epochs));
+    };
+
+    timeEpochs("Standalone analytic LM", [&](size_t k) {
+        SolveResult diagnostics;
+        const Eigen::Vector3d position = nonLinearLeastSquaresAnalyticLevenbergMarquardt(
+            anchors, rangeSets[k], LevenbergMarquardtOptions{}, &diagnostics);
+        return std::pair<Eigen::Vector3d, size_t>(position, diagnostics.iterations);
+    });
+
+    for (const bool levenbergMarquardtRefinement : {false, true}) {
+        RangeTrackerOptions options;
+        options.rangeStdDev = rangeStdDev;
+        options.levenbergMarquardtRefinement = levenbergMarquardtRefinement;
+        RangeTracker tracker(options);
+        timeEpochs(levenbergMarquardtRefinement ? "Tracker, LM seeded" : "Tracker, sequential EKF", [&](size_t k) {
+            const RangeTrackerUpdate update = tracker.update(static_cast<double>(k) * epochInterval, anchors, rangeSets[k]);
+            return std::pair<Eigen::Vector3d, size_t>(update.position, update.iterations);
+        });
+    }
+}
+
+void runLevenbergMarquardtBenchmark()
+{
+    constexpr size_t inputSetCount = 256;
+    constexpr size_t fixesPerAnchorCount = 5000;
+
+    std::cout << "\n\nBenchmark -- Nonlinear Least Squares: Eigen LM (NumericalDiff) vs analytic-Jacobian LM\n";
+
+    std::mt19937_64 rng = makeRandomEngine(11);
+    const Eigen::Vector3d truePosition(0.5, -0.25, 1.0);
+
+    for (size_t anchorCount = 4; anchorCount <= 64; anchorCount *= 2) {
+        std::vector<std::vector<Eigen::Vector3d>> anchorSets;
+        std::vector<std::vector<double>> rangeSets;
+        anchorSets.reserve(inputSetCount);
+        rangeSets.reserve(inputSetCount);
+        for (size_t i = 0; i < inputSetCount; ++i) {
+            anchorSets.push_back(makeBenchmarkAnchors(anchorCount, Eigen::Vector3d::Zero(), rng));
+            rangeSets.push_back(generateNoisyRanges(truePosition, anchorSets.back(), 0.1, rng));
+        }
+
+        auto timeMethod = [&](const auto& method, double& rmsError) {
+            double squaredErrorSum = 0.0;
+            const auto t0 = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < fixesPerAnchorCount; ++i) {
+                const size_t set = i % inputSetCount;
+                squaredErrorSum += (method(anchorSets[set], rangeSets[set]) - truePosition).squaredNorm();
+            }
+            const auto t1 = std::chrono::steady_clock::now();
+            rmsError = std::sqrt(squaredErrorSum / static_cast<double>(fixesPerAnchorCount));
+            return std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(fixesPerAnchorCount);
+        };
+
+        double eigenRmsError = 0.0;
+        double analyticRmsError = 0.0;
+        const double eigenNs = timeMethod(
+            static_cast<MultilaterationFunction>(nonLinearLeastSquaresEigenLevenbergMarquardt), eigenRmsError);
+        const double analyticNs = timeMethod(
+            static_cast<MultilaterationFunction>(nonLinearLeastSquaresAnalyticLevenbergMarquardt), analyticRmsError);
+
+        std::cout << std::format(
+            "  N = {:>2}: Eigen LM {:>9.1f} ns/fix (RMS {:.4f} m), analytic LM {:>8.1f} ns/fix (RMS {:.4f} m), speedup {:.2f}x\n",
+            anchorCount, eigenNs, eigenRmsError, analyticNs, analyticRmsError, eigenNs / analyticNs);
+    }
+}
+
+void runRobustLevenbergMarquardtBenchmark()
+{
+    constexpr size_t inputSetCount = 256;
+    constexpr size_t fixesPerAnchorCount = 2048; // multiple of inputSetCount, so sweep averages cover the same inputs
+    constexpr double sigma = 0.1;
+    constexpr double robustLossParam = 5.0;
+
+    std::cout << "\n\nBenchmark -- Robust IRLS: Eigen LM vs warm-started analytic LM (20% outliers)\n";
+
+    std::mt19937_64 rng = makeRandomEngine(12);
+    const Eigen::Vector3d truePosition(0.5, -0.25, 1.0);
+
+    RobustLevenbergMarquardtOptions coldOptions;
+    coldOptions.warmStart = false;
+
+    for (size_t anchorCount = 4; anchorCount <= 64; anchorCount *= 2) {
+        std::vector<std::vector<Eigen::Vector3d>> anchorSets;
+        std::vector<std::vector<double>> rangeSets;
+        anchorSets.reserve(inputSetCount);
+        rangeSets.reserve(inputSetCount);
+        for (size_t i = 0; i < inputSetCount; ++i) {
+            anchorSets.push_back(makeBenchmarkAnchors(anchorCount, Eigen::Vector3d::Zero(), rng));
+            rangeSets.push_back(generateOutlierContaminatedRanges(truePosition, anchorSets.back(), sigma, 0.2, 3.0, rng));
+        }
+
+        volatile double sink = 0.0;
+        const auto t0 = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < fixesPerAnchorCount; ++i) {
+            const size_t set = i % inputSetCount;
+            sink = sink + robustNonLinearLeastSquaresEigenLevenbergMarquardt(anchorSets[set], rangeSets[set], sigma, robustLossParam).x();
+        }
+        const auto t1 = std::chrono::steady_clock::now();
+        size_t warmEvaluations = 0;
+        for (size_t i = 0; i < fixesPerAnchorCount; ++i) {
+            const size_t set = i % inputSetCount;
+            const RobustLevenbergMarquardtResult result =
+                robustNonLinearLeastSquaresAnalyticLevenbergMarquardt(anchorSets[set], rangeSets[set], sigma, robustLossParam);
+            sink = sink + result.position.x();
+            warmEvaluations += result.functionEvaluations;
+        }
+        const auto t2 = std::chrono::steady_clock::now();
+
+        size_t coldEvaluations = 0;
+        for (size_t set = 0; set < inputSetCount; ++set) {
+            coldEvaluations += robustNonLinearLeastSquaresAnalyticLevenbergMarquardt(
+                anchorSets[set], rangeSets[set], sigma, robustLossParam, coldOptions).functionEvaluations;
+        }
+
+        const double fixes = static_cast<double>(fixesPerAnchorCount);
+        const double eigenNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / fixes;
+        const double analyticNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / fixes;
+        std::cout << std::format(
+            "  N = {:>2}: Eigen IRLS {:>9.1f} ns/fix, analytic IRLS {:>8.1f} ns/fix, speedup {:.2f}x, "
+            "sweeps/fix {:.2f} (warm) vs {:.2f} (cold)\n",
+            anchorCount, eigenNs, analyticNs, eigenNs / analyticNs,
+            static_cast<double>(warmEvaluations) / fixes,
+            static_cast<double>(coldEvaluations) / static_cast<double>(inputSetCount));
+    }
+}
+
+void runCrlbGridBenchmark()
+{
+    std::mt19937_64 rng = makeRandomEngine(14);
+    const std::vector<Eigen::Vector3d> anchors = makeBenchmarkAnchors(8, Eigen::Vector3d::Zero(), rng);
+    constexpr double rangeStdDev = 0.1;
+    constexpr double anchorPositionStdDev = 0.05;
+
+    CrlbGridSpec grid;
+    grid.origin = Eigen::Vector3d(-10.0, -10.0, 1.0);
+    grid.spacing = Eigen::Vector3d(0.02, 0.02, 1.0);
+    grid.countX = 1000;
+    grid.countY = 1000;
+
+    std::cout << "\n\nBenchmark -- CRLB map, 8 anchors, isotropic anchor noise\n";
+
+    // Pointwise reference on a subsample of the grid
+    constexpr size_t pointwiseCells = 2000;
+    volatile double sink = 0.0;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < pointwiseCells; ++i) {
+        const Eigen::Vector3d position = grid.cellPosition(i * (grid.cellCount() / pointwiseCells));
+        sink = sink + calculateRangePositionCrlb(anchors, position, rangeStdDev, anchorPositionStdDev).crlb(0, 0);
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    const double pointwiseCellsPerSecond =
+        static_cast<double>(pointwiseCells) / std::chrono::duration<double>(t1 - t0).count();
+
+    const CrlbGridEvaluator evaluator(anchors, rangeStdDev, anchorPositionStdDev);
+    const auto t2 = std::chrono::steady_clock::now();
+    const CrlbGridResult result = evaluator.evaluate(grid);
+    const auto t3 = std::chrono::steady_clock::now();
+    sink = sink + result.positionErrorBound(0);
+    const double gridCellsPerSecond =
+        static_cast<double>(grid.cellCount()) / std::chrono::duration<double>(t3 - t2).count();
+
+    ThreadPool pool;
+    const auto t4 = std::chrono::steady_clock::now();
+    const CrlbGridResult threadedResult = evaluator.evaluate(grid, &pool);
+    const auto t5 = std::chrono::steady_clock::now();
+    sink = sink + threadedResult.positionErrorBound(0);
+    const double threadedCellsPerSecond =
+        static_cast<double>(grid.cellCount()) / std::chrono::duration<double>(t5 - t4).count();
+
+    std::cout << std::format(
+        "  calculateRangePositionCrlb {:>12.0f} cells/s\n"
+        "  CrlbGridEvaluator          {:>12.0f} cells/s ({:.0f}x), {} threads {:.0f} cells/s, {} x {} grid\n",
+        pointwiseCellsPerSecond, gridCellsPerSecond, gridCellsPerSecond / pointwiseCellsPerSecond,
+        pool.threadCount(), threadedCellsPerSecond, grid.countX, grid.countY);
+}
+
+void runAllocationBudgetTests()
+{
+    if (!allocationTrackingEnabled()) {
+        std::cout << "Allocation budget tests skipped (build with -DMULTILAT_ALLOCATION_TRACKING=ON).\n" << std::flush;
+        return;
+    }
+
+    std::mt19937_64 rng = makeRandomEngine(31);
+    const std::vector<Eigen::Vector3d> anchors = makeBenchmarkAnchors(8, Eigen::Vector3d::Zero(), rng);
+    const Eigen::Vector3d truePosition(1.0, -2.0, 3.0);
+    constexpr double rangeStdDev = 0.1;
+    const std::vector<double> ranges = generateNoisyRanges(truePosition, anchors, rangeStdDev, rng);
+
+    // The counter sees allocations on this thread only
+    {
+        const ScopedAllocationCounter counter;
+        std::vector<double> buffer(100);
+        buffer[0] = 1.0;
+        assert(counter.counts().allocations >= 1);
+        assert(counter.counts().bytes >= 100 * sizeof(double));
+    }
+
+    auto countAllocations = [](const auto& body) {
+        body();
+        const ScopedAllocationCounter counter;
+        body();
+        return counter.counts();
+    };
+
+    const AnchorGeometry geometry(anchors);
+    RangeLevenbergMarquardt levenbergMarquardt;
+    RobustRangeLevenbergMarquardt robustLevenbergMarquardt;
+    const std::vector<double> noWeights;
+    volatile double sink = 0.0;
+
+    // Budgets for the allocation-free or near-allocation-free fast paths
+    const AllocationCounts fastOls = countAllocations([&] { sink = sink + ordinaryLeastSquaresWikipediaFast(anchors, ranges).x(); });
+    const AllocationCounts cachedOls = countAllocations([&] { sink = sink + ordinaryLeastSquaresWikipedia2(geometry, ranges).x(); });
+    const AllocationCounts cachedLlsI = countAllocations([&] { sink = sink + linearLeastSquaresI_YueWang(geometry, ranges).x(); });
+    const AllocationCounts cachedLlsII = countAllocations([&] { sink = sink + linearLeastSquaresII_2_YueWang(geometry, ranges).x(); });
+    const AllocationCounts lm = countAllocations([&] {
+        Eigen::Vector3d position = Eigen::Vector3d::Zero();
+        levenbergMarquardt.minimize(anchors, ranges, noWeights, rangeStdDev, position);
+        sink = sink + position.x();
+    });
+    const AllocationCounts robustLm = countAllocations([&] {
+        sink = sink + robustLevenbergMarquardt.minimize(anchors, ranges, rangeStdDev, 5.0, Eigen::Vector3d::Zero()).position.x();
+    });
+    const std::vector<double> rangeStdDevs(anchors.size(), rangeStdDev);
+    const AllocationCounts fixedOls2 = countAllocations([&] { sink = sink + ordinaryLeastSquaresWikipedia2(anchors, ranges).x(); });
+    const AllocationCounts fixedLlsI = countAllocations([&] { sink = sink + linearLeastSquaresI_YueWang(anchors, ranges).x(); });
+    const AllocationCounts fixedLlsII = countAllocations([&] { sink = sink + linearLeastSquaresII_2_YueWang(anchors, ranges).x(); });
+    const AllocationCounts fixedTsWlls = countAllocations([&] {
+        sink = sink + twoStepWeightedLinearLeastSquaresI_YueWang(anchors, ranges, rangeStdDevs).x();
+    });
+    const AllocationCounts fastTsWlls = countAllocations([&] {
+        sink = sink + twoStepWeightedLinearLeastSquaresI_YueWangFast(anchors, ranges, rangeStdDevs).x();
+    });
+    const AnchorPositionsView anchorView(anchors);
+    const RangesView rangeView(ranges);
+    const AllocationCounts viewLm = countAllocations([&] {
+        Eigen::Vector3d position = Eigen::Vector3d::Zero();
+        levenbergMarquardt.minimize(anchorView, rangeView, noWeights, rangeStdDev, position);
+        sink = sink + position.x();
+    });
+    const AllocationCounts isotropicCrlb = countAllocations([&] {
+        sink = sink + calculateRangePositionCrlb(anchors, truePosition, rangeStdDev, 0.05).crlb(0, 0);
+    });
+
+    std::cout << std::format(
+        "Allocations per call with 8 anchors (fixed-size path): OLS2 {}, LLS-I {}, LLS-II-2 {}, TS-WLLS-I {}\n",
+        fixedOls2.allocations, fixedLlsI.allocations, fixedLlsII.allocations, fixedTsWlls.allocations);
+    std::cout << std::format(
+        "Allocations per call: OLS fast {}, TS-WLLS-I fast {}, cached OLS {}, cached LLS-I {}, cached LLS-II-2 {}, "
+        "analytic LM {}, robust analytic LM {}, analytic LM on views {}, isotropic CRLB {}\n",
+        fastOls.allocations, fastTsWlls.allocations, cachedOls.allocations, cachedLlsI.allocations, cachedLlsII.allocations,
+        lm.allocations, robustLm.allocations, viewLm.allocations, isotropicCrlb.allocations);
+
+    // After warm-up these paths keep all per-fix state in fixed-size or reused storage
+    assert(fastOls.allocations == 0);
+    assert(cachedOls.allocations == 0);
+    assert(cachedLlsI.allocations == 0);
+    assert(cachedLlsII.allocations == 0);
+    assert(lm.allocations == 0);
+    assert(robustLm.allocations == 0);
+    assert(viewLm.allocations == 0);
+    assert(fixedOls2.allocations == 0);
+    assert(fixedLlsI.allocations == 0);
+    assert(fixedLlsII.allocations == 0);
+    assert(fixedTsWlls.allocations == 0);
+    assert(fastTsWlls.allocations == 0);
+    assert(isotropicCrlb.allocations == 0);
+
+    for (size_t id = 0; id < algorithmCount; ++id) {
+        const AlgorithmAllocationProfile profile =
+            profileAlgorithmAllocations(static_cast<AlgorithmId>(id), anchors, ranges, rangeStdDev);
+        std::cout << std::format("  {:<74} {:>6.1f} allocations {:>8.0f} bytes per call\n",
+            algorithmDisplayName(profile.algorithm), profile.allocationsPerCall, profile.bytesPerCall);
+    }
+
+    std::cout << "Allocation budget tests passed.\n" << std::flush;
+}
+
+void runNoisyRangeBlockBenchmark()
+{
+    constexpr size_t runCount = 200000;
+
+    TestParameters params;
+    params.truePosition = Eigen::Vector3d(0.5, -0.25, 1.0);
+    std::mt19937_64 rng = makeRandomEngine(19);
+    params.anchorPositions = makeBenchmarkAnchors(8, Eigen::Vector3d::Zero(), rng);
+    params.rangeNoiseStdDev = 0.1;
+    params.rangeOutlierRatio = 0.1;
+    params.rangeOutlierMagnitude = 5.0;
+
+    auto timeMs = [](const auto& generate) {
+        const auto t0 = std::chrono::steady_clock::now();
+        const double checksum = generate();
+        const auto t1 = std::chrono::steady_clock::now();
+        // Keep the results observable so the loop cannot be optimised away.
+        volatile double sink = checksum;
+        (void)sink;
+        return std::chrono::duration<double, std::milli>(t1 - t0).count();
+    };
+
+    const double perRunMs = timeMs([&] {
+        std::mt19937_64 engine = makeRandomEngine(19);
+        double checksum = 0.0;
+        for (size_t run = 0; run < runCount; ++run) {
+            checksum += generateNoisyRanges(params, engine).front();
+        }
+        return checksum;
+    });
+    const double blockMs = timeMs([&] { return generateNoisyRangeBlock(params, 19, 0, runCount).sum(); });
+    ThreadPool pool;
+    const double pooledMs = timeMs([&] { return generateNoisyRangeBlock(params, 19, 0, runCount, &pool).sum(); });
+
+    std::cout << std::format(
+        "\n\nBenchmark -- Noisy range generation, {} runs x 8 anchors, 10% outliers\n"
+        "  generateNoisyRanges {:.1f} ms, range block {:.1f} ms ({:.2f}x), range block ({} threads) {:.1f} ms ({:.2f}x)\n",
+        runCount, perRunMs, blockMs, perRunMs / blockMs, pool.threadCount(), pooledMs, perRunMs / pooledMs);
+}
+
+void runSolveDiagnosticsReport()
+{
+    TestParameters params;
+    params.truePosition = Eigen::Vector3d(0.5, -0.25, 1.0);
+    std::mt19937_64 rng = makeRandomEngine(17);
+    params.anchorPositions = makeBenchmarkAnchors(8, Eigen::Vector3d::Zero(), rng);
+    params.rangeNoiseStdDev = 0.1;
+    params.rangeOutlierRatio = 0.1;
+    params.rangeOutlierMagnitude = 5.0;
+    params.randomSeed = 17;
+    params.numRuns = 2000;
+    params.collectSolveDiagnostics = true;
+
+    std::cout << std::format(
+        "\n\nSolver diagnostics -- per-run means over {} runs, 8 anchors, 10% outliers\n"
+        "  {:<74} {:>10} {:>6} {:>7} {:>8} {:>10} {:>10} {:>10}\n",
+        params.numRuns, "Algorithm", "cost", "iter", "passes", "evals", "setup ns", "factor ns", "refine ns");
+    for (size_t index = 0; index < algorithmCount; ++index) {
+        params.algorithm = static_cast<AlgorithmId>(index);
+        SimulationRunner runner;
+        runner.begin(params);
+        runner.step(params.numRuns);
+        assert(runner.status() == SimulationRunner::Status::Completed);
+
+        const SolveDiagnosticsSummary summary = runner.solveDiagnostics().summary();
+        std::cout << std::format(
+            "  {:<74} {:>10.4f} {:>6.2f} {:>7.2f} {:>8.1f} {:>10.0f} {:>10.0f} {:>10.0f}\n",
+            algorithmDisplayName(params.algorithm), summary.meanFinalCost, summary.meanIterations,
+            summary.meanOuterIterations, summary.meanFunctionEvaluations,
+            summary.meanSetupNs, summary.meanFactorizationNs, summary.meanRefinementNs);
+    }
+}
+
+void runParallelSimulationBenchmark()
+{
+    TestParameters params;
+    params.truePosition = Eigen::Vector3d(0.5, -0.25, 1.0);
+    std::mt19937_64 rng = makeRandomEngine(13);
+    params.anchorPositions = makeBenchmarkAnchors(16, Eigen::Vector3d::Zero(), rng);
+    params.rangeNoiseStdDev = 0.1;
+    params.randomSeed = 13;
+    params.numRuns = 20000;
+    params.algorithm = AlgorithmId::NonLinearLeastSquaresAnalyticLm;
+
+    auto timeRunner = [&params](const ExecutionMode mode) {
+        TestParameters modeParams = params;
+        modeParams.executionMode = mode;
+        SimulationRunner runner;
+        runner.begin(modeParams);
+        runner.step(modeParams.numRuns);
+        assert(runner.status() == SimulationRunner::Status::Completed);
+        return runner.elapsedMs();
+    };
+
+    const double serialMs = timeRunner(ExecutionMode::Serial);
+    const double parallelMs = timeRunner(ExecutionMode::Parallel);
+    std::cout << std::format(
+        "\n\nBenchmark -- SimulationRunner, {} runs of 16-anchor analytic LM\n"
+        "  Serial {:.1f} ms, Parallel ({} threads) {:.1f} ms, speedup {:.2f}x\n",
+        params.numRuns, serialMs, std::max(1U, std::thread::hardware_concurrency()), parallelMs, serialMs / parallelMs);
+}
+
+void runTrackerServiceBenchmark()
+{
+    constexpr size_t tagCount = 10000;
+    constexpr size_t anchorCount = 8;
+    constexpr size_t epochCount = 4;
+    constexpr double epochInterval = 0.1;
+
+    std::mt19937_64 rng = makeRandomEngine(21);
+    const std::vector<Eigen::Vector3d> anchors = makeBenchmarkAnchors(anchorCount, Eigen::Vector3d::Zero(), rng);
+    std::uniform_real_distribution<double> coordinate(-5.0, 5.0);
+    std::vector<Eigen::Vector3d> tagPositions(tagCount);
+    for (Eigen::Vector3d& tagPosition : tagPositions) {
+        tagPosition = Eigen::Vector3d(coordinate(rng), coordinate(rng), coordinate(rng));
+    }
+    std::vector<std::vector<RangeMeasurement>> epochs;
+    for (size_t epoch = 0; epoch < epochCount; ++epoch) {
+        epochs.push_back(generateTrackerRangeEpoch(
+            tagPositions, anchors, 0.1, static_cast<double>(epoch) * epochInterval, 0.02, rng));
+    }
+
+    std::cout << std::format(
+        "\n\nBenchmark -- TrackerService, {} tags x {} anchors, {} out-of-order epochs, analytic LM\n",
+        tagCount, anchorCount, epochCount);
+
+    const size_t hardwareThreads = std::max(1U, std::thread::hardware_concurrency());
+    std::vector<size_t> threadCounts;
+    for (size_t threads = 1; threads < hardwareThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(hardwareThreads);
+
+    double singleThreadRate = 0.0;
+    for (const size_t threads : threadCounts) {
+        TrackerServiceOptions options;
+        options.anchorPositions = anchors;
+        options.threadCount = threads;
+        options.queueCapacity = tagCount * anchorCount;
+        TrackerService service(options);
+
+        // End to end: ingest each epoch as it arrives, then drain and solve it
+        size_t fixes = 0;
+        const auto t0 = std::chrono::steady_clock::now();
+        for (const std::vector<RangeMeasurement>& epoch : epochs) {
+            for (const RangeMeasurement& measurement : epoch) {
+                service.ingest(measurement);
+            }
+            fixes += service.process();
+        }
+        const auto t1 = std::chrono::steady_clock::now();
+        assert(fixes == tagCount * epochCount);
+
+        const double rate = static_cast<double>(fixes) / std::chrono::duration<double>(t1 - t0).count();
+        if (threads == 1) {
+            singleThreadRate = rate;
+        }
+        std::cout << std::format("  {:>3} threads: {:>10.0f} fixes/s, {:>8.1f} ns/fix, speedup {:.2f}x\n",
+            threads, rate, 1e9 / rate, rate / singleThreadRate);
+    }
+}
+
+void runResultSinkBenchmark()
+{
+    constexpr size_t recordCount = 200000;
+
+    // Estimates of a 0.1 m noise scenario with analytic-LM-like diagnostics
+    std::mt19937_64 rng = makeRandomEngine(23);
+    std::normal_distribution<double> noise(0.0, 0.1);
+    const Eigen::Vector3d truePosition(0.5, -0.25, 4.0);
+    std::vector<RunRecord> records(recordCount);
+    for (size_t run = 0; run < recordCount; ++run) {
+        RunRecord& record = records[run];
+        record.algorithm = AlgorithmId::NonLinearLeastSquaresAnalyticLm;
+        record.runIndex = run;
+        record.error = Eigen::Vector3d(noise(rng), noise(rng), noise(rng));
+        record.result.position = truePosition + record.error;
+        record.result.finalCost = 0.5 * record.error.squaredNorm();
+        record.result.iterations = 4 + run % 3;
+        record.result.functionEvaluations = record.result.iterations + 1;
+        record.result.timings.setupNs = 150 + static_cast<int64_t>(run % 40);
+        record.result.timings.refinementNs = 900 + static_cast<int64_t>(run % 200);
+        record.hasDiagnostics = true;
+    }
+
+    // Discards the bytes, so only formatting and buffering are timed
+    struct NullBuffer : std::streambuf {
+        std::streamsize xsputn(const char*, const std::streamsize count) override { return count; }
+        int overflow(const int character) override { return character; }
+    } nullBuffer;
+    std::ostream nullStream(&nullBuffer);
+
+    std::cout << std::format("\n\nBenchmark -- Streaming {} per-run records with diagnostics\n", recordCount);
+
+    const auto f0 = std::chrono::steady_clock::now();
+    for (const RunRecord& record : records) {
+        nullStream << std::format("{},{},{},{},{},{},{},{},{},{},{},{}\n",
+            record.scenarioIndex, static_cast<int>(record.algorithm), record.runIndex,
+            record.result.position.x(), record.result.position.y(), record.result.position.z(),
+            record.error.x(), record.error.y(), record.error.z(),
+            record.result.finalCost, record.result.iterations, record.result.timings.refinementNs);
+    }
+    const auto f1 = std::chrono::steady_clock::now();
+    std::cout << std::format("  {:<34} {:>7.1f} ns/record\n", "std::format line per record (CSV)",
+        std::chrono::duration<double, std::nano>(f1 - f0).count() / recordCount);
+
+    for (const auto& [format, name] : {std::pair{ResultFormat::Csv, "ResultSink CSV"},
+                                       std::pair{ResultFormat::JsonLines, "ResultSink JSON Lines"},
+                                       std::pair{ResultFormat::Binary, "ResultSink binary"}}) {
+        const std::unique_ptr<ResultSink> sink = makeResultSink(format, nullStream);
+        const auto t0 = std::chrono::steady_clock::now();
+        for (const RunRecord& record : records) {
+            sink->write(record);
+        }
+        sink->flush();
+        const auto t1 = std::chrono::steady_clock::now();
+        std::cout << std::format("  {:<34} {:>7.1f} ns/record, {:>6.1f} bytes/record\n", name,
+            std::chrono::duration<double, std::nano>(t1 - t0).count() / recordCount,
+            static_cast<double>(sink->bytesWritten()) / recordCount);
+    }
+}
+
+
+void runParameterSweepBenchmark()
+{
+    SweepConfig config;
+    config.rangeNoiseStdDevs = {0.05, 0.1, 0.3};
+    config.rangeOutlierRatios = {0.0, 0.1};
+    config.anchorCounts = {6, 12};
+    config.anchorLayouts = {AnchorLayout::Ring, AnchorLayout::Random};
+    config.numRuns = 200;
+    const std::vector<SweepScenario> scenarios = expandSweepGrid(config);
+    const size_t solves = scenarios.size() * algorithmCount * config.numRuns;
+
+    std::cout << std::format("\n\nBenchmark -- Parameter sweep, {} scenarios x {} algorithms x {} runs\n",
+        scenarios.size(), algorithmCount, config.numRuns);
+
+    double singleThreadSeconds = 0.0;
+    for (const size_t threads : {size_t{1}, size_t{0}}) {
+        SweepOptions options;
+        options.threadCount = threads;
+        const auto t0 = std::chrono::steady_clock::now();
+        const std::vector<SweepResult> results = runSweep(config, scenarios, options);
+        const auto t1 = std::chrono::steady_clock::now();
+        assert(results.size() == scenarios.size() * algorithmCount);
+        const double seconds = std::chrono::duration<double>(t1 - t0).count();
+        if (threads == 1) {
+            singleThreadSeconds = seconds;
+        }
+        std::cout << std::format("  {:>3} threads: {:.3f} s, {:>9.0f} solves/s, speedup {:.2f}x\n",
+            threads == 0 ? std::thread::hardware_concurrency() : threads, seconds, static_cast<double>(solves) / seconds,
+            singleThreadSeconds / seconds);
+    }
+}
+
+
+void runCommonRandomNumbersBenchmark()
+{
+    TestParameters params;
+    params.truePosition = Eigen::Vector3d(0.5, -0.25, 4.0);
+    std::mt19937_64 rng = makeRandomEngine(25);
+    params.anchorPositions = makeBenchmarkAnchors(8, Eigen::Vector3d::Zero(), rng);
+    params.rangeNoiseStdDev = 0.1;
+    params.rangeOutlierRatio = 0.1;
+    params.rangeOutlierMagnitude = 5.0;
+    params.anchorPosNoiseStdDev = 0.05;
+    params.randomSeed = 25;
+    params.numRuns = 5000;
+    // Differences are taken from the analytic LM, the maximum-likelihood estimator here
+    std::vector<AlgorithmId> algorithms = {AlgorithmId::NonLinearLeastSquaresAnalyticLm};
+    for (size_t id = 0; id < algorithmCount; ++id) {
+        if (static_cast<AlgorithmId>(id) != AlgorithmId::NonLinearLeastSquaresAnalyticLm) {
+            algorithms.push_back(static_cast<AlgorithmId>(id));
+        }
+    }
+
+    std::cout << std::format("\n\nBenchmark -- {} algorithms x {} runs, 8 anchors, anchor noise and 10% outliers\n",
+        algorithms.size(), params.numRuns);
+
+    // What runTest does: reseed and regenerate every draw once per algorithm
+    double checksum = 0.0;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (const AlgorithmId algorithm : algorithms) {
+        std::mt19937_64 engine = makeRandomEngine(params.randomSeed);
+        ErrorStatisticsAccumulator statistics(params.truePosition);
+        for (size_t run = 0; run < params.numRuns; ++run) {
+            const std::vector<Eigen::Vector3d> anchors = generateNoisyAnchorPositions(params, engine);
+            const std::vector<double> ranges = generateNoisyRanges(params, engine);
+            statistics.add(runAlgorithm(algorithm, anchors, ranges, params.rangeNoiseStdDev));
+        }
+        checksum += statistics.results().meanSignedError.sum();
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+
+    // Generation alone, for the share it takes of the per-algorithm passes
+    std::mt19937_64 engine = makeRandomEngine(params.randomSeed);
+    for (size_t run = 0; run < params.numRuns; ++run) {
+        checksum += generateNoisyAnchorPositions(params, engine).front().x() + generateNoisyRanges(params, engine).front();
+    }
+    const auto t2 = std::chrono::steady_clock::now();
+
+    const std::vector<CommonRandomNumbersResult> results = runCommonRandomNumbers(params, algorithms);
+    const auto t3 = std::chrono::steady_clock::now();
+    volatile double observed = checksum + results.back().results.meanSignedError.sum();
+    (void)observed;
+
+    const double independentMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    const double generationMs = std::chrono::duration<double, std::milli>(t2 - t1).count();
+    const double pairedMs = std::chrono::duration<double, std::milli>(t3 - t2).count();
+    std::cout << std::format(
+        "  per-algorithm passes {:.1f} ms ({:.1f} ms generating), common random numbers {:.1f} ms ({:.2f}x)\n",
+        independentMs, generationMs * static_cast<double>(algorithms.size()), pairedMs, independentMs / pairedMs);
+
+    std::cout << std::format("  Std error of the error-norm difference from {}, paired / independent:\n",
+        algorithmDisplayName(results.front().algorithm));
+    for (size_t a = 1; a < results.size(); ++a) {
+        std::cout << std::format("  {:<74} {:.5f} / {:.5f} m\n", algorithmDisplayName(results[a].algorithm),
+            results[a].pairedStdError, results[a].unpairedStdError);
+    }
+}
+
+} // namespace
+
+
+void runTests(const TestParameters& params)
+{
+    std::cout << "Running Tests...\n";
+    runCrlbValidationTests();
+    runCrlbIndependentAnchorValidationTests();
+    runCrlbGridValidationTests();
+    runSimulationAnchorNoiseRegressionTest();
+    runParallelSimulationDeterminismTest();
+    runWorkStealingPoolValidationTests();
+    runComputeResultsValidationTests();
+    runErrorStatisticsAccumulatorValidationTests();
+    runNoisyRangeBlockValidationTests();
+    runOrdinaryLeastSquaresFastPathValidationTests();
+    runTwoStepWeightedFastPathValidationTests();
+    runBatchMultilaterationValidationTests();
+    runAnchorGeometryValidationTests();
+    runIncrementalLinearLeastSquaresValidationTests();
+    runRangeTrackerValidationTests();
+    runTrackerServiceValidationTests();
+    runRangeLogValidationTests();
+    runResultSinkValidationTests();
+    runParameterSweepValidationTests();
+    runCommonRandomNumbersValidationTests();
+    runAnalyticLevenbergMarquardtValidationTests();
+    runRobustAnalyticLevenbergMarquardtValidationTests();
+    runMeasurementViewValidationTests();
+    runFixedSizeAnchorCountValidationTests();
+    runMixedPrecisionValidationTests();
+    runSolveDiagnosticsValidationTests();
+    runAllocationBudgetTests();
+
+    TestParameters testParams = params;
+    printTestParams(testParams);
+
+    // Each test set solves every run's draws with all algorithms, so the comparisons are paired
+    std::vector<AlgorithmId> algorithms;
+    for (size_t id = 0; id < algorithmCount; ++id)
+    {
+        algorithms.push_back(static_cast<AlgorithmId>(id));
+    }
+
+    // No ouliers
+    std::cout << std::format("\nTest Set 1 -- Std Dev: {:.2f}m, No Outliers\n", testParams.rangeNoiseStdDev);
+    runPairedTests(testParams, algorithms);
+
+    // Test Set 2: No ranging outliers, but anchor position noise
+    testParams.rangeOutlierRatio = 0.0;
+    testParams.anchorPosNoiseStdDev = 0.25;
+    std::cout << std::format("\n\nTest Set 2 -- Range Std Dev: {:.2f}m, Anchor Position Std Dev: {:.2f}m, No Outliers\n", 
+        testParams.rangeNoiseStdDev, 
+        testParams.anchorPosNoiseStdDev
+    );
+    runPairedTests(testParams, algorithms);
+
+    // Test Set 3: With ranging outliers
+    testParams.rangeOutlierRatio = 0.1;
+    testParams.anchorPosNoiseStdDev = 0.0;
+    std::cout << std::format("\n\nTest Set 3 -- Std Dev: {:.2f}m, Outliers: {:.1f}%\n", 
+        testParams.rangeNoiseStdDev, 
+        testParams.rangeOutlierRatio * 100.0
+    );
+    runPairedTests(testParams, algorithms);
+
+    runOrdinaryLeastSquaresFastPathBenchmark();
+    runLinearLeastSquaresIICacheBenchmark();
+    runTwoStepWeightedFastPathBenchmark();
+    runIncrementalLinearLeastSquaresBenchmark();
+    runLevenbergMarquardtBenchmark();
+    runRobustLevenbergMarquardtBenchmark();
+    runRangeTrackerBenchmark();
+    runCrlbGridBenchmark();
+    runNoisyRangeBlockBenchmark();
+    runSolveDiagnosticsReport();
+    runParallelSimulationBenchmark();
+    runTrackerServiceBenchmark();
+    runResultSinkBenchmark();
+    runParameterSweepBenchmark();
+    runCommonRandomNumbersBenchmark();
+
+    std::cout << "\nAll tests completed.\n";
+}
+
+void runTest(
+    const TestParameters& params, 
+    MultilaterationMethod multilaterationMethod,
+    ResultSink* resultSink
+)
+{
+    std::mt19937_64 rng = makeRandomEngine(params.randomSeed);
+
+    ErrorStatisticsAccumulator statistics(params.truePosition);
+    RunRecord record;
+    record.algorithm = params.algorithm;
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < params.numRuns; i++)
+    {
+        // Ranges use the physical anchors; only the coordinates supplied to the
+        // estimator receive independent survey/coordinate noise.
+        std::vector<Eigen::Vector3d> anchorPositions = params.anchorPositions;
+        if (params.anchorPosNoiseStdDev > 0.0)
+        {
+            anchorPositions = generateNoisyAnchorPositions(params.anchorPositions, params.anchorPosNoiseStdDev, rng);
+        }
+
+        std::vector<double> noisyRanges = generateNoisyRanges(params, rng);
+
+        const Eigen::Vector3d estimatedPosition = multilaterationMethod(anchorPositions, noisyRanges);
+        statistics.add(estimatedPosition);
+        if (resultSink != nullptr)
+        {
+            record.runIndex = i;
+            record.result.position = estimatedPosition;
+            record.error = estimatedPosition - params.truePosition;
+            resultSink->write(record);
+        }
+    }
+    auto t1 = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed = t1 - t0;
+
+    if (resultSink != nullptr)
+    {
+        resultSink->flush();
+    }
+    printResults(statistics.results());
+
+    std::cout << std::format("  Total Time for {} runs: {:.3f} ms\n", params.numRuns, elapsed.count());
+    std::cout << std::format("  Average Time per run: {:.4f} ms\n", (elapsed.count() * 1000.0) / static_cast<double>(params.numRuns));
+}
+
+void runTest(
+    const TestParameters& params,
+    MultilaterationFunction multilaterationFunction,
+    ResultSink* resultSink
+)
+{
+    runTest(params, MultilaterationMethod(multilaterationFunction), resultSink);
+}
+
+void runPairedTests(
+    const TestParameters& params,
+    const std::vector<AlgorithmId>& algorithms,
+    ResultSink* resultSink
+)
+{
+    auto t0 = std::chrono::high_resolution_clock::now();
+    const std::vector<CommonRandomNumbersResult> results = runCommonRandomNumbers(params, algorithms, resultSink);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed = t1 - t0;
+
+    if (resultSink != nullptr)
+    {
+        resultSink->flush();
+    }
+
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        std::cout << std::format("\nTest {} ({}):\n", i + 1, algorithmDisplayName(results[i].algorithm));
+        printResults(results[i].results);
+        std::cout << std::format("  Average Solve Time: {:.4f} ms\n", results[i].meanSolveNs * 1e-6);
+    }
+
+    if (results.size() > 1)
+    {
+        std::cout << std::format("\nError-norm difference from {} on the same draws (mean, paired / independent std error):\n",
+            algorithmDisplayName(results.front().algorithm));
+        for (size_t i = 1; i < results.size(); i++)
+        {
+            std::cout << std::format("  {:<74} {:+.4f} m, {:.4f} / {:.4f} m over {} runs\n",
+                algorithmDisplayName(results[i].algorithm), results[i].meanErrorNormDifference,
+                results[i].pairedStdError, results[i].unpairedStdError, results[i].pairedRuns);
+        }
+    }
+
+    std::cout << std::format("\n  Total Time for {} runs x {} algorithms: {:.3f} s\n", params.numRuns, algorithms.size(), elapsed.count());
 }
 
 } // namespace TrueRangeMultilateration
@@ -5,6 +5,7 @@
 
 #include <Eigen/Dense>
 
+#include "core/result_sink.h"
 #include "core/simulation_types.h"
 
 namespace TrueRangeMultilateration {
@@ -12,9 +13,22 @@ namespace TrueRangeMultilateration {
 typedef std::function<Eigen::Vector3d(const std::vector<Eigen::Vector3d>&, const std::vector<double>&)>
     MultilaterationMethod;
 
+// Plain estimator signature; lets overloaded estimator names be passed to runTest directly.
+typedef Eigen::Vector3d (*MultilaterationFunction)(const std::vector<Eigen::Vector3d>&, const std::vector<double>&);
+
 void runTests(const TestParameters& params);
 
-void runTest(const TestParameters& params, MultilaterationMethod multilaterationMethod);
+// Runs params.numRuns estimates and prints their statistics, accumulated online so memory
+// does not grow with numRuns. resultSink, if given, receives every run as a RunRecord
+// tagged with params.algorithm.
+void runTest(const TestParameters& params, MultilaterationMethod multilaterationMethod, ResultSink* resultSink = nullptr);
+
+void runTest(const TestParameters& params, MultilaterationFunction multilaterationFunction, ResultSink* resultSink = nullptr);
+
+// Common-random-numbers counterpart of runTest: generates each run's noise once, solves it
+// with every algorithm through runAlgorithm, and prints each algorithm's statistics followed
+// by its paired error-norm difference from algorithms.front().
+void runPairedTests(const TestParameters& params, const std::vector<AlgorithmId>& algorithms, ResultSink* resultSink = nullptr);
 
 }  // namespace TrueRangeMultilateration
 
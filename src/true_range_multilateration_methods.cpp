@@ -1,4 +1,5 @@
 #include "true_range_multilateration_methods.h"
+#include "core/stage_timer.h"
 
 #include <algorithm>
 #include <cmath>
@@ -6,6 +7,8 @@
 #include <functional>
 #include <iostream>
 #include <limits>
+#include <type_traits>
+#include <utility>
 
 #include <unsupported/Eigen/NonLinearOptimization>
 
@@ -22,12 +25,11 @@ namespace // anonymous namespace for helper functions
         return (T(0) < val) - (val < T(0));
     }
 
-    template<typename VecType, typename RetType = VecType>
-    RetType sumOver(
-        const std::vector<VecType>& vec, 
-        const std::function<RetType(const VecType&)>& fn = [](const VecType& x){ return x; }
-    )
+    // Works for std::vector and the strided measurement spans alike, which only provide size() and operator[]
+    template<typename Container, typename Fn = std::identity>
+    auto sumOver(const Container& vec, const Fn& fn = {})
     {
+        using RetType = std::decay_t<decltype(fn(vec[0]))>;
         if(vec.empty())
         {
             return RetType();
@@ -40,6 +42,33 @@ namespace // anonymous namespace for helper functions
         return sum;
     }
 
+    // Anchor counts whose linear solvers are instantiated with compile-time sized matrices. fn receives
+    // std::integral_constant<int, N> for these and std::integral_constant<int, Eigen::Dynamic> otherwise.
+    template<typename Fn>
+    auto dispatchAnchorCount(size_t anchorCount, const Fn& fn)
+    {
+        switch(anchorCount)
+        {
+            case 4: return fn(std::integral_constant<int, 4>{});
+            case 6: return fn(std::integral_constant<int, 6>{});
+            case 8: return fn(std::integral_constant<int, 8>{});
+            default: return fn(std::integral_constant<int, Eigen::Dynamic>{});
+        }
+    }
+
+    // Rows x Cols design matrix; the dynamic case stays MatrixXd so BDCSVD can compute thin factors
+    template<int Rows, int Cols>
+    using DesignMatrix = std::conditional_t<Rows == Eigen::Dynamic, Eigen::MatrixXd, Eigen::Matrix<double, Rows, Cols>>;
+
+    // BDCSVD delegates matrices with fewer than 16 columns to JacobiSVD anyway, so fixed-size systems use
+    // JacobiSVD directly, whose full factors stay on the stack
+    template<typename MatrixType>
+    using LeastSquaresSvd = std::conditional_t<
+        MatrixType::RowsAtCompileTime == Eigen::Dynamic,
+        Eigen::BDCSVD<MatrixType, Eigen::ComputeThinU | Eigen::ComputeThinV>,
+        Eigen::JacobiSVD<MatrixType, Eigen::ComputeFullU | Eigen::ComputeFullV>
+    >;
+
     size_t computeRank(const std::vector<Eigen::Vector3d>& points, double tol = 1e-8)
     {
         const size_t N = points.size();
@@ -111,21 +140,256 @@ namespace // anonymous namespace for helper functions
         // void operator() (const InputType& x, ValueType* v, JacobianType* _j=0) const;
     };
 
+    // Statuses of Eigen's LevenbergMarquardt that mean a tolerance was met rather than a limit hit
+    bool isEigenLmConverged(Eigen::LevenbergMarquardtSpace::Status status)
+    {
+        switch(status)
+        {
+            case Eigen::LevenbergMarquardtSpace::RelativeReductionTooSmall:
+            case Eigen::LevenbergMarquardtSpace::RelativeErrorTooSmall:
+            case Eigen::LevenbergMarquardtSpace::RelativeErrorAndReductionTooSmall:
+            case Eigen::LevenbergMarquardtSpace::CosinusTooSmall:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    using TrueRangeMultilateration::CrlbResult;
+
+    // Minimum anchor-to-evaluation distance of the CRLB; closer anchors have no defined line of sight
+    constexpr double crlbMinRange = 1e-12;
+
+    void appendCrlbWarning(CrlbResult& result, const std::string& warning)
+    {
+        if (!result.warning.empty()) {
+            result.warning += " ";
+        }
+        result.warning += warning;
+    }
+
+    // Input checks shared by the calculateRangePositionCrlb overloads. On failure the reason is appended to
+    // result.warning and false is returned.
+    bool checkCrlbInputs(
+        const std::vector<Eigen::Vector3d>& anchorPositions,
+        const Eigen::Vector3d& evaluationPosition,
+        double rangeStdDev,
+        CrlbResult& result
+    )
+    {
+        if (rangeStdDev <= 0.0 || !std::isfinite(rangeStdDev)) {
+            result.valid = false;
+            result.usedPseudoInverse = true;
+            appendCrlbWarning(result, "Range standard deviation must be positive and finite.");
+            return false;
+        }
+
+        if (!evaluationPosition.allFinite()) {
+            result.usedPseudoInverse = true;
+            appendCrlbWarning(result, "CRLB evaluation position must contain only finite coordinates.");
+            return false;
+        }
+
+        for (const Eigen::Vector3d& anchorPosition : anchorPositions) {
+            if (!anchorPosition.allFinite()) {
+                result.usedPseudoInverse = true;
+                appendCrlbWarning(result, "Anchor positions must contain only finite coordinates.");
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Reports the under-determined anchor count and computes sigma_r^2; false if it overflows
+    bool checkCrlbRangeVariance(size_t anchorCount, double rangeStdDev, CrlbResult& result, double& rangeVariance)
+    {
+        if (anchorCount < 4) {
+            result.usedPseudoInverse = true;
+            appendCrlbWarning(result, "Fewer than 4 anchors cannot fully constrain a 3D true-range position; displaying pseudo-inverse CRLB.");
+        }
+
+        rangeVariance = rangeStdDev * rangeStdDev;
+        if (!std::isfinite(rangeVariance)) {
+            result.usedPseudoInverse = true;
+            appendCrlbWarning(result, "Range variance overflowed; use a smaller standard deviation.");
+            return false;
+        }
+        return true;
+    }
+
+    // Unit line-of-sight vector from an anchor to the evaluation position. Returns false if the geometry
+    // overflowed (result is then final); sets usable = false for anchors that coincide with the position.
+    bool crlbLineOfSight(
+        const Eigen::Vector3d& anchorPosition,
+        const Eigen::Vector3d& evaluationPosition,
+        CrlbResult& result,
+        Eigen::Vector3d& u,
+        bool& usable
+    )
+    {
+        const Eigen::Vector3d delta = evaluationPosition - anchorPosition;
+        const double rho = delta.norm();
+        if (!delta.allFinite() || !std::isfinite(rho)) {
+            result.usedPseudoInverse = true;
+            appendCrlbWarning(result, "Anchor-to-evaluation geometry overflowed during CRLB calculation.");
+            return false;
+        }
+
+        usable = rho > crlbMinRange;
+        if (!usable) {
+            result.usedPseudoInverse = true;
+            appendCrlbWarning(result, "An anchor is too close to the CRLB evaluation position and was skipped.");
+            return true;
+        }
+        u = delta / rho;
+        return true;
+    }
+
+    // Symmetrizes result.fisherInformation and fills the (pseudo-inverse) CRLB, rank and validity
+    void invertCrlbFisherInformation(CrlbResult& result)
+    {
+        result.fisherInformation = 0.5 * (
+            result.fisherInformation + result.fisherInformation.transpose()
+        );
+        if (!result.fisherInformation.allFinite()) {
+            result.usedPseudoInverse = true;
+            appendCrlbWarning(result, "Fisher information matrix contains nonfinite values.");
+            return;
+        }
+
+        Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> eigensolver(result.fisherInformation);
+        if (eigensolver.info() != Eigen::Success) {
+            result.valid = false;
+            result.usedPseudoInverse = true;
+            appendCrlbWarning(result, "Failed to decompose the Fisher information matrix.");
+            return;
+        }
+
+        const Eigen::Vector3d eigenvalues = eigensolver.eigenvalues();
+        const Eigen::Matrix3d eigenvectors = eigensolver.eigenvectors();
+        const double maxAbsEigenvalue = eigenvalues.cwiseAbs().maxCoeff();
+        const double tolerance = 1e-12 * std::max(1.0, maxAbsEigenvalue);
+
+        Eigen::Vector3d inverseEigenvalues = Eigen::Vector3d::Zero();
+        result.rank = 0;
+        for (Eigen::Index i = 0; i < eigenvalues.size(); ++i) {
+            if (eigenvalues(i) > tolerance) {
+                inverseEigenvalues(i) = 1.0 / eigenvalues(i);
+                ++result.rank;
+            }
+        }
+
+        result.crlb = eigenvectors * inverseEigenvalues.asDiagonal() * eigenvectors.transpose();
+        result.crlb = 0.5 * (result.crlb + result.crlb.transpose());
+        result.valid = true;
+
+        if (result.rank < 3) {
+            result.usedPseudoInverse = true;
+            appendCrlbWarning(result, "Fisher information matrix is rank deficient; displaying pseudo-inverse CRLB. The true covariance bound is unbounded in one or more directions.");
+        }
+    }
+
+    // O(N) CRLB for mutually independent anchors, where S = sigma_r^2 I + B C_a B^T is diagonal with entries
+    // sigma_r^2 + u_i^T C_ii u_i. projectedAnchorVariance(i, u) returns u^T C_ii u for anchor i.
+    template<typename ProjectedAnchorVariance>
+    CrlbResult independentAnchorCrlb(
+        const std::vector<Eigen::Vector3d>& anchorPositions,
+        const Eigen::Vector3d& evaluationPosition,
+        double rangeVariance,
+        const ProjectedAnchorVariance& projectedAnchorVariance,
+        CrlbResult result
+    )
+    {
+        result.fisherInformation.setZero();
+        size_t usableAnchorCount = 0;
+        for (size_t anchorIndex = 0; anchorIndex < anchorPositions.size(); ++anchorIndex) {
+            Eigen::Vector3d u;
+            bool usable = false;
+            if (!crlbLineOfSight(anchorPositions[anchorIndex], evaluationPosition, result, u, usable)) {
+                return result;
+            }
+            if (!usable) {
+                continue;
+            }
+
+            const double effectiveRangeVariance = rangeVariance + projectedAnchorVariance(anchorIndex, u);
+            if (!std::isfinite(effectiveRangeVariance)) {
+                result.usedPseudoInverse = true;
+                appendCrlbWarning(result, "Effective range covariance contains nonfinite values.");
+                return result;
+            }
+            result.fisherInformation.noalias() += (u / effectiveRangeVariance) * u.transpose();
+            ++usableAnchorCount;
+        }
+
+        if (usableAnchorCount == 0) {
+            result.valid = false;
+            result.usedPseudoInverse = true;
+            appendCrlbWarning(result, "No usable anchors remain after input validation.");
+            return result;
+        }
+
+        invertCrlbFisherInformation(result);
+        return result;
+    }
+
+    // Symmetry/PSD check of one 3x3 anchor covariance block with the absolute tolerance of
+    // validateAnchorPositionCovariance; projects roundoff-sized negative eigenvalues to zero
+    std::string validateAnchorCovarianceBlock(const Eigen::Matrix3d& block, double tolerance, Eigen::Matrix3d& validatedBlock)
+    {
+        if ((block - block.transpose()).cwiseAbs().maxCoeff() > tolerance) {
+            return "Anchor-position covariance is materially nonsymmetric.";
+        }
+
+        validatedBlock = 0.5 * (block + block.transpose());
+        Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> eigensolver(validatedBlock);
+        if (eigensolver.info() != Eigen::Success) {
+            return "Failed to decompose the anchor-position covariance matrix.";
+        }
+
+        const Eigen::Vector3d eigenvalues = eigensolver.eigenvalues();
+        if (eigenvalues.minCoeff() < -tolerance) {
+            return "Anchor-position covariance is not positive semidefinite.";
+        }
+        if (eigenvalues.minCoeff() < 0.0) {
+            validatedBlock = eigensolver.eigenvectors()
+                * eigenvalues.cwiseMax(0.0).asDiagonal()
+                * eigensolver.eigenvectors().transpose();
+            validatedBlock = 0.5 * (validatedBlock + validatedBlock.transpose());
+        }
+        return {};
+    }
+
 } // namespace anonymous
 
 namespace TrueRangeMultilateration
 {
 
-Eigen::Vector3d ordinaryLeastSquaresWikipedia(
-    const std::vector<Eigen::Vector3d>& anchorPositions,
-    const std::vector<double>& ranges
+namespace // anonymous namespace for the estimator bodies, shared by the std::vector and view overloads
+{
+
+template<typename Svd>
+void recordSvdRank(const Svd& svd, SolveResult* diagnostics)
+{
+    if(diagnostics != nullptr)
+    {
+        diagnostics->rank = static_cast<int>(svd.rank());
+    }
+}
+
+template<int Rows, typename Anchors, typename Ranges>
+Eigen::Vector3d ordinaryLeastSquaresWikipediaSized(
+    const Anchors& anchorPositions,
+    const Ranges& ranges,
+    SolveResult* diagnostics
 )
 {
+    StageTimer timer(diagnostics);
     const size_t N = ranges.size();
     const double N_inv = 1.0 / static_cast<double>(N);
 
-    Eigen::MatrixXd A(N, 3);
-    Eigen::VectorXd b(N);
+    DesignMatrix<Rows, 3> A(N, 3);
+    Eigen::Matrix<double, Rows, 1> b(N);
 
     double meanSquaredRange = N_inv * sumOver(ranges, std::function(sq<double>));
 
@@ -143,25 +407,90 @@ Eigen::Vector3d ordinaryLeastSquaresWikipedia(
         b(i) = sq(d_i) - meanSquaredRange - p_i.squaredNorm() + meanSquaredNormAnchorPos;
     }
 
-    Eigen::MatrixXd A_T = A.transpose();
+    const auto A_T = A.transpose().eval();
+    timer.lap(&SolveStageTimings::setupNs);
 
     // Solve using pseudo-inverse
     // See https://libeigen.gitlab.io/eigen/docs-nightly/group__LeastSquares.html for better methods to solve overdetermined Ax = b
-    Eigen::Vector3d posEstimate = (A_T * A).inverse() * A_T * b;
+    const Eigen::Matrix3d ATA_inv = (A_T * A).inverse();
+    timer.lap(&SolveStageTimings::factorizationNs);
+
+    Eigen::Vector3d posEstimate = ATA_inv * A_T * b;
+    timer.lap(&SolveStageTimings::refinementNs);
 
     return posEstimate;
 }
 
-Eigen::Vector3d ordinaryLeastSquaresWikipedia2(
-    const std::vector<Eigen::Vector3d>& anchorPositions,
-    const std::vector<double>& ranges
+template<typename Anchors, typename Ranges>
+Eigen::Vector3d ordinaryLeastSquaresWikipediaImpl(
+    const Anchors& anchorPositions,
+    const Ranges& ranges,
+    SolveResult* diagnostics = nullptr
+)
+{
+    return dispatchAnchorCount(ranges.size(), [&](auto rows) {
+        return ordinaryLeastSquaresWikipediaSized<decltype(rows)::value>(anchorPositions, ranges, diagnostics);
+    });
+}
+
+template<typename Anchors, typename Ranges>
+Eigen::Vector3d ordinaryLeastSquaresWikipediaFastImpl(
+    const Anchors& anchorPositions,
+    const Ranges& ranges
+)
+{
+    const size_t N = ranges.size();
+    if(N == 0)
+    {
+        return Eigen::Vector3d::Constant(std::numeric_limits<double>::quiet_NaN());
+    }
+
+    // The linearised system is translation invariant, so work relative to the first anchor
+    // to keep the single-pass moments well conditioned for anchors far from the origin.
+    const Eigen::Vector3d origin = anchorPositions[0];
+
+    Eigen::Vector3d sumPos = Eigen::Vector3d::Zero();
+    Eigen::Matrix3d sumPosPosT = Eigen::Matrix3d::Zero();
+    Eigen::Vector3d sumPosH = Eigen::Vector3d::Zero();
+    double sumH = 0.0;
+
+    for(size_t i = 0; i < N; ++i)
+    {
+        const Eigen::Vector3d p_i = anchorPositions[i] - origin;
+        const double h_i = sq(ranges[i]) - p_i.squaredNorm();
+
+        sumPos += p_i;
+        sumPosPosT.selfadjointView<Eigen::Lower>().rankUpdate(p_i);
+        sumPosH += h_i * p_i;
+        sumH += h_i;
+    }
+
+    // With A.row(i) = 2 * (centroid - p_i), the constant terms of b cancel because the columns of A sum to zero:
+    //   A^T * A = 4 * (sum(p_i * p_i^T) - N * centroid * centroid^T)
+    //   A^T * b = -2 * (sum(h_i * p_i) - centroid * sum(h_i)),  where h_i = d_i^2 - |p_i|^2
+    const Eigen::Vector3d anchorPosCentroid = sumPos / static_cast<double>(N);
+    Eigen::Matrix3d ATA_4 = sumPosPosT.selfadjointView<Eigen::Lower>();
+    ATA_4.noalias() -= sumPos * anchorPosCentroid.transpose();
+    const Eigen::Vector3d ATb_2 = -(sumPosH - sumH * anchorPosCentroid);
+
+    Eigen::Vector3d posEstimate = origin + 0.5 * ATA_4.ldlt().solve(ATb_2);
+
+    return posEstimate;
+}
+
+template<int Rows, typename Anchors, typename Ranges>
+Eigen::Vector3d ordinaryLeastSquaresWikipedia2Sized(
+    const Anchors& anchorPositions,
+    const Ranges& ranges,
+    SolveResult* diagnostics
 )
 {
+    StageTimer timer(diagnostics);
     const size_t N = ranges.size();
     const double N_inv = 1.0 / static_cast<double>(N);
 
-    Eigen::MatrixXd A(N, 3);
-    Eigen::VectorXd b(N);
+    DesignMatrix<Rows, 3> A(N, 3);
+    Eigen::Matrix<double, Rows, 1> b(N);
 
     double meanSquaredRange = N_inv * sumOver(ranges, std::function(sq<double>));
 
@@ -179,26 +508,46 @@ Eigen::Vector3d ordinaryLeastSquaresWikipedia2(
         b(i) = sq(d_i) - meanSquaredRange - p_i.squaredNorm() + meanSquaredNormAnchorPos;
     }
 
-    // Solve using BDCSVD for better numerical stability, especially when anchors are coplanar
-    Eigen::BDCSVD<Eigen::MatrixXd, Eigen::ComputeThinU | Eigen::ComputeThinV> svd(A);
+    timer.lap(&SolveStageTimings::setupNs);
+
+    // Solve using an SVD (see LeastSquaresSvd) for better numerical stability, especially when anchors are coplanar
+    LeastSquaresSvd<decltype(A)> svd(A);
+    timer.lap(&SolveStageTimings::factorizationNs);
+
     Eigen::Vector3d posEstimate = svd.solve(b);
+    timer.lap(&SolveStageTimings::refinementNs);
+    recordSvdRank(svd, diagnostics);
 
     return posEstimate;
 }
 
-Eigen::Vector3d nonLinearLeastSquaresEigenLevenbergMarquardt(
-    const std::vector<Eigen::Vector3d>& anchorPositions,
-    const std::vector<double>& ranges
+template<typename Anchors, typename Ranges>
+Eigen::Vector3d ordinaryLeastSquaresWikipedia2Impl(
+    const Anchors& anchorPositions,
+    const Ranges& ranges,
+    SolveResult* diagnostics = nullptr
+)
+{
+    return dispatchAnchorCount(ranges.size(), [&](auto rows) {
+        return ordinaryLeastSquaresWikipedia2Sized<decltype(rows)::value>(anchorPositions, ranges, diagnostics);
+    });
+}
+
+template<typename Anchors, typename Ranges>
+Eigen::Vector3d nonLinearLeastSquaresEigenLevenbergMarquardtImpl(
+    const Anchors& anchorPositions,
+    const Ranges& ranges,
+    SolveResult* diagnostics = nullptr
 )
 {
     struct MultilaterationFunctor : EigenLmFunctor<double>
     {
-        const std::vector<Eigen::Vector3d>& mAnchorPositions;
-        const std::vector<double>& mRanges;
+        const Anchors& mAnchorPositions;
+        const Ranges& mRanges;
 
         MultilaterationFunctor(
-            const std::vector<Eigen::Vector3d>& anchorPositions,
-            const std::vector<double>& ranges
+            const Anchors& anchorPositions,
+            const Ranges& ranges
         )
         : EigenLmFunctor<double>(3, static_cast<int>(ranges.size())),
           mAnchorPositions(anchorPositions),
@@ -220,35 +569,73 @@ Eigen::Vector3d nonLinearLeastSquaresEigenLevenbergMarquardt(
     };
 
     // Initial guess
-    Eigen::VectorXd posEstimate = ordinaryLeastSquaresWikipedia2(anchorPositions, ranges);
+    Eigen::VectorXd posEstimate = ordinaryLeastSquaresWikipedia2Impl(anchorPositions, ranges, diagnostics);
+    StageTimer timer(diagnostics);
 
     MultilaterationFunctor functor(anchorPositions, ranges);
     Eigen::NumericalDiff<MultilaterationFunctor> numDiff(functor);
     Eigen::LevenbergMarquardt<Eigen::NumericalDiff<MultilaterationFunctor>, double> lmSolver(numDiff);
     lmSolver.parameters.maxfev = 1000;
 
-    lmSolver.minimize(posEstimate);
+    const Eigen::LevenbergMarquardtSpace::Status status = lmSolver.minimize(posEstimate);
+    timer.lap(&SolveStageTimings::refinementNs);
+
+    if(diagnostics != nullptr)
+    {
+        // nfev includes the evaluations NumericalDiff makes for each Jacobian
+        diagnostics->iterations = static_cast<size_t>(lmSolver.iter);
+        diagnostics->functionEvaluations = static_cast<size_t>(lmSolver.nfev);
+        diagnostics->converged = isEigenLmConverged(status);
+    }
 
     return posEstimate;
 }
 
-Eigen::Vector3d robustNonLinearLeastSquaresEigenLevenbergMarquardt(
-    const std::vector<Eigen::Vector3d>& anchorPositions,
-    const std::vector<double>& ranges,
+template<typename Anchors, typename Ranges>
+Eigen::Vector3d nonLinearLeastSquaresAnalyticLevenbergMarquardtImpl(
+    const Anchors& anchorPositions,
+    const Ranges& ranges,
+    const LevenbergMarquardtOptions& options,
+    SolveResult* diagnostics = nullptr
+)
+{
+    // Initial guess
+    Eigen::Vector3d posEstimate = ordinaryLeastSquaresWikipedia2Impl(anchorPositions, ranges, diagnostics);
+    StageTimer timer(diagnostics);
+
+    RangeLevenbergMarquardt lmSolver(options);
+    const LevenbergMarquardtSummary summary = lmSolver.minimize(anchorPositions, ranges, {}, 1.0, posEstimate);
+    timer.lap(&SolveStageTimings::refinementNs);
+
+    if(diagnostics != nullptr)
+    {
+        diagnostics->iterations = summary.iterations;
+        diagnostics->functionEvaluations = summary.functionEvaluations;
+        diagnostics->converged = summary.converged;
+    }
+
+    return posEstimate;
+}
+
+template<typename Anchors, typename Ranges>
+Eigen::Vector3d robustNonLinearLeastSquaresEigenLevenbergMarquardtImpl(
+    const Anchors& anchorPositions,
+    const Ranges& ranges,
     const double rangeStdDev,
-    const double robustLossParam
+    const double robustLossParam,
+    SolveResult* diagnostics = nullptr
 )
 {
     struct WeightedMultilaterationFunctor : EigenLmFunctor<double>
     {
-        const std::vector<Eigen::Vector3d>& mAnchorPositions;
-        const std::vector<double>& mRanges;
+        const Anchors& mAnchorPositions;
+        const Ranges& mRanges;
         const std::vector<double>& mSqrtWeights;
         const double mRangeStdDev;
 
         WeightedMultilaterationFunctor(
-            const std::vector<Eigen::Vector3d>& anchorPositions,
-            const std::vector<double>& ranges,
+            const Anchors& anchorPositions,
+            const Ranges& ranges,
             const std::vector<double>& sqrtWeights,
             const double rangeStdDev
         )
@@ -293,12 +680,17 @@ Eigen::Vector3d robustNonLinearLeastSquaresEigenLevenbergMarquardt(
     };
 
     // Initial guess
-    Eigen::VectorXd posEstimate = ordinaryLeastSquaresWikipedia2(anchorPositions, ranges);
+    Eigen::VectorXd posEstimate = ordinaryLeastSquaresWikipedia2Impl(anchorPositions, ranges, diagnostics);
+    StageTimer timer(diagnostics);
 
     const size_t N = ranges.size();
     std::vector<double> sqrtWeights(N, 1.0);
 
     const size_t maxOuterIterations = 10;
+    size_t outerIterations = 0;
+    size_t innerIterations = 0;
+    size_t functionEvaluations = 0;
+    bool converged = false;
 
     double prevFnorm = std::numeric_limits<double>::max();
     for(size_t iter = 0; iter < maxOuterIterations; ++iter)
@@ -308,36 +700,81 @@ Eigen::Vector3d robustNonLinearLeastSquaresEigenLevenbergMarquardt(
         lm.parameters.maxfev = 1000;
         lm.minimize(posEstimate);
 
-        std::vector<double> residuals(N);
+        // One more sweep below computes the weights
+        ++outerIterations;
+        innerIterations += static_cast<size_t>(lm.iter);
+        functionEvaluations += static_cast<size_t>(lm.nfev + lm.njev) + 1;
+
         for (size_t i = 0; i < N; ++i)
         {
             // Compute weights using Cauchy loss function for next iteration
             double modeledRange = (posEstimate - anchorPositions[i]).norm();
-            double whitenedResidual = (modeledRange - ranges[i]) / rangeStdDev;
-            double r = residuals[i] = whitenedResidual;
+            double r = (modeledRange - ranges[i]) / rangeStdDev;
             double c = robustLossParam;
             double w = 1.0 / (1.0 + sq(r / c));
             sqrtWeights[i] = std::sqrt(std::max(w, 1e-9)); // Clamp weights to avoid numerical issues
         }
 
         // Convergence checks
-        if(std::abs(lm.fnorm - prevFnorm) < 1e-6) break; // Absolute change in cost function
-        if(std::abs((lm.fnorm - prevFnorm) / std::max(prevFnorm, 1e-9)) < 1e-6) break; // Relative change in cost function
+        converged = std::abs(lm.fnorm - prevFnorm) < 1e-6 // Absolute change in cost function
+            || std::abs((lm.fnorm - prevFnorm) / std::max(prevFnorm, 1e-9)) < 1e-6; // Relative change in cost function
+        if(converged) break;
 
         prevFnorm = lm.fnorm;
     }
+    timer.lap(&SolveStageTimings::refinementNs);
+
+    if(diagnostics != nullptr)
+    {
+        diagnostics->iterations = innerIterations;
+        diagnostics->outerIterations = outerIterations;
+        diagnostics->functionEvaluations = functionEvaluations;
+        diagnostics->converged = converged;
+    }
 
     return posEstimate;
 }
 
-Eigen::Vector3d linearLeastSquaresI_YueWang(
-    const std::vector<Eigen::Vector3d>& anchorPositions,
-    const std::vector<double>& ranges
+template<typename Anchors, typename Ranges>
+RobustLevenbergMarquardtResult robustNonLinearLeastSquaresAnalyticLevenbergMarquardtImpl(
+    const Anchors& anchorPositions,
+    const Ranges& ranges,
+    const double rangeStdDev,
+    const double robustLossParam,
+    const RobustLevenbergMarquardtOptions& options,
+    SolveResult* diagnostics = nullptr
+)
+{
+    // Initial guess
+    const Eigen::Vector3d posEstimate = ordinaryLeastSquaresWikipedia2Impl(anchorPositions, ranges, diagnostics);
+    StageTimer timer(diagnostics);
+
+    RobustRangeLevenbergMarquardt irlsSolver(options);
+    RobustLevenbergMarquardtResult result = irlsSolver.minimize(anchorPositions, ranges, rangeStdDev, robustLossParam, posEstimate);
+    timer.lap(&SolveStageTimings::refinementNs);
+
+    if(diagnostics != nullptr)
+    {
+        diagnostics->iterations = result.innerIterations;
+        diagnostics->outerIterations = result.outerIterations;
+        diagnostics->functionEvaluations = result.functionEvaluations;
+        diagnostics->converged = result.converged;
+    }
+
+    return result;
+}
+
+template<int Rows, typename Anchors, typename Ranges>
+Eigen::Vector3d linearLeastSquaresI_YueWangSized(
+    const Anchors& anchorPositions,
+    const Ranges& ranges,
+    SolveResult* diagnostics
 )
 {
+    StageTimer timer(diagnostics);
     const size_t N = ranges.size();
-    Eigen::MatrixXd A(N, 4);
-    Eigen::VectorXd b(N);
+    DesignMatrix<Rows, 4> A(N, 4);
+    Eigen::Matrix<double, Rows, 1> b(N);
 
     for(size_t i = 0; i < N; ++i)
     {
@@ -352,21 +789,43 @@ Eigen::Vector3d linearLeastSquaresI_YueWang(
         b(i) = sq(d_i) - p_i.squaredNorm();
     }
 
-    // Solve using BDCSVD for better numerical stability, especially when anchors are coplanar
-    Eigen::BDCSVD<Eigen::MatrixXd, Eigen::ComputeThinU | Eigen::ComputeThinV> svd(A);
-    Eigen::VectorXd x = svd.solve(b);
+    timer.lap(&SolveStageTimings::setupNs);
+
+    // Solve using an SVD (see LeastSquaresSvd) for better numerical stability, especially when anchors are coplanar
+    LeastSquaresSvd<decltype(A)> svd(A);
+    timer.lap(&SolveStageTimings::factorizationNs);
+
+    Eigen::Vector4d x = svd.solve(b);
+    timer.lap(&SolveStageTimings::refinementNs);
+    recordSvdRank(svd, diagnostics);
 
     return x.block<3,1>(0,0);
 }
 
-Eigen::Vector3d linearLeastSquaresII_2_YueWang(
-    const std::vector<Eigen::Vector3d>& anchorPositions,
-    const std::vector<double>& ranges
+template<typename Anchors, typename Ranges>
+Eigen::Vector3d linearLeastSquaresI_YueWangImpl(
+    const Anchors& anchorPositions,
+    const Ranges& ranges,
+    SolveResult* diagnostics = nullptr
+)
+{
+    return dispatchAnchorCount(ranges.size(), [&](auto rows) {
+        return linearLeastSquaresI_YueWangSized<decltype(rows)::value>(anchorPositions, ranges, diagnostics);
+    });
+}
+
+template<int Rows, typename Anchors, typename Ranges>
+Eigen::Vector3d linearLeastSquaresII_2_YueWangSized(
+    const Anchors& anchorPositions,
+    const Ranges& ranges,
+    SolveResult* diagnostics
 )
 {
+    StageTimer timer(diagnostics);
     const size_t N = ranges.size();
-    Eigen::MatrixXd A(N - 1, 3);
-    Eigen::VectorXd b(N - 1);
+    constexpr int ReducedRows = (Rows == Eigen::Dynamic) ? Eigen::Dynamic : Rows - 1;
+    DesignMatrix<ReducedRows, 3> A(N - 1, 3);
+    Eigen::Matrix<double, ReducedRows, 1> b(N - 1);
 
     // Select shorstest range as reference
     size_t refIndex = 0;
@@ -398,24 +857,45 @@ Eigen::Vector3d linearLeastSquaresII_2_YueWang(
 
         ++ii;
     }
+    timer.lap(&SolveStageTimings::setupNs);
+
+    // Solve using an SVD (see LeastSquaresSvd) for better numerical stability, especially when anchors are coplanar
+    LeastSquaresSvd<decltype(A)> svd(A);
+    timer.lap(&SolveStageTimings::factorizationNs);
 
-    // Solve using BDCSVD for better numerical stability, especially when anchors are coplanar
-    Eigen::BDCSVD<Eigen::MatrixXd, Eigen::ComputeThinU | Eigen::ComputeThinV> svd(A);
     Eigen::Vector3d posEstimate = svd.solve(b);
+    timer.lap(&SolveStageTimings::refinementNs);
+    recordSvdRank(svd, diagnostics);
 
     return posEstimate;
 }
 
-Eigen::Vector3d twoStepWeightedLinearLeastSquaresI_YueWang(
-    const std::vector<Eigen::Vector3d>& anchorPositions,
-    const std::vector<double>& ranges,
-    const std::vector<double>& rangeStdDevs
+template<typename Anchors, typename Ranges>
+Eigen::Vector3d linearLeastSquaresII_2_YueWangImpl(
+    const Anchors& anchorPositions,
+    const Ranges& ranges,
+    SolveResult* diagnostics = nullptr
+)
+{
+    return dispatchAnchorCount(ranges.size(), [&](auto rows) {
+        return linearLeastSquaresII_2_YueWangSized<decltype(rows)::value>(anchorPositions, ranges, diagnostics);
+    });
+}
+
+template<int Rows, typename Anchors, typename Ranges, typename StdDevs>
+Eigen::Vector3d twoStepWeightedLinearLeastSquaresI_YueWangSized(
+    const Anchors& anchorPositions,
+    const Ranges& ranges,
+    const StdDevs& rangeStdDevs,
+    SolveResult* diagnostics
 )
 {
+    StageTimer timer(diagnostics);
+
     // 1st step: Weighted Linear Least Squares I (Yue Wang)
     const size_t N = ranges.size();
-    Eigen::MatrixXd A(N, 4);
-    Eigen::VectorXd b(N);
+    DesignMatrix<Rows, 4> A(N, 4);
+    Eigen::Matrix<double, Rows, 1> b(N);
 
     for(size_t i = 0; i < N; ++i)
     {
@@ -432,7 +912,12 @@ Eigen::Vector3d twoStepWeightedLinearLeastSquaresI_YueWang(
         b(i) = (sq(d_i) - p_i.squaredNorm()) * w_i;
     }
 
-    Eigen::BDCSVD<Eigen::MatrixXd, Eigen::ComputeThinU | Eigen::ComputeThinV> svd(A);
+    timer.lap(&SolveStageTimings::setupNs);
+
+    LeastSquaresSvd<decltype(A)> svd(A);
+    timer.lap(&SolveStageTimings::factorizationNs);
+    recordSvdRank(svd, diagnostics);
+
     Eigen::Vector4d lamda_WLLS = svd.solve(b);
 
     // 2nd step: Refinement utilising the constraint of the dummy variable, R^2 = x^2 + y^2 + z^2
@@ -473,133 +958,390 @@ Eigen::Vector3d twoStepWeightedLinearLeastSquaresI_YueWang(
     posEstimate << std::sqrt(z_hat(0)) * signum(lamda_WLLS(0)),
                    std::sqrt(z_hat(1)) * signum(lamda_WLLS(1)),
                    std::sqrt(z_hat(2)) * signum(lamda_WLLS(2));
+    timer.lap(&SolveStageTimings::refinementNs);
 
     return posEstimate;
 }
 
-CrlbResult calculateRangePositionCrlb(
-    const std::vector<Eigen::Vector3d>& anchorPositions,
-    const Eigen::Vector3d& evaluationPosition,
-    double rangeStdDev
-)
-{
-    return calculateRangePositionCrlb(
-        anchorPositions,
-        evaluationPosition,
-        rangeStdDev,
-        0.0
-    );
-}
-
-CrlbResult calculateRangePositionCrlb(
-    const std::vector<Eigen::Vector3d>& anchorPositions,
-    const Eigen::Vector3d& evaluationPosition,
-    double rangeStdDev,
-    double anchorPositionStdDev
+template<typename Anchors, typename Ranges, typename StdDevs>
+Eigen::Vector3d twoStepWeightedLinearLeastSquaresI_YueWangFastImpl(
+    const Anchors& anchorPositions,
+    const Ranges& ranges,
+    const StdDevs& rangeStdDevs
 )
 {
-    if (anchorPositionStdDev < 0.0 || !std::isfinite(anchorPositionStdDev)) {
-        CrlbResult result;
-        result.usedPseudoInverse = true;
-        result.warning = "Anchor-position standard deviation must be nonnegative and finite.";
-        return result;
+    const size_t N = ranges.size();
+    if(N == 0)
+    {
+        return Eigen::Vector3d::Constant(std::numeric_limits<double>::quiet_NaN());
     }
 
-    if (anchorPositions.size() > static_cast<size_t>(std::numeric_limits<Eigen::Index>::max() / 3)) {
-        CrlbResult result;
-        result.usedPseudoInverse = true;
-        result.warning = "Too many anchors to construct the anchor-position covariance matrix.";
-        return result;
-    }
+    // 1st step: accumulate S = A^T * C^-1 * A and A^T * C^-1 * b in one pass, with a_i = [-2 * p_i^T, 1]
+    Eigen::Matrix4d S = Eigen::Matrix4d::Zero();
+    Eigen::Vector4d ATb = Eigen::Vector4d::Zero();
+    for(size_t i = 0; i < N; ++i)
+    {
+        const Eigen::Vector3d p_i = anchorPositions[i];
+        const double d_i = ranges[i];
+        const double C_i = std::max((4 * sq(d_i) * sq(rangeStdDevs[i])), 1e-9); // Prevent division by zero
+        const double w_i = 1.0 / C_i;
 
-    const Eigen::Index covarianceDimension = 3 * static_cast<Eigen::Index>(anchorPositions.size());
-    Eigen::MatrixXd anchorPositionCovariance = Eigen::MatrixXd::Zero(
-        covarianceDimension,
-        covarianceDimension
-    );
-    if (anchorPositionStdDev > 0.0) {
-        const double anchorVariance = anchorPositionStdDev * anchorPositionStdDev;
-        if (!std::isfinite(anchorVariance)) {
-            CrlbResult result;
-            result.usedPseudoInverse = true;
-            result.warning = "Anchor-position variance overflowed; use a smaller standard deviation.";
-            return result;
-        }
-        anchorPositionCovariance.diagonal().setConstant(anchorVariance);
-    }
+        Eigen::Vector4d a_i;
+        a_i << -2.0 * p_i, 1.0;
 
-    return calculateRangePositionCrlb(
-        anchorPositions,
-        evaluationPosition,
-        rangeStdDev,
-        anchorPositionCovariance
-    );
-}
+        S.selfadjointView<Eigen::Lower>().rankUpdate(a_i, w_i);
+        ATb += (w_i * (sq(d_i) - p_i.squaredNorm())) * a_i;
+    }
+    S = S.selfadjointView<Eigen::Lower>();
 
-CrlbResult calculateRangePositionCrlb(
-    const std::vector<Eigen::Vector3d>& anchorPositions,
-    const Eigen::Vector3d& evaluationPosition,
-    double rangeStdDev,
-    const Eigen::MatrixXd& anchorPositionCovariance
-)
-{
-    CrlbResult result;
+    // Jacobi-scale before factoring: the position columns grow with the anchor coordinates while the
+    // dummy column stays at 1, which would otherwise square an already large condition number
+    const Eigen::Vector4d scale = S.diagonal().cwiseMax(std::numeric_limits<double>::min()).cwiseSqrt().cwiseInverse();
+    const Eigen::Matrix4d S_scaled = scale.asDiagonal() * S * scale.asDiagonal();
+    const Eigen::Vector4d lamda_WLLS = scale.cwiseProduct(S_scaled.ldlt().solve(scale.cwiseProduct(ATb)));
 
-    auto appendWarning = [&result](const std::string& warning) {
-        if (!result.warning.empty()) {
-            result.warning += " ";
-        }
-        result.warning += warning;
-    };
+    // 2nd step: Refinement utilising the constraint of the dummy variable, R^2 = x^2 + y^2 + z^2
+    // K is diagonal, so phi^-1 = (K * S^-1 * K)^-1 = K^-1 * S * K^-1 and neither 4x4 inverse is needed
+    Eigen::Vector4d K_inv;
+    K_inv << 0.5 / lamda_WLLS(0),
+             0.5 / lamda_WLLS(1),
+             0.5 / lamda_WLLS(2),
+             -1.0;
+    const Eigen::Matrix4d phi_inv = K_inv.asDiagonal() * S * K_inv.asDiagonal();
 
-    if (rangeStdDev <= 0.0 || !std::isfinite(rangeStdDev)) {
-        result.valid = false;
-        result.usedPseudoInverse = true;
-        appendWarning("Range standard deviation must be positive and finite.");
-        return result;
-    }
+    Eigen::Matrix<double, 4, 3> G;
+    G << 1.0, 0.0, 0.0,
+         0.0, 1.0, 0.0,
+         0.0, 0.0, 1.0,
+         1.0, 1.0, 1.0;
 
-    if (anchorPositions.size() > static_cast<size_t>(std::numeric_limits<Eigen::Index>::max() / 3)) {
-        result.usedPseudoInverse = true;
-        appendWarning("Too many anchors to validate the anchor-position covariance matrix.");
-        return result;
-    }
+    Eigen::Matrix<double, 4, 1> h;
+    h << sq(lamda_WLLS(0)),
+         sq(lamda_WLLS(1)),
+         sq(lamda_WLLS(2)),
+         lamda_WLLS(3);
 
-    if (!evaluationPosition.allFinite()) {
-        result.usedPseudoInverse = true;
-        appendWarning("CRLB evaluation position must contain only finite coordinates.");
-        return result;
-    }
+    const Eigen::Matrix3d GT_phiInv_G = G.transpose() * phi_inv * G;
+    const Eigen::Vector3d GT_phiInv_h = G.transpose() * phi_inv * h;
 
-    for (const Eigen::Vector3d& anchorPosition : anchorPositions) {
-        if (!anchorPosition.allFinite()) {
-            result.usedPseudoInverse = true;
-            appendWarning("Anchor positions must contain only finite coordinates.");
-            return result;
-        }
-    }
+    Eigen::Vector3d z_hat = GT_phiInv_G.ldlt().solve(GT_phiInv_h);
+    z_hat = z_hat.cwiseMax(0.0);
 
-    const Eigen::Index anchorCount = static_cast<Eigen::Index>(anchorPositions.size());
-    const Eigen::Index covarianceDimension = 3 * anchorCount;
+    Eigen::Vector3d posEstimate;
+    posEstimate << std::sqrt(z_hat(0)) * signum(lamda_WLLS(0)),
+                   std::sqrt(z_hat(1)) * signum(lamda_WLLS(1)),
+                   std::sqrt(z_hat(2)) * signum(lamda_WLLS(2));
+
+    return posEstimate;
+}
+
+template<typename Anchors, typename Ranges, typename StdDevs>
+Eigen::Vector3d twoStepWeightedLinearLeastSquaresI_YueWangImpl(
+    const Anchors& anchorPositions,
+    const Ranges& ranges,
+    const StdDevs& rangeStdDevs,
+    SolveResult* diagnostics = nullptr
+)
+{
+    return dispatchAnchorCount(ranges.size(), [&](auto rows) {
+        return twoStepWeightedLinearLeastSquaresI_YueWangSized<decltype(rows)::value>(anchorPositions, ranges, rangeStdDevs, diagnostics);
+    });
+}
+
+} // namespace anonymous
+
+Eigen::Vector3d ordinaryLeastSquaresWikipedia(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const std::vector<double>& ranges
+)
+{
+    return ordinaryLeastSquaresWikipediaImpl(anchorPositions, ranges);
+}
+
+Eigen::Vector3d ordinaryLeastSquaresWikipedia(
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    SolveResult* diagnostics
+)
+{
+    return visitMeasurements(
+        [=](const auto& anchorSpan, const auto& rangeSpan) { return ordinaryLeastSquaresWikipediaImpl(anchorSpan, rangeSpan, diagnostics); },
+        anchorPositions, ranges);
+}
+
+Eigen::Vector3d ordinaryLeastSquaresWikipediaFast(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const std::vector<double>& ranges
+)
+{
+    return ordinaryLeastSquaresWikipediaFastImpl(anchorPositions, ranges);
+}
+
+Eigen::Vector3d ordinaryLeastSquaresWikipediaFast(
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges
+)
+{
+    return visitMeasurements(
+        [](const auto& anchorSpan, const auto& rangeSpan) { return ordinaryLeastSquaresWikipediaFastImpl(anchorSpan, rangeSpan); },
+        anchorPositions, ranges);
+}
+
+Eigen::Vector3d ordinaryLeastSquaresWikipedia2(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const std::vector<double>& ranges
+)
+{
+    return ordinaryLeastSquaresWikipedia2Impl(anchorPositions, ranges);
+}
+
+Eigen::Vector3d ordinaryLeastSquaresWikipedia2(
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    SolveResult* diagnostics
+)
+{
+    return visitMeasurements(
+        [=](const auto& anchorSpan, const auto& rangeSpan) { return ordinaryLeastSquaresWikipedia2Impl(anchorSpan, rangeSpan, diagnostics); },
+        anchorPositions, ranges);
+}
+
+Eigen::Vector3d nonLinearLeastSquaresEigenLevenbergMarquardt(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const std::vector<double>& ranges
+)
+{
+    return nonLinearLeastSquaresEigenLevenbergMarquardtImpl(anchorPositions, ranges);
+}
+
+Eigen::Vector3d nonLinearLeastSquaresEigenLevenbergMarquardt(
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    SolveResult* diagnostics
+)
+{
+    return visitMeasurements(
+        [=](const auto& anchorSpan, const auto& rangeSpan) { return nonLinearLeastSquaresEigenLevenbergMarquardtImpl(anchorSpan, rangeSpan, diagnostics); },
+        anchorPositions, ranges);
+}
+
+Eigen::Vector3d nonLinearLeastSquaresAnalyticLevenbergMarquardt(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const std::vector<double>& ranges
+)
+{
+    return nonLinearLeastSquaresAnalyticLevenbergMarquardtImpl(anchorPositions, ranges, LevenbergMarquardtOptions{});
+}
+
+Eigen::Vector3d nonLinearLeastSquaresAnalyticLevenbergMarquardt(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const std::vector<double>& ranges,
+    const LevenbergMarquardtOptions& options
+)
+{
+    return nonLinearLeastSquaresAnalyticLevenbergMarquardtImpl(anchorPositions, ranges, options);
+}
+
+Eigen::Vector3d nonLinearLeastSquaresAnalyticLevenbergMarquardt(
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    const LevenbergMarquardtOptions& options,
+    SolveResult* diagnostics
+)
+{
+    return visitMeasurements(
+        [&](const auto& anchorSpan, const auto& rangeSpan) {
+            return nonLinearLeastSquaresAnalyticLevenbergMarquardtImpl(anchorSpan, rangeSpan, options, diagnostics);
+        },
+        anchorPositions, ranges);
+}
+
+Eigen::Vector3d robustNonLinearLeastSquaresEigenLevenbergMarquardt(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const std::vector<double>& ranges,
+    const double rangeStdDev,
+    const double robustLossParam
+)
+{
+    return robustNonLinearLeastSquaresEigenLevenbergMarquardtImpl(anchorPositions, ranges, rangeStdDev, robustLossParam);
+}
+
+Eigen::Vector3d robustNonLinearLeastSquaresEigenLevenbergMarquardt(
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    const double rangeStdDev,
+    const double robustLossParam,
+    SolveResult* diagnostics
+)
+{
+    return visitMeasurements(
+        [&](const auto& anchorSpan, const auto& rangeSpan) {
+            return robustNonLinearLeastSquaresEigenLevenbergMarquardtImpl(anchorSpan, rangeSpan, rangeStdDev, robustLossParam, diagnostics);
+        },
+        anchorPositions, ranges);
+}
+
+RobustLevenbergMarquardtResult robustNonLinearLeastSquaresAnalyticLevenbergMarquardt(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const std::vector<double>& ranges,
+    const double rangeStdDev,
+    const double robustLossParam
+)
+{
+    return robustNonLinearLeastSquaresAnalyticLevenbergMarquardtImpl(
+        anchorPositions, ranges, rangeStdDev, robustLossParam, RobustLevenbergMarquardtOptions{});
+}
+
+RobustLevenbergMarquardtResult robustNonLinearLeastSquaresAnalyticLevenbergMarquardt(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const std::vector<double>& ranges,
+    const double rangeStdDev,
+    const double robustLossParam,
+    const RobustLevenbergMarquardtOptions& options
+)
+{
+    return robustNonLinearLeastSquaresAnalyticLevenbergMarquardtImpl(anchorPositions, ranges, rangeStdDev, robustLossParam, options);
+}
+
+RobustLevenbergMarquardtResult robustNonLinearLeastSquaresAnalyticLevenbergMarquardt(
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    const double rangeStdDev,
+    const double robustLossParam,
+    const RobustLevenbergMarquardtOptions& options,
+    SolveResult* diagnostics
+)
+{
+    return visitMeasurements(
+        [&](const auto& anchorSpan, const auto& rangeSpan) {
+            return robustNonLinearLeastSquaresAnalyticLevenbergMarquardtImpl(anchorSpan, rangeSpan, rangeStdDev, robustLossParam, options, diagnostics);
+        },
+        anchorPositions, ranges);
+}
+
+Eigen::Vector3d linearLeastSquaresI_YueWang(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const std::vector<double>& ranges
+)
+{
+    return linearLeastSquaresI_YueWangImpl(anchorPositions, ranges);
+}
+
+Eigen::Vector3d linearLeastSquaresI_YueWang(
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    SolveResult* diagnostics
+)
+{
+    return visitMeasurements(
+        [=](const auto& anchorSpan, const auto& rangeSpan) { return linearLeastSquaresI_YueWangImpl(anchorSpan, rangeSpan, diagnostics); },
+        anchorPositions, ranges);
+}
+
+Eigen::Vector3d linearLeastSquaresII_2_YueWang(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const std::vector<double>& ranges
+)
+{
+    return linearLeastSquaresII_2_YueWangImpl(anchorPositions, ranges);
+}
+
+Eigen::Vector3d linearLeastSquaresII_2_YueWang(
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    SolveResult* diagnostics
+)
+{
+    return visitMeasurements(
+        [=](const auto& anchorSpan, const auto& rangeSpan) { return linearLeastSquaresII_2_YueWangImpl(anchorSpan, rangeSpan, diagnostics); },
+        anchorPositions, ranges);
+}
+
+Eigen::Vector3d twoStepWeightedLinearLeastSquaresI_YueWang(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const std::vector<double>& ranges,
+    const std::vector<double>& rangeStdDevs
+)
+{
+    return twoStepWeightedLinearLeastSquaresI_YueWangImpl(anchorPositions, ranges, rangeStdDevs);
+}
+
+Eigen::Vector3d twoStepWeightedLinearLeastSquaresI_YueWang(
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    const RangesView& rangeStdDevs,
+    SolveResult* diagnostics
+)
+{
+    return visitMeasurements(
+        [=](const auto& anchorSpan, const auto& rangeSpan, const auto& stdDevSpan) {
+            return twoStepWeightedLinearLeastSquaresI_YueWangImpl(anchorSpan, rangeSpan, stdDevSpan, diagnostics);
+        },
+        anchorPositions, ranges, rangeStdDevs);
+}
+
+double rangeResidualCost(
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    const Eigen::Vector3d& position
+)
+{
+    return visitMeasurements(
+        [&](const auto& anchorSpan, const auto& rangeSpan) {
+            double sumSquaredResiduals = 0.0;
+            for(size_t i = 0; i < rangeSpan.size(); ++i)
+            {
+                sumSquaredResiduals += sq((position - anchorSpan[i]).norm() - rangeSpan[i]);
+            }
+            return 0.5 * sumSquaredResiduals;
+        },
+        anchorPositions, ranges);
+}
+
+Eigen::Vector3d twoStepWeightedLinearLeastSquaresI_YueWangFast(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const std::vector<double>& ranges,
+    const std::vector<double>& rangeStdDevs
+)
+{
+    return twoStepWeightedLinearLeastSquaresI_YueWangFastImpl(anchorPositions, ranges, rangeStdDevs);
+}
+
+Eigen::Vector3d twoStepWeightedLinearLeastSquaresI_YueWangFast(
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    const RangesView& rangeStdDevs
+)
+{
+    return visitMeasurements(
+        [](const auto& anchorSpan, const auto& rangeSpan, const auto& stdDevSpan) {
+            return twoStepWeightedLinearLeastSquaresI_YueWangFastImpl(anchorSpan, rangeSpan, stdDevSpan);
+        },
+        anchorPositions, ranges, rangeStdDevs);
+}
+
+std::string validateAnchorPositionCovariance(
+    const Eigen::MatrixXd& anchorPositionCovariance,
+    size_t anchorCount,
+    Eigen::MatrixXd& validatedCovariance
+)
+{
+    const Eigen::Index covarianceDimension = 3 * static_cast<Eigen::Index>(anchorCount);
     if (anchorPositionCovariance.rows() != covarianceDimension ||
         anchorPositionCovariance.cols() != covarianceDimension) {
-        result.usedPseudoInverse = true;
-        appendWarning(std::format(
+        return std::format(
             "Anchor-position covariance must have dimensions {} x {} for {} anchors.",
             covarianceDimension,
             covarianceDimension,
             anchorCount
-        ));
-        return result;
+        );
     }
 
     if (!anchorPositionCovariance.allFinite()) {
-        result.usedPseudoInverse = true;
-        appendWarning("Anchor-position covariance must contain only finite values.");
-        return result;
+        return "Anchor-position covariance must contain only finite values.";
     }
 
-    Eigen::MatrixXd validatedCovariance = anchorPositionCovariance;
+    validatedCovariance = anchorPositionCovariance;
     if (covarianceDimension > 0) {
         const double covarianceScale = std::max(
             1.0,
@@ -610,9 +1352,7 @@ CrlbResult calculateRangePositionCrlb(
         const double maxAsymmetry =
             (anchorPositionCovariance - anchorPositionCovariance.transpose()).cwiseAbs().maxCoeff();
         if (maxAsymmetry > covarianceTolerance) {
-            result.usedPseudoInverse = true;
-            appendWarning("Anchor-position covariance is materially nonsymmetric.");
-            return result;
+            return "Anchor-position covariance is materially nonsymmetric.";
         }
 
         validatedCovariance = 0.5 * (
@@ -620,16 +1360,12 @@ CrlbResult calculateRangePositionCrlb(
         );
         Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> covarianceEigensolver(validatedCovariance);
         if (covarianceEigensolver.info() != Eigen::Success) {
-            result.usedPseudoInverse = true;
-            appendWarning("Failed to decompose the anchor-position covariance matrix.");
-            return result;
+            return "Failed to decompose the anchor-position covariance matrix.";
         }
 
         const Eigen::VectorXd covarianceEigenvalues = covarianceEigensolver.eigenvalues();
         if (covarianceEigenvalues.minCoeff() < -covarianceTolerance) {
-            result.usedPseudoInverse = true;
-            appendWarning("Anchor-position covariance is not positive semidefinite.");
-            return result;
+            return "Anchor-position covariance is not positive semidefinite.";
         }
 
         // Project only roundoff-sized negative eigenvalues to zero. The documented
@@ -642,121 +1378,244 @@ CrlbResult calculateRangePositionCrlb(
         }
     }
 
-    if (anchorPositions.size() < 4) {
+    return {};
+}
+
+CrlbResult calculateRangePositionCrlb(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const Eigen::Vector3d& evaluationPosition,
+    double rangeStdDev
+)
+{
+    return calculateRangePositionCrlb(
+        anchorPositions,
+        evaluationPosition,
+        rangeStdDev,
+        0.0
+    );
+}
+
+CrlbResult calculateRangePositionCrlb(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const Eigen::Vector3d& evaluationPosition,
+    double rangeStdDev,
+    double anchorPositionStdDev
+)
+{
+    CrlbResult result;
+    if (anchorPositionStdDev < 0.0 || !std::isfinite(anchorPositionStdDev)) {
         result.usedPseudoInverse = true;
-        appendWarning("Fewer than 4 anchors cannot fully constrain a 3D true-range position; displaying pseudo-inverse CRLB.");
+        result.warning = "Anchor-position standard deviation must be nonnegative and finite.";
+        return result;
     }
 
-    const double rangeVariance = rangeStdDev * rangeStdDev;
-    if (!std::isfinite(rangeVariance)) {
+    const double anchorVariance = anchorPositionStdDev * anchorPositionStdDev;
+    if (!std::isfinite(anchorVariance)) {
         result.usedPseudoInverse = true;
-        appendWarning("Range variance overflowed; use a smaller standard deviation.");
+        result.warning = "Anchor-position variance overflowed; use a smaller standard deviation.";
         return result;
     }
 
-    constexpr double minRange = 1e-12;
-    Eigen::MatrixXd U(anchorCount, 3);
-    Eigen::MatrixXd B = Eigen::MatrixXd::Zero(anchorCount, covarianceDimension);
-    Eigen::Index usableAnchorCount = 0;
+    double rangeVariance = 0.0;
+    if (!checkCrlbInputs(anchorPositions, evaluationPosition, rangeStdDev, result) ||
+        !checkCrlbRangeVariance(anchorPositions.size(), rangeStdDev, result, rangeVariance)) {
+        return result;
+    }
 
-    for (Eigen::Index anchorIndex = 0; anchorIndex < anchorCount; ++anchorIndex) {
-        const Eigen::Vector3d& anchorPosition = anchorPositions[static_cast<size_t>(anchorIndex)];
-        const Eigen::Vector3d delta = evaluationPosition - anchorPosition;
-        const double rho = delta.norm();
-        if (!delta.allFinite() || !std::isfinite(rho)) {
+    // u^T (s^2 I) u with a unit u
+    return independentAnchorCrlb(
+        anchorPositions,
+        evaluationPosition,
+        rangeVariance,
+        [anchorVariance](size_t, const Eigen::Vector3d& u) { return anchorVariance * u.squaredNorm(); },
+        std::move(result)
+    );
+}
+
+CrlbResult calculateRangePositionCrlb(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const Eigen::Vector3d& evaluationPosition,
+    double rangeStdDev,
+    const std::vector<Eigen::Matrix3d>& anchorCovarianceBlocks
+)
+{
+    CrlbResult result;
+    if (!checkCrlbInputs(anchorPositions, evaluationPosition, rangeStdDev, result)) {
+        return result;
+    }
+
+    if (anchorCovarianceBlocks.size() != anchorPositions.size()) {
+        result.usedPseudoInverse = true;
+        appendCrlbWarning(result, std::format(
+            "Anchor-position covariance must have one 3 x 3 block per anchor ({} blocks for {} anchors).",
+            anchorCovarianceBlocks.size(),
+            anchorPositions.size()
+        ));
+        return result;
+    }
+
+    // Same scale-aware tolerance as the stacked 3N x 3N covariance: 1e-10 * max(1, max |C_a|)
+    double covarianceScale = 1.0;
+    for (const Eigen::Matrix3d& block : anchorCovarianceBlocks) {
+        if (!block.allFinite()) {
             result.usedPseudoInverse = true;
-            appendWarning("Anchor-to-evaluation geometry overflowed during CRLB calculation.");
+            appendCrlbWarning(result, "Anchor-position covariance must contain only finite values.");
             return result;
         }
-        if (rho <= minRange) {
+        covarianceScale = std::max(covarianceScale, block.cwiseAbs().maxCoeff());
+    }
+    const double covarianceTolerance = 1e-10 * covarianceScale;
+
+    std::vector<Eigen::Matrix3d> validatedBlocks(anchorCovarianceBlocks.size());
+    for (size_t i = 0; i < anchorCovarianceBlocks.size(); ++i) {
+        const std::string blockWarning = validateAnchorCovarianceBlock(
+            anchorCovarianceBlocks[i],
+            covarianceTolerance,
+            validatedBlocks[i]
+        );
+        if (!blockWarning.empty()) {
             result.usedPseudoInverse = true;
-            appendWarning("An anchor is too close to the CRLB evaluation position and was skipped.");
-            continue;
+            appendCrlbWarning(result, blockWarning);
+            return result;
         }
-
-        const Eigen::Vector3d u = delta / rho;
-        U.row(usableAnchorCount) = u.transpose();
-        B.block<1, 3>(usableAnchorCount, 3 * anchorIndex) = -u.transpose();
-        ++usableAnchorCount;
     }
 
-    if (usableAnchorCount == 0) {
-        result.valid = false;
-        result.usedPseudoInverse = true;
-        appendWarning("No usable anchors remain after input validation.");
+    double rangeVariance = 0.0;
+    if (!checkCrlbRangeVariance(anchorPositions.size(), rangeStdDev, result, rangeVariance)) {
         return result;
     }
 
-    U.conservativeResize(usableAnchorCount, Eigen::NoChange);
-    B.conservativeResize(usableAnchorCount, Eigen::NoChange);
-
-    Eigen::MatrixXd effectiveRangeCovariance =
-        rangeVariance * Eigen::MatrixXd::Identity(usableAnchorCount, usableAnchorCount)
-        + B * validatedCovariance * B.transpose();
-    effectiveRangeCovariance = 0.5 * (
-        effectiveRangeCovariance + effectiveRangeCovariance.transpose()
+    return independentAnchorCrlb(
+        anchorPositions,
+        evaluationPosition,
+        rangeVariance,
+        [&validatedBlocks](size_t i, const Eigen::Vector3d& u) { return u.dot(validatedBlocks[i] * u); },
+        std::move(result)
     );
-    if (!effectiveRangeCovariance.allFinite()) {
+}
+
+CrlbResult calculateRangePositionCrlb(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const Eigen::Vector3d& evaluationPosition,
+    double rangeStdDev,
+    const Eigen::MatrixXd& anchorPositionCovariance
+)
+{
+    CrlbResult result;
+
+    if (anchorPositions.size() > static_cast<size_t>(std::numeric_limits<Eigen::Index>::max() / 3)) {
         result.usedPseudoInverse = true;
-        appendWarning("Effective range covariance contains nonfinite values.");
+        appendCrlbWarning(result, "Too many anchors to validate the anchor-position covariance matrix.");
         return result;
     }
 
-    Eigen::LLT<Eigen::MatrixXd> covarianceFactorization(effectiveRangeCovariance);
-    if (covarianceFactorization.info() != Eigen::Success) {
-        result.usedPseudoInverse = true;
-        appendWarning("Failed to factor the effective range covariance matrix.");
+    if (!checkCrlbInputs(anchorPositions, evaluationPosition, rangeStdDev, result)) {
         return result;
     }
 
-    const Eigen::MatrixXd weightedJacobian = covarianceFactorization.solve(U);
-    if (covarianceFactorization.info() != Eigen::Success || !weightedJacobian.allFinite()) {
+    const Eigen::Index anchorCount = static_cast<Eigen::Index>(anchorPositions.size());
+    Eigen::MatrixXd validatedCovariance;
+    const std::string covarianceWarning = validateAnchorPositionCovariance(
+        anchorPositionCovariance,
+        anchorPositions.size(),
+        validatedCovariance
+    );
+    if (!covarianceWarning.empty()) {
         result.usedPseudoInverse = true;
-        appendWarning("Failed to solve with the effective range covariance matrix.");
+        appendCrlbWarning(result, covarianceWarning);
         return result;
     }
 
-    result.fisherInformation = U.transpose() * weightedJacobian;
-    result.fisherInformation = 0.5 * (
-        result.fisherInformation + result.fisherInformation.transpose()
-    );
-    if (!result.fisherInformation.allFinite()) {
-        result.usedPseudoInverse = true;
-        appendWarning("Fisher information matrix contains nonfinite values.");
+    double rangeVariance = 0.0;
+    if (!checkCrlbRangeVariance(anchorPositions.size(), rangeStdDev, result, rangeVariance)) {
         return result;
     }
 
-    Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> eigensolver(result.fisherInformation);
-    if (eigensolver.info() != Eigen::Success) {
+    // Without cross-anchor blocks S is diagonal and the O(N) path applies
+    bool blockDiagonal = true;
+    for (Eigen::Index i = 0; i < anchorCount && blockDiagonal; ++i) {
+        for (Eigen::Index j = 0; j < anchorCount; ++j) {
+            if (i != j && !validatedCovariance.block<3, 3>(3 * i, 3 * j).isZero(0.0)) {
+                blockDiagonal = false;
+                break;
+            }
+        }
+    }
+    if (blockDiagonal) {
+        return independentAnchorCrlb(
+            anchorPositions,
+            evaluationPosition,
+            rangeVariance,
+            [&validatedCovariance](size_t i, const Eigen::Vector3d& u) {
+                const Eigen::Index offset = 3 * static_cast<Eigen::Index>(i);
+                return u.dot(validatedCovariance.block<3, 3>(offset, offset) * u);
+            },
+            std::move(result)
+        );
+    }
+
+    Eigen::MatrixXd U(anchorCount, 3);
+    std::vector<Eigen::Index> usableAnchors;
+    usableAnchors.reserve(anchorPositions.size());
+
+    for (Eigen::Index anchorIndex = 0; anchorIndex < anchorCount; ++anchorIndex) {
+        Eigen::Vector3d u;
+        bool usable = false;
+        if (!crlbLineOfSight(anchorPositions[static_cast<size_t>(anchorIndex)], evaluationPosition, result, u, usable)) {
+            return result;
+        }
+        if (!usable) {
+            continue;
+        }
+
+        U.row(static_cast<Eigen::Index>(usableAnchors.size())) = u.transpose();
+        usableAnchors.push_back(anchorIndex);
+    }
+
+    const Eigen::Index usableAnchorCount = static_cast<Eigen::Index>(usableAnchors.size());
+    if (usableAnchorCount == 0) {
         result.valid = false;
         result.usedPseudoInverse = true;
-        appendWarning("Failed to decompose the Fisher information matrix.");
+        appendCrlbWarning(result, "No usable anchors remain after input validation.");
         return result;
     }
 
-    const Eigen::Vector3d eigenvalues = eigensolver.eigenvalues();
-    const Eigen::Matrix3d eigenvectors = eigensolver.eigenvectors();
-    const double maxAbsEigenvalue = eigenvalues.cwiseAbs().maxCoeff();
-    const double tolerance = 1e-12 * std::max(1.0, maxAbsEigenvalue);
+    U.conservativeResize(usableAnchorCount, Eigen::NoChange);
 
-    Eigen::Vector3d inverseEigenvalues = Eigen::Vector3d::Zero();
-    result.rank = 0;
-    for (Eigen::Index i = 0; i < eigenvalues.size(); ++i) {
-        if (eigenvalues(i) > tolerance) {
-            inverseEigenvalues(i) = 1.0 / eigenvalues(i);
-            ++result.rank;
+    // B has the single nonzero block -u_a^T per row, so (B C_a B^T)_ab = u_a^T C_ab u_b
+    Eigen::MatrixXd effectiveRangeCovariance(usableAnchorCount, usableAnchorCount);
+    for (Eigen::Index a = 0; a < usableAnchorCount; ++a) {
+        for (Eigen::Index b = a; b < usableAnchorCount; ++b) {
+            const double projectedCovariance = (U.row(a)
+                * validatedCovariance.block<3, 3>(3 * usableAnchors[static_cast<size_t>(a)], 3 * usableAnchors[static_cast<size_t>(b)])
+                * U.row(b).transpose()).value();
+            effectiveRangeCovariance(a, b) = projectedCovariance;
+            effectiveRangeCovariance(b, a) = projectedCovariance;
         }
+        effectiveRangeCovariance(a, a) += rangeVariance;
+    }
+    if (!effectiveRangeCovariance.allFinite()) {
+        result.usedPseudoInverse = true;
+        appendCrlbWarning(result, "Effective range covariance contains nonfinite values.");
+        return result;
     }
 
-    result.crlb = eigenvectors * inverseEigenvalues.asDiagonal() * eigenvectors.transpose();
-    result.crlb = 0.5 * (result.crlb + result.crlb.transpose());
-    result.valid = true;
+    Eigen::LLT<Eigen::MatrixXd> covarianceFactorization(effectiveRangeCovariance);
+    if (covarianceFactorization.info() != Eigen::Success) {
+        result.usedPseudoInverse = true;
+        appendCrlbWarning(result, "Failed to factor the effective range covariance matrix.");
+        return result;
+    }
 
-    if (result.rank < 3) {
+    const Eigen::MatrixXd weightedJacobian = covarianceFactorization.solve(U);
+    if (covarianceFactorization.info() != Eigen::Success || !weightedJacobian.allFinite()) {
         result.usedPseudoInverse = true;
-        appendWarning("Fisher information matrix is rank deficient; displaying pseudo-inverse CRLB. The true covariance bound is unbounded in one or more directions.");
+        appendCrlbWarning(result, "Failed to solve with the effective range covariance matrix.");
+        return result;
     }
 
+    result.fisherInformation = U.transpose() * weightedJacobian;
+    invertCrlbFisherInformation(result);
     return result;
 }
 
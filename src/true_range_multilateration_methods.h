@@ -8,6 +8,8 @@
 #include <Eigen/Dense>
 
 #include "core/simulation_types.h"
+#include "measurement_views.h"
+#include "range_levenberg_marquardt.h"
 
 namespace TrueRangeMultilateration
 {
@@ -24,6 +26,38 @@ Eigen::Vector3d ordinaryLeastSquaresWikipedia(
     const std::vector<double>& ranges
 );
 
+/**
+ * @brief ordinaryLeastSquaresWikipedia over caller-owned anchor and range memory (see AnchorPositionsView and RangesView)
+ * @param diagnostics If not null, receives stage timings (see SolveResult)
+ */
+Eigen::Vector3d ordinaryLeastSquaresWikipedia(
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    SolveResult* diagnostics = nullptr
+);
+
+/**
+ * @brief Allocation-free variant of ordinaryLeastSquaresWikipedia
+ * Accumulates the 3x3 normal equations and right-hand side in a single pass over the anchors
+ * (relative to the first anchor, for conditioning) and solves them with a fixed-size LDLT.
+ * Matches ordinaryLeastSquaresWikipedia up to floating-point rounding.
+ * @param anchorPositions Position of anchors (Note: solver fails, if anchors are coplanar)
+ * @param ranges
+ * @return Eigen::Vector3d Estimated position
+ */
+Eigen::Vector3d ordinaryLeastSquaresWikipediaFast(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const std::vector<double>& ranges
+);
+
+/**
+ * @brief ordinaryLeastSquaresWikipediaFast over caller-owned anchor and range memory
+ */
+Eigen::Vector3d ordinaryLeastSquaresWikipediaFast(
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges
+);
+
 /**
  * @brief Method from https://en.wikipedia.org/wiki/True-range_multilateration#General_Multilateration
  * Uses ordinary least squares to solve the linearised problem using Eigen's BDCSVD
@@ -36,6 +70,16 @@ Eigen::Vector3d ordinaryLeastSquaresWikipedia2(
     const std::vector<double>& ranges
 );
 
+/**
+ * @brief ordinaryLeastSquaresWikipedia2 over caller-owned anchor and range memory
+ * @param diagnostics If not null, receives the SVD rank and stage timings (see SolveResult)
+ */
+Eigen::Vector3d ordinaryLeastSquaresWikipedia2(
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    SolveResult* diagnostics = nullptr
+);
+
 /**
  * @brief Method using Eigen's Levenberg-Marquardt implementation to solve the non-linear least squares problem
  * @param anchorPositions 
@@ -47,6 +91,53 @@ Eigen::Vector3d nonLinearLeastSquaresEigenLevenbergMarquardt(
     const std::vector<double>& ranges
 );
 
+/**
+ * @brief nonLinearLeastSquaresEigenLevenbergMarquardt over caller-owned anchor and range memory
+ * @param diagnostics If not null, receives iteration counts, SVD rank and stage timings (see SolveResult)
+ */
+Eigen::Vector3d nonLinearLeastSquaresEigenLevenbergMarquardt(
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    SolveResult* diagnostics = nullptr
+);
+
+/**
+ * @brief Non-linear least squares using the fixed-size, analytic-Jacobian RangeLevenbergMarquardt engine
+ * Starts from ordinaryLeastSquaresWikipedia2 like nonLinearLeastSquaresEigenLevenbergMarquardt, but needs no
+ * numerical differentiation or dynamic-size buffers.
+ * @param anchorPositions 
+ * @param ranges 
+ * @return Eigen::Vector3d Estimated position
+ */
+Eigen::Vector3d nonLinearLeastSquaresAnalyticLevenbergMarquardt(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const std::vector<double>& ranges
+);
+
+/**
+ * @brief nonLinearLeastSquaresAnalyticLevenbergMarquardt with explicit stopping tolerances
+ * @param anchorPositions 
+ * @param ranges 
+ * @param options Iteration limit, stopping tolerances and initial damping
+ * @return Eigen::Vector3d Estimated position
+ */
+Eigen::Vector3d nonLinearLeastSquaresAnalyticLevenbergMarquardt(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const std::vector<double>& ranges,
+    const LevenbergMarquardtOptions& options
+);
+
+/**
+ * @brief nonLinearLeastSquaresAnalyticLevenbergMarquardt over caller-owned anchor and range memory
+ * @param diagnostics If not null, receives iteration counts, SVD rank and stage timings (see SolveResult)
+ */
+Eigen::Vector3d nonLinearLeastSquaresAnalyticLevenbergMarquardt(
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    const LevenbergMarquardtOptions& options = LevenbergMarquardtOptions{},
+    SolveResult* diagnostics = nullptr
+);
+
 /**
  * @brief Robust method using Eigen's Levenberg-Marquardt implementation to solve the non-linear least squares problem
  * with robust loss functions using an iteratively reweighted least squares approach
@@ -63,6 +154,65 @@ Eigen::Vector3d robustNonLinearLeastSquaresEigenLevenbergMarquardt(
     const double robustLossParam
 );
 
+/**
+ * @brief robustNonLinearLeastSquaresEigenLevenbergMarquardt over caller-owned anchor and range memory
+ * @param diagnostics If not null, receives iteration counts, SVD rank and stage timings (see SolveResult)
+ */
+Eigen::Vector3d robustNonLinearLeastSquaresEigenLevenbergMarquardt(
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    const double rangeStdDev,
+    const double robustLossParam,
+    SolveResult* diagnostics = nullptr
+);
+
+/**
+ * @brief Robust IRLS solver with Cauchy weights on top of a single RangeLevenbergMarquardt instance
+ * The damping parameter and the weight buffer carry over between reweighting passes, so later passes start
+ * from the previous pass's trust region instead of re-initialising it.
+ * @param anchorPositions 
+ * @param ranges 
+ * @param rangeStdDev Standard deviation of the range measurements (used for whitening)
+ * @param robustLossParam Scale parameter of the Cauchy loss
+ * @return RobustLevenbergMarquardtResult Estimated position, iteration and evaluation counts, and final weights
+ */
+RobustLevenbergMarquardtResult robustNonLinearLeastSquaresAnalyticLevenbergMarquardt(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const std::vector<double>& ranges,
+    const double rangeStdDev,
+    const double robustLossParam
+);
+
+/**
+ * @brief robustNonLinearLeastSquaresAnalyticLevenbergMarquardt with explicit outer- and inner-loop settings
+ * @param anchorPositions 
+ * @param ranges 
+ * @param rangeStdDev Standard deviation of the range measurements (used for whitening)
+ * @param robustLossParam Scale parameter of the Cauchy loss
+ * @param options Reweighting pass limit, warm-start switch and per-pass LM settings
+ * @return RobustLevenbergMarquardtResult Estimated position, iteration and evaluation counts, and final weights
+ */
+RobustLevenbergMarquardtResult robustNonLinearLeastSquaresAnalyticLevenbergMarquardt(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const std::vector<double>& ranges,
+    const double rangeStdDev,
+    const double robustLossParam,
+    const RobustLevenbergMarquardtOptions& options
+);
+
+/**
+ * @brief robustNonLinearLeastSquaresAnalyticLevenbergMarquardt over caller-owned anchor and range memory
+ * @param diagnostics If not null, receives iteration counts, SVD rank and stage timings (see SolveResult)
+ */
+RobustLevenbergMarquardtResult robustNonLinearLeastSquaresAnalyticLevenbergMarquardt(
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    const double rangeStdDev,
+    const double robustLossParam,
+    const RobustLevenbergMarquardtOptions& options = RobustLevenbergMarquardtOptions{},
+    SolveResult* diagnostics = nullptr
+);
+
 /**
  * @brief LLS-I method from "Linear least squares localization in sensor networks" by Yue Wang. (2015)
  * @param anchorPositions 
@@ -74,6 +224,16 @@ Eigen::Vector3d linearLeastSquaresI_YueWang(
     const std::vector<double>& ranges
 );
 
+/**
+ * @brief linearLeastSquaresI_YueWang over caller-owned anchor and range memory
+ * @param diagnostics If not null, receives the SVD rank and stage timings (see SolveResult)
+ */
+Eigen::Vector3d linearLeastSquaresI_YueWang(
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    SolveResult* diagnostics = nullptr
+);
+
 /**
  * @brief LLS-II-2 method from "Linear least squares localization in sensor networks" by Yue Wang. (2015)
  * @param anchorPositions 
@@ -85,6 +245,16 @@ Eigen::Vector3d linearLeastSquaresII_2_YueWang(
     const std::vector<double>& ranges
 );
 
+/**
+ * @brief linearLeastSquaresII_2_YueWang over caller-owned anchor and range memory
+ * @param diagnostics If not null, receives the SVD rank and stage timings (see SolveResult)
+ */
+Eigen::Vector3d linearLeastSquaresII_2_YueWang(
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    SolveResult* diagnostics = nullptr
+);
+
 /**
  * @brief TS-WLLS-I method from "Linear least squares localization in sensor networks" by Yue Wang (2015),
  * originally developed and proposed in "A Simple and Efficient Estimatorfor Hyperbolic Location" by Y. T. Chan and K. C. Ho (1994)
@@ -99,6 +269,55 @@ Eigen::Vector3d twoStepWeightedLinearLeastSquaresI_YueWang(
     const std::vector<double>& rangeStdDevs
 );
 
+/**
+ * @brief twoStepWeightedLinearLeastSquaresI_YueWang over caller-owned anchor, range and standard-deviation memory
+ * @param diagnostics If not null, receives the SVD rank and stage timings (see SolveResult)
+ */
+Eigen::Vector3d twoStepWeightedLinearLeastSquaresI_YueWang(
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    const RangesView& rangeStdDevs,
+    SolveResult* diagnostics = nullptr
+);
+
+/**
+ * @brief Unweighted least-squares cost 0.5 * sum_i (|x - p_i| - d_i)^2 of a position estimate
+ * @param anchorPositions 
+ * @param ranges 
+ * @param position Estimate x to evaluate
+ * @return double Cost reported as SolveResult::finalCost
+ */
+double rangeResidualCost(
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    const Eigen::Vector3d& position
+);
+
+/**
+ * @brief Allocation-free variant of twoStepWeightedLinearLeastSquaresI_YueWang
+ * Accumulates the 4x4 weighted normal equations in a single pass over the anchors and solves the first step
+ * with a fixed-size LDLT. The second step uses phi^-1 = K^-1 * S * K^-1 directly, so no explicit inverse is formed.
+ * Matches twoStepWeightedLinearLeastSquaresI_YueWang up to rounding for non-coplanar anchors.
+ * @param anchorPositions Position of anchors (Note: solver fails, if anchors are coplanar)
+ * @param ranges
+ * @param rangeStdDevs Standard deviations of the range measurements (NOTE: rangeStdDevs.size() == ranges.size()
+ * @return Eigen::Vector3d Estimated position
+ */
+Eigen::Vector3d twoStepWeightedLinearLeastSquaresI_YueWangFast(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const std::vector<double>& ranges,
+    const std::vector<double>& rangeStdDevs
+);
+
+/**
+ * @brief twoStepWeightedLinearLeastSquaresI_YueWangFast over caller-owned anchor, range and standard-deviation memory
+ */
+Eigen::Vector3d twoStepWeightedLinearLeastSquaresI_YueWangFast(
+    const AnchorPositionsView& anchorPositions,
+    const RangesView& ranges,
+    const RangesView& rangeStdDevs
+);
+
 /**
  * @brief Computes the Cramer-Rao lower bound for 3D true-range multilateration.
  *
@@ -137,6 +356,26 @@ CrlbResult calculateRangePositionCrlb(
     double anchorPositionStdDev
 );
 
+/**
+ * @brief Computes the local CRLB with independent, possibly anisotropic, per-anchor position uncertainty.
+ *
+ * Equivalent to the full-covariance overload with the blocks on the diagonal and zero
+ * cross-anchor blocks, but runs in O(N) time without forming any 3N-sized matrix.
+ * Each block is validated with the same tolerance as the full covariance.
+ *
+ * @param anchorPositions Nominal/mean 3D anchor positions, in metres
+ * @param evaluationPosition 3D position where the bound is evaluated, in metres
+ * @param rangeStdDev Shared standard deviation of independent Gaussian range noise, in metres
+ * @param anchorCovarianceBlocks One symmetric PSD 3x3 covariance per anchor, in square metres
+ * @return CrlbResult containing the Fisher information matrix, CRLB, rank, and any warning
+ */
+CrlbResult calculateRangePositionCrlb(
+    const std::vector<Eigen::Vector3d>& anchorPositions,
+    const Eigen::Vector3d& evaluationPosition,
+    double rangeStdDev,
+    const std::vector<Eigen::Matrix3d>& anchorCovarianceBlocks
+);
+
 /**
  * @brief Computes the local CRLB with a general anchor-position covariance.
  *
@@ -146,7 +385,8 @@ CrlbResult calculateRangePositionCrlb(
  * Off-diagonal blocks may describe correlations between different anchors.
  * The implementation uses the first-order effective range covariance
  * S = sigma_r^2 I + B C_a B^T and J = U^T S^-1 U without explicitly forming
- * S^-1. See docs/crlb.md for the derivation and limitations.
+ * S^-1. A covariance without cross-anchor blocks takes the O(N) diagonal-S
+ * path after validation. See docs/crlb.md for the derivation and limitations.
  *
  * @param anchorPositions Nominal/mean 3D anchor positions, in metres
  * @param evaluationPosition 3D position where the bound is evaluated, in metres
@@ -161,6 +401,25 @@ CrlbResult calculateRangePositionCrlb(
     const Eigen::MatrixXd& anchorPositionCovariance
 );
 
+/**
+ * @brief Validates a stacked 3N x 3N anchor-position covariance the way calculateRangePositionCrlb does.
+ *
+ * Checks dimensions and finiteness, rejects material asymmetry or negative eigenvalues
+ * (tolerance 1e-10 * max(1, max |C_a|)), symmetrizes the matrix and projects roundoff-sized
+ * negative eigenvalues to zero. Callers that evaluate many positions with one covariance
+ * can validate it once with this function.
+ *
+ * @param anchorPositionCovariance Full 3N x 3N anchor-position covariance, in square metres
+ * @param anchorCount Number of anchors N
+ * @param validatedCovariance Receives the symmetrized, PSD-projected covariance on success
+ * @return std::string Empty on success, otherwise the reason the covariance was rejected
+ */
+std::string validateAnchorPositionCovariance(
+    const Eigen::MatrixXd& anchorPositionCovariance,
+    size_t anchorCount,
+    Eigen::MatrixXd& validatedCovariance
+);
+
 } // namespace TrueRangeMultilateration
 
 
@@ -365,6 +365,8 @@ void WebApp::drawPanel() {
             "LLS-I (Yue Wang)",
             "LLS-II-2 (Yue Wang)",
             "Two-Step Weighted LLS-I (Yue Wang / Chan-Ho)",
+            "Nonlinear Least Squares (Analytic-Jacobian LM)",
+            "Robust Nonlinear Least Squares (Analytic LM + warm-started IRLS/Cauchy)",
         };
         if (ImGui::Combo("Algorithm", &selected, names, IM_ARRAYSIZE(names))) {
             params_.algorithm = static_cast<AlgorithmId>(selected);